@@ -0,0 +1,52 @@
+import argparse
+import json
+import sys
+
+# Metric -> True if higher is better
+metrics = {
+    "events_per_s": True,
+    "packets_per_s": True,
+    "wall_time_s": False,
+    "peak_rss_mb": False,
+    "scheduler_hwm": False,
+}
+
+
+def Build(results):
+    fast = [s.get("fast_fabric", False) for s in results["scenarios"].values()]
+    return "NS3_FAST_FABRIC" if any(fast) else "instrumented"
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Compare two commands/benchmark.py results and flag regressions.")
+    parser.add_argument("base", help="The baseline JSON result file.")
+    parser.add_argument("new", help="The JSON result file to check.")
+    parser.add_argument("-t", dest="threshold", action="store", type=float, default=0.05,
+                        help="The relative change flagged as a regression, by default 0.05.")
+    args = parser.parse_args()
+
+    with open(args.base) as f:
+        base = json.load(f)
+    with open(args.new) as f:
+        new = json.load(f)
+
+    print("Base " + base.get("commit", "?") + " (" + Build(base) + "), new "
+          + new.get("commit", "?") + " (" + Build(new) + ")")
+    regressions = 0
+    for name in sorted(new["scenarios"]):
+        if name not in base["scenarios"]:
+            print(name + ": not in the baseline")
+            continue
+        for metric, higherBetter in metrics.items():
+            old = base["scenarios"][name][metric]
+            cur = new["scenarios"][name][metric]
+            change = (cur - old) / old if old != 0 else 0.0
+            worse = -change if higherBetter else change
+            flag = ""
+            if worse > args.threshold:
+                flag = "  REGRESSION"
+                regressions += 1
+            print("%-28s %-14s %14.1f -> %14.1f (%+.1f%%)%s" % (name, metric, old, cur, 100 * change, flag))
+
+    print(str(regressions) + " regressions above " + str(100 * args.threshold) + "%")
+    sys.exit(1 if regressions > 0 else 0)
@@ -0,0 +1,86 @@
+import argparse
+import json
+import os
+import re
+import subprocess
+import tempfile
+
+# Fixed scenarios: name -> pfc arguments. Keep them unchanged across commits,
+# otherwise results are not comparable; add new scenarios under new names.
+FATTREE = "--fabric=fattree --cdf=WebSearch --flowTime=0.001 --time=0.005 "
+
+scenarios = {}
+for load in [0.3, 0.5, 0.7]:
+    scenarios["fattree320-load" + str(load)] = FATTREE + "--load=" + str(load) + " --cc=1 --pfc=1"
+
+scenarios["incast"] = (
+    "--fabric=fattree --cdf=WebSearch --load=0.1 --flowTime=0.001 --time=0.005 "
+    "--incastFanIn=128 --incastSize=16000 --incastPeriod=200 --cc=1 --pfc=1"
+)
+
+scenarios["scale4k"] = (
+    "--fabric=leafspine --leaves=128 --spines=16 --hostsPerSwitch=32 "
+    "--cdf=WebSearch --load=0.3 --flowTime=0.0002 --time=0.005 --cc=1 --pfc=1"
+)
+
+for pfc in [0, 1]:
+    for cc in range(6):
+        if pfc == 0 and cc == 0:
+            continue  # No loss recovery without PFC or CC
+        scenarios["fattree320-pfc" + str(pfc) + "-cc" + str(cc)] = FATTREE + "--load=0.5 --cc=" + str(cc) + " --pfc=" + str(pfc)
+
+
+def RunScenario(binary, args):
+    with tempfile.NamedTemporaryFile(suffix=".json") as bench:
+        args += " --checkRoute=false --bench=" + bench.name
+        if binary.endswith("ns3"):
+            cmd = binary + ' run --no-build "scratch/pfc ' + args + '"'
+        else:
+            cmd = binary + " " + args
+        subprocess.run(cmd, shell=True, check=True, stdout=subprocess.DEVNULL)
+        with open(bench.name) as f:
+            return json.load(f)
+
+
+def GitCommit():
+    try:
+        return subprocess.check_output(["git", "rev-parse", "--short", "HEAD"], text=True,
+                                       cwd=os.path.dirname(os.path.abspath(__file__)), stderr=subprocess.DEVNULL).strip()
+    except (subprocess.CalledProcessError, OSError):
+        return "unknown"
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Run the fixed simulator throughput scenarios from the ns-3 directory.")
+    parser.add_argument("-o", dest="output", action="store", default="benchmark.json", help="The JSON result file.")
+    parser.add_argument("-x", dest="binary", action="store", default="./ns3", help="The ns3 script or a pfc binary.")
+    parser.add_argument("-s", dest="select", action="store", default="", help="Only run scenarios matching this regex.")
+    parser.add_argument("-r", dest="repeat", action="store", type=int, default=1, help="Runs per scenario; the fastest run is kept.")
+    parser.add_argument("-a", dest="extra", action="store", default="",
+                        help="Arguments added to every scenario, e.g. --SchedulerType=ns3::LadderScheduler.")
+    parser.add_argument("-l", dest="list", action="store_true", help="List the scenarios.")
+    args = parser.parse_args()
+
+    if args.list:
+        for name, cmd in scenarios.items():
+            print(name + ": " + cmd)
+        exit(0)
+
+    os.makedirs("logs", exist_ok=True)
+    results = {"commit": GitCommit(), "scenarios": {}}
+    for name, cmd in scenarios.items():
+        if not re.search(args.select, name):
+            continue
+        best = None
+        for _ in range(args.repeat):
+            result = RunScenario(args.binary, cmd + " " + args.extra)
+            if best is None or result["wall_time_s"] < best["wall_time_s"]:
+                best = result
+        results["scenarios"][name] = best
+        print(name + ": " + str(best["wall_time_s"]) + "s, "
+              + str(int(best["events_per_s"])) + " events/s, "
+              + str(int(best["packets_per_s"])) + " packets/s, "
+              + str(best["peak_rss_mb"]) + "MB")
+
+    with open(args.output, "w") as f:
+        json.dump(results, f, indent=2)
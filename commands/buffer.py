@@ -0,0 +1,47 @@
+import argparse
+
+import numpy as np
+
+# BufferSampler::Record in src/point-to-point/model/buffer-sampler.h
+RECORD = np.dtype(
+    [
+        ("time", "<u8"),
+        ("node", "<u4"),
+        ("port", "<u2"),
+        ("trigger", "<u2"),
+        ("egress", "<i4"),
+        ("ingress", "<i4"),
+        ("headroom", "<i4"),
+        ("shared", "<i4"),
+    ]
+)
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="")
+    parser.add_argument("-f", dest="file", action="store", help="Specify the buffer file written by pfc --bufferInterval or --bufferDecimation.")
+    parser.add_argument("-n", dest="node", action="store", type=int, help="Only the samples of this switch ID.")
+    parser.add_argument("-t", dest="trigger", action="store", type=int, help="Only periodic (0) or on-change (1) samples.")
+    parser.add_argument("-c", dest="cdf", action="store", help="Write the CDF of each field as CSV (bytes, fraction) to <cdf>_<field>.csv.")
+    args = parser.parse_args()
+
+    samples = np.fromfile(args.file, dtype=RECORD)
+    if args.node is not None:
+        samples = samples[samples["node"] == args.node]
+    if args.trigger is not None:
+        samples = samples[samples["trigger"] == args.trigger]
+
+    print("Samples: " + str(len(samples)))
+    if len(samples) == 0:
+        exit()
+    print("Switches: " + str(len(np.unique(samples["node"]))))
+    print("Time: " + str(samples["time"].min()) + " - " + str(samples["time"].max()) + " ns")
+
+    percentiles = [50, 90, 99, 99.9, 100]
+    print("Field " + " ".join(str(p) + "%" for p in percentiles))
+    for field in ["egress", "ingress", "headroom", "shared"]:
+        values = np.sort(samples[field])
+        print(field + " " + " ".join(str(int(np.percentile(values, p))) for p in percentiles))
+        if args.cdf:
+            fraction = np.arange(1, len(values) + 1) / len(values)
+            last = np.append(values[1:] != values[:-1], True)
+            np.savetxt(args.cdf + "_" + field + ".csv", np.column_stack((values[last], fraction[last])), delimiter=",", fmt=["%d", "%.6f"])
@@ -7,6 +7,7 @@ import pandas as pd
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description="")
     parser.add_argument("-f", dest="file", action="store", help="Specify the fct file.")
+    parser.add_argument("-b", dest="base", action="store", help="Compare each flow with the fct file of a baseline run, e.g. without packet trains.")
     args = parser.parse_args()
 
     names = []
@@ -33,4 +34,24 @@ if __name__ == "__main__":
         print("FCT 99%: " + str(tmpdf.iloc[int(0.99 * size)]))
         print("FCT 99.9%: " + str(tmpdf.iloc[int(0.999 * size)]))
 
+        if df.shape[1] > 9:
+            slowdown = (df[6] / df[9]).sort_values()
+            print("Slowdown mean: " + str(slowdown.mean()))
+            print("Slowdown 99%: " + str(slowdown.iloc[int(0.99 * size)]))
+
+    if dfs.shape[1] > 8:
+        print("Timeouts: " + str(dfs[7].sum()))
+        print("Spurious timeouts: " + str(dfs[8].sum()))
+
+    if args.base:
+        base = pd.read_csv(args.base, header=None)
+        merged = dfs.merge(base, on=0, suffixes=("", "_base"))
+        error = ((merged[6] - merged["6_base"]).abs() / merged["6_base"]).sort_values()
+        size = len(error)
+        print("Matched flows: " + str(size) + " of " + str(len(dfs)))
+        if size > 0:
+            print("FCT error mean: " + str(error.mean()))
+            print("FCT error 99%: " + str(error.iloc[int(0.99 * size)]))
+            print("FCT error max: " + str(error.iloc[-1]))
+
     print("Finish FCT")
\ No newline at end of file
@@ -49,6 +49,7 @@ cp -r "$WORKER_DIR/scratch/" "$NS_DIR/"
 # Build ns-3.46
 cd "$NS_DIR/"
 mkdir -p logs
+# Append "-- -DNS3_FAST_FABRIC=ON" to compile out per-packet logging and tracing
 ./ns3 configure --build-profile=optimized --out=build/optimized
 ./ns3 build
 # Kill any running ns3.46-header-compress processes
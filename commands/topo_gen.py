@@ -0,0 +1,72 @@
+import os
+from optparse import OptionParser
+
+# Writes a fabric topology file (see FabricTopologyReader) to ../topology/
+#   host   <name>
+#   switch <name> <level>
+#   link   <from> <to> <rate> <delay>
+
+def fat_tree(out, k, nblock, ratio, host_rate, fabric_rate, delay):
+	nhost_per_rack = k * ratio
+	ntor = k * nblock
+	for i in range(ntor * nhost_per_rack):
+		out.write("host h%d\n"%i)
+	for i in range(ntor):
+		out.write("switch t%d 1\n"%i)
+	for i in range(k * nblock):
+		out.write("switch a%d 2\n"%i)
+	for i in range(k * k):
+		out.write("switch c%d 3\n"%i)
+	for i in range(ntor * nhost_per_rack):
+		out.write("link h%d t%d %s %s\n"%(i, i // nhost_per_rack, host_rate, delay))
+	for b in range(nblock):
+		for j in range(k):
+			for m in range(k):
+				out.write("link t%d a%d %s %s\n"%(b * k + j, b * k + m, fabric_rate, delay))
+	for b in range(nblock):
+		for j in range(k):
+			for m in range(k):
+				out.write("link a%d c%d %s %s\n"%(b * k + j, j * k + m, fabric_rate, delay))
+
+def leaf_spine(out, nleaf, nspine, nhost_per_leaf, host_rate, fabric_rate, delay):
+	for i in range(nleaf * nhost_per_leaf):
+		out.write("host h%d\n"%i)
+	for i in range(nleaf):
+		out.write("switch l%d 1\n"%i)
+	for i in range(nspine):
+		out.write("switch s%d 2\n"%i)
+	for i in range(nleaf * nhost_per_leaf):
+		out.write("link h%d l%d %s %s\n"%(i, i // nhost_per_leaf, host_rate, delay))
+	for i in range(nleaf):
+		for j in range(nspine):
+			out.write("link l%d s%d %s %s\n"%(i, j, fabric_rate, delay))
+
+if __name__ == "__main__":
+	parser = OptionParser()
+	parser.add_option("-t", "--type", dest = "type", help = "fattree or leafspine, by default fattree", default = "fattree")
+	parser.add_option("-k", "--k", dest = "k", help = "fat-tree: switches per pod tier, by default 4", default = "4")
+	parser.add_option("-p", "--pods", dest = "pods", help = "fat-tree: number of pods, by default 5", default = "5")
+	parser.add_option("-r", "--ratio", dest = "ratio", help = "fat-tree: hosts per ToR uplink, by default 4", default = "4")
+	parser.add_option("-l", "--leaf", dest = "leaf", help = "leaf-spine: number of leaves, by default 250", default = "250")
+	parser.add_option("-s", "--spine", dest = "spine", help = "leaf-spine: number of spines, by default 16", default = "16")
+	parser.add_option("-n", "--nhost", dest = "nhost", help = "leaf-spine: hosts per leaf, by default 40", default = "40")
+	parser.add_option("-b", "--bandwidth", dest = "bandwidth", help = "the rate of host links, by default 100Gbps", default = "100Gbps")
+	parser.add_option("-f", "--fabric", dest = "fabric", help = "the rate of switch links, by default 400Gbps", default = "400Gbps")
+	parser.add_option("-d", "--delay", dest = "delay", help = "the delay of every link, by default 1us", default = "1us")
+	options,args = parser.parse_args()
+
+	if not os.path.exists("../topology/"):
+		os.makedirs("../topology/")
+
+	if options.type == "fattree":
+		output = "../topology/FatTree_%s_%s_%s.txt"%(options.k, options.pods, options.ratio)
+		with open(output, "w") as out:
+			fat_tree(out, int(options.k), int(options.pods), int(options.ratio),
+				options.bandwidth, options.fabric, options.delay)
+	elif options.type == "leafspine":
+		output = "../topology/LeafSpine_%s_%s_%s.txt"%(options.leaf, options.spine, options.nhost)
+		with open(output, "w") as out:
+			leaf_spine(out, int(options.leaf), int(options.spine), int(options.nhost),
+				options.bandwidth, options.fabric, options.delay)
+	else:
+		print("unknown topology type " + options.type)
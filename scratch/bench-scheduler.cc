@@ -0,0 +1,89 @@
+#include "sched-trace.h"
+
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("BenchScheduler");
+
+/**
+ * Replay a scheduler trace recorded by pfc --schedTrace against each
+ * scheduler, checking that every one returns the events in the recorded
+ * order, and report the time per operation.
+ */
+int
+main(int argc, char* argv[])
+{
+	std::string traceFile;
+	std::string schedulers = "ns3::MapScheduler,ns3::HeapScheduler,ns3::PriorityQueueScheduler,ns3::CalendarScheduler,ns3::LadderScheduler";
+	uint32_t repeat = 3;
+
+	CommandLine cmd;
+	cmd.AddValue("trace", "the scheduler trace written by pfc --schedTrace", traceFile);
+	cmd.AddValue("schedulers", "the comma-separated schedulers to replay the trace on", schedulers);
+	cmd.AddValue("repeat", "the replays per scheduler; the fastest is reported, by default 3", repeat);
+	cmd.Parse(argc, argv);
+
+	FILE* file = fopen(traceFile.c_str(), "rb");
+	NS_ABORT_MSG_IF(file == nullptr, "Cannot open scheduler trace " << traceFile);
+	std::vector<uint64_t> trace;
+	uint64_t record[2];
+	while(fread(record, sizeof(record), 1, file) == 1){
+		trace.push_back(record[0]);
+		trace.push_back(record[1]);
+	}
+	fclose(file);
+
+	uint64_t inserts = 0;
+	uint64_t maxSize = 0;
+	uint64_t size = 0;
+	for(uint64_t i = 0;i < trace.size();i += 2){
+		if((trace[i + 1] & 3) == SCHED_INSERT){
+			inserts += 1;
+			maxSize = std::max(maxSize, ++size);
+		}
+		else
+			size -= 1;
+	}
+	uint64_t ops = trace.size() / 2;
+	std::cout << "Trace " << traceFile << ": " << ops << " operations, " << inserts
+		<< " inserts, at most " << maxSize << " pending events" << std::endl;
+
+	std::istringstream list(schedulers);
+	std::string name;
+	while(std::getline(list, name, ',')){
+		double best = -1;
+		for(uint32_t run = 0;run < repeat;++run){
+			ObjectFactory factory(name);
+			Ptr<Scheduler> scheduler = factory.Create<Scheduler>();
+			uint64_t mismatches = 0;
+
+			auto start = std::chrono::steady_clock::now();
+			for(uint64_t i = 0;i < trace.size();i += 2){
+				Scheduler::Event ev;
+				ev.impl = nullptr;
+				ev.key.m_ts = trace[i];
+				ev.key.m_uid = trace[i + 1] >> 2;
+				ev.key.m_context = 0;
+				switch(trace[i + 1] & 3){
+				case SCHED_INSERT:
+					scheduler->Insert(ev);
+					break;
+				case SCHED_REMOVE_NEXT:
+					mismatches += scheduler->RemoveNext().key.m_uid != ev.key.m_uid;
+					break;
+				default:
+					scheduler->Remove(ev);
+				}
+			}
+			std::chrono::duration<double> diff = std::chrono::steady_clock::now() - start;
+
+			NS_ABORT_MSG_IF(mismatches > 0, name << " returned " << mismatches << " events out of the recorded order");
+			if(best < 0 || diff.count() < best)
+				best = diff.count();
+		}
+		std::cout << name << ": " << best << "s, " << best * 1e9 / ops << "ns per operation" << std::endl;
+	}
+}
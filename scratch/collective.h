@@ -0,0 +1,211 @@
+#ifndef COLLECTIVE_H
+#define COLLECTIVE_H
+
+#include "flow-schedule.h"
+
+using namespace ns3;
+
+/**
+ * Collective operations as dependency DAGs of flows. A flow starts once all
+ * the flows it depends on are acknowledged (FlowComplete trace of the NICs);
+ * a collective completes with its last flow and may then be repeated after a
+ * compute gap to model training iterations. Completion times go to <log>.coll
+ * as id,type,iteration,ranks,size,start,end,time.
+ */
+struct CollectiveFlow
+{
+	uint32_t src;
+	uint32_t dst;
+	uint32_t size;
+	uint32_t deps = 0;              // number of flows this one waits for
+	uint32_t pending = 0;           // of which not yet complete
+	std::vector<uint32_t> next;     // flows waiting for this one
+};
+
+struct Collective
+{
+	uint32_t id;
+	std::string type;
+	std::vector<uint32_t> ranks;    // rank -> host id
+	uint32_t size;
+	std::vector<CollectiveFlow> flows;
+	uint32_t remaining = 0;
+	uint64_t startNs = 0;
+	uint32_t iteration = 0;
+	uint32_t iterations = 1;
+	uint64_t gapNs = 0;
+};
+
+std::vector<Collective> collectives;
+std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> collectiveFlows; // flow id -> (collective, flow)
+FILE* collFilePtr = nullptr;
+
+uint32_t AddCollectiveFlow(Collective& coll, uint32_t src, uint32_t dst, uint32_t size, std::vector<uint32_t> deps){
+	uint32_t index = coll.flows.size();
+	CollectiveFlow flow;
+	flow.src = coll.ranks[src];
+	flow.dst = coll.ranks[dst];
+	flow.size = std::max(1u, size);
+	flow.deps = deps.size();
+	coll.flows.push_back(flow);
+	for(uint32_t dep : deps)
+		coll.flows[dep].next.push_back(index);
+	return index;
+}
+
+// Ring of n - 1 (ReduceScatter, AllGather) or 2 (n - 1) (AllReduce) steps of size / n;
+// at each step a rank forwards the chunk it received at the previous step
+void BuildRing(Collective& coll, uint32_t steps){
+	uint32_t n = coll.ranks.size();
+	uint32_t chunk = (coll.size + n - 1) / n;
+	std::vector<uint32_t> last(n);
+	for(uint32_t step = 0;step < steps;++step){
+		std::vector<uint32_t> current(n);
+		for(uint32_t rank = 0;rank < n;++rank){
+			std::vector<uint32_t> deps;
+			if(step > 0)
+				deps.push_back(last[(rank + n - 1) % n]);
+			current[rank] = AddCollectiveFlow(coll, rank, (rank + 1) % n, chunk, deps);
+		}
+		last = current;
+	}
+}
+
+// Binary tree: reduce to rank 0, then broadcast back down
+void BuildTree(Collective& coll){
+	uint32_t n = coll.ranks.size();
+	std::vector<uint32_t> up(n), down(n);
+	for(uint32_t rank = n - 1;rank > 0;--rank){
+		std::vector<uint32_t> deps;
+		for(uint32_t child = 2 * rank + 1;child <= 2 * rank + 2 && child < n;++child)
+			deps.push_back(up[child]);
+		up[rank] = AddCollectiveFlow(coll, rank, (rank - 1) / 2, coll.size, deps);
+	}
+	for(uint32_t rank = 1;rank < n;++rank){
+		uint32_t parent = (rank - 1) / 2;
+		std::vector<uint32_t> deps;
+		if(parent == 0){
+			for(uint32_t child = 1;child <= 2 && child < n;++child)
+				deps.push_back(up[child]);
+		}
+		else{
+			deps.push_back(down[parent]);
+		}
+		down[rank] = AddCollectiveFlow(coll, parent, rank, coll.size, deps);
+	}
+}
+
+void BuildAllToAll(Collective& coll){
+	uint32_t n = coll.ranks.size();
+	for(uint32_t src = 0;src < n;++src){
+		for(uint32_t dst = 0;dst < n;++dst){
+			if(src != dst)
+				AddCollectiveFlow(coll, src, dst, coll.size / n, {});
+		}
+	}
+}
+
+void StartCollectiveFlow(uint32_t collId, uint32_t index){
+	CollectiveFlow& cf = collectives[collId].flows[index];
+	FlowInfo flow;
+	flow.id = NextFlowId();
+	flow.src = cf.src;
+	flow.dst = cf.dst;
+	flow.size = cf.size;
+	flow.startTime = Simulator::Now().GetNanoSeconds();
+	flow.tenant = collId + 1; // Persistent QPs are per job
+	collectiveFlows[flow.id] = {collId, index};
+	StartFlow(flow);
+}
+
+void StartCollective(uint32_t collId){
+	Collective& coll = collectives[collId];
+	coll.startNs = Simulator::Now().GetNanoSeconds();
+	coll.remaining = coll.flows.size();
+	for(auto& flow : coll.flows)
+		flow.pending = flow.deps;
+	for(uint32_t index = 0;index < coll.flows.size();++index){
+		if(coll.flows[index].deps == 0)
+			StartCollectiveFlow(collId, index);
+	}
+}
+
+void CollectiveFlowComplete(const FlowInfo& flow){
+	auto it = collectiveFlows.find(flow.id);
+	if(it == collectiveFlows.end())
+		return; // Not a collective flow
+	uint32_t collId = it->second.first;
+	uint32_t index = it->second.second;
+	collectiveFlows.erase(it);
+
+	Collective& coll = collectives[collId];
+	for(uint32_t next : coll.flows[index].next){
+		if(--coll.flows[next].pending == 0)
+			StartCollectiveFlow(collId, next);
+	}
+
+	if(--coll.remaining == 0){
+		uint64_t now = Simulator::Now().GetNanoSeconds();
+		fprintf(collFilePtr, "%u,%s,%u,%lu,%u,%lu,%lu,%lu\n",
+			coll.id, coll.type.c_str(), coll.iteration, coll.ranks.size(),
+			coll.size, coll.startNs, now, now - coll.startNs);
+		fflush(collFilePtr);
+		if(++coll.iteration < coll.iterations)
+			Simulator::Schedule(NanoSeconds(coll.gapNs), &StartCollective, collId);
+	}
+}
+
+/**
+ * Run a collective of the given type in numJobs independent jobs of numRanks
+ * hosts each (0: split all hosts). Ranks of different jobs are interleaved,
+ * so every job spreads over the fabric.
+ */
+void ScheduleCollective(
+	std::string type,
+	uint32_t size,
+	uint32_t numJobs,
+	uint32_t numRanks,
+	uint32_t iterations,
+	double gapUs,
+	double startTime){
+
+	uint32_t numHosts = nics.size();
+	if(numRanks == 0)
+		numRanks = numHosts / numJobs;
+	NS_ABORT_MSG_IF(numRanks < 2 || numRanks * numJobs > numHosts,
+		"Cannot place " << numJobs << " jobs of " << numRanks << " ranks on " << numHosts << " hosts");
+	uint32_t stride = numHosts / (numRanks * numJobs);
+
+	OpenFctLog();
+	collFilePtr = fopen((logFile + ".coll").c_str(), "w");
+	for(auto& nic : nics)
+		nic->TraceConnectWithoutContext("FlowComplete", MakeCallback(&CollectiveFlowComplete));
+
+	for(uint32_t job = 0;job < numJobs;++job){
+		Collective coll;
+		coll.id = collectives.size();
+		coll.type = type;
+		coll.size = size;
+		coll.iterations = iterations;
+		coll.gapNs = gapUs * 1000;
+		for(uint32_t rank = 0;rank < numRanks;++rank)
+			coll.ranks.push_back((rank * numJobs + job) * stride);
+
+		uint32_t n = numRanks;
+		if(type == "allreduce")
+			BuildRing(coll, 2 * (n - 1));
+		else if(type == "reducescatter" || type == "allgather")
+			BuildRing(coll, n - 1);
+		else if(type == "treeallreduce")
+			BuildTree(coll);
+		else if(type == "alltoall")
+			BuildAllToAll(coll);
+		else
+			NS_ABORT_MSG("Unknown collective " << type);
+
+		collectives.push_back(coll);
+		Simulator::Schedule(Seconds(startTime), &StartCollective, coll.id);
+	}
+}
+
+#endif /* COLLECTIVE_H */
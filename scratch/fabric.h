@@ -0,0 +1,262 @@
+#ifndef FABRIC_H
+#define FABRIC_H
+
+#include "topology.h"
+
+using namespace ns3;
+
+// Generators for fabric families other than the fat-tree, routed by BuildEcmpRoute.
+// CreateSwitch also files their switches in tors, aggs and cores by level.
+
+PointToPointHelper MakeLink(std::string rate, std::string delay){
+	PointToPointHelper link;
+	link.SetDeviceAttribute("DataRate", StringValue(rate));
+	link.SetChannelAttribute("Delay", StringValue(delay));
+	return link;
+}
+
+void CreateServers(uint32_t numServer){
+	for(uint32_t i = 0;i < numServer;++i)
+		servers.push_back(CreateObject<Node>());
+}
+
+void ConnectServer(PointToPointHelper& link, uint32_t serverId, Ptr<SwitchNode> sw){
+	NetDeviceContainer ndc = InstallLink(link, servers[serverId], sw);
+	AddServerNic(serverId, ndc.Get(0));
+}
+
+// Two tiers: every leaf connects to every spine
+void BuildLeafSpine(
+	uint32_t numLeaf,
+	uint32_t numSpine,
+	uint32_t numServerperLeaf,
+	std::string hostRate,
+	std::string fabricRate,
+	std::string linkDelay){
+
+	CreateServers(numLeaf * numServerperLeaf);
+	std::vector<Ptr<SwitchNode>> leaves, spines;
+	for(uint32_t i = 0;i < numLeaf;++i)
+		leaves.push_back(CreateSwitch(1, i));
+	for(uint32_t i = 0;i < numSpine;++i)
+		spines.push_back(CreateSwitch(2, i));
+
+	InstallInternetStack();
+
+	PointToPointHelper linkServerSwitch = MakeLink(hostRate, linkDelay);
+	PointToPointHelper linkSwitchSwitch = MakeLink(fabricRate, linkDelay);
+	for(uint32_t serverId = 0;serverId < servers.size();++serverId)
+		ConnectServer(linkServerSwitch, serverId, leaves[serverId / numServerperLeaf]);
+	for(uint32_t i = 0;i < numLeaf;++i){
+		for(uint32_t j = 0;j < numSpine;++j)
+			InstallLink(linkSwitchSwitch, leaves[i], spines[j]);
+	}
+
+	BuildEcmpRoute();
+}
+
+/**
+ * Dragonfly: routers of a group are fully connected by local links, and each
+ * router has numGlobal global links. Every pair of groups gets at least one
+ * global link, spread round-robin over the routers of both groups, so
+ * numGroup should not exceed numRouter * numGlobal + 1. Routing is minimal.
+ */
+void BuildDragonfly(
+	uint32_t numGroup,
+	uint32_t numRouter,
+	uint32_t numServerperRouter,
+	uint32_t numGlobal,
+	std::string hostRate,
+	std::string fabricRate,
+	std::string linkDelay){
+
+	NS_ABORT_MSG_IF(numGroup > numRouter * numGlobal + 1, "Not enough global links for " << numGroup << " groups");
+
+	CreateServers(numGroup * numRouter * numServerperRouter);
+	std::vector<Ptr<SwitchNode>> routers;
+	for(uint32_t i = 0;i < numGroup * numRouter;++i)
+		routers.push_back(CreateSwitch(1, i));
+
+	InstallInternetStack();
+
+	PointToPointHelper linkServerSwitch = MakeLink(hostRate, linkDelay);
+	PointToPointHelper linkSwitchSwitch = MakeLink(fabricRate, linkDelay);
+	for(uint32_t serverId = 0;serverId < servers.size();++serverId)
+		ConnectServer(linkServerSwitch, serverId, routers[serverId / numServerperRouter]);
+
+	for(uint32_t group = 0;group < numGroup;++group){
+		for(uint32_t i = 0;i < numRouter;++i){
+			for(uint32_t j = i + 1;j < numRouter;++j)
+				InstallLink(linkSwitchSwitch, routers[group * numRouter + i], routers[group * numRouter + j]);
+		}
+	}
+
+	// Links per pair of groups, so that every global port is used
+	uint32_t linksPerPair = numGroup > 1 ? std::max(1u, numRouter * numGlobal / (numGroup - 1)) : 0;
+	std::vector<uint32_t> globalPort(numGroup, 0);
+	for(uint32_t x = 0;x < numGroup;++x){
+		for(uint32_t y = x + 1;y < numGroup;++y){
+			for(uint32_t l = 0;l < linksPerPair;++l){
+				uint32_t routerX = x * numRouter + (globalPort[x]++ / numGlobal) % numRouter;
+				uint32_t routerY = y * numRouter + (globalPort[y]++ / numGlobal) % numRouter;
+				InstallLink(linkSwitchSwitch, routers[routerX], routers[routerY]);
+			}
+		}
+	}
+
+	BuildEcmpRoute();
+}
+
+/**
+ * Multi-plane Clos: every ToR has one uplink per plane. Each plane is an
+ * independent aggregation/spine network with one aggregation switch per pod,
+ * connected to all spines of the same plane.
+ */
+void BuildMultiPlaneClos(
+	uint32_t numPlane,
+	uint32_t numPod,
+	uint32_t numTorperPod,
+	uint32_t numServerperTor,
+	uint32_t numSpineperPlane,
+	std::string hostRate,
+	std::string fabricRate,
+	std::string linkDelay){
+
+	uint32_t numTor = numPod * numTorperPod;
+	CreateServers(numTor * numServerperTor);
+	std::vector<Ptr<SwitchNode>> torSwitches, aggSwitches, spines;
+	for(uint32_t i = 0;i < numTor;++i)
+		torSwitches.push_back(CreateSwitch(1, i));
+	for(uint32_t i = 0;i < numPlane * numPod;++i)
+		aggSwitches.push_back(CreateSwitch(2, i)); // plane-major
+	for(uint32_t i = 0;i < numPlane * numSpineperPlane;++i)
+		spines.push_back(CreateSwitch(3, i));    // plane-major
+
+	InstallInternetStack();
+
+	PointToPointHelper linkServerSwitch = MakeLink(hostRate, linkDelay);
+	PointToPointHelper linkSwitchSwitch = MakeLink(fabricRate, linkDelay);
+	for(uint32_t serverId = 0;serverId < servers.size();++serverId)
+		ConnectServer(linkServerSwitch, serverId, torSwitches[serverId / numServerperTor]);
+
+	for(uint32_t plane = 0;plane < numPlane;++plane){
+		for(uint32_t torId = 0;torId < numTor;++torId)
+			InstallLink(linkSwitchSwitch, torSwitches[torId], aggSwitches[plane * numPod + torId / numTorperPod]);
+		for(uint32_t pod = 0;pod < numPod;++pod){
+			for(uint32_t j = 0;j < numSpineperPlane;++j)
+				InstallLink(linkSwitchSwitch, aggSwitches[plane * numPod + pod], spines[plane * numSpineperPlane + j]);
+		}
+	}
+
+	BuildEcmpRoute();
+}
+
+/**
+ * Rail-optimized: a server has numRail GPUs, each with its own NIC (one host
+ * each, numbered server-major). Within a scalable unit, GPU r of every server
+ * connects to rail switch r, and every rail switch connects to every spine.
+ * Cross-rail traffic goes through the spines.
+ */
+void BuildRailOptimized(
+	uint32_t numUnit,
+	uint32_t numServerperUnit,
+	uint32_t numRail,
+	uint32_t numSpine,
+	std::string hostRate,
+	std::string fabricRate,
+	std::string linkDelay){
+
+	CreateServers(numUnit * numServerperUnit * numRail);
+	std::vector<Ptr<SwitchNode>> rails, spines;
+	for(uint32_t i = 0;i < numUnit * numRail;++i)
+		rails.push_back(CreateSwitch(1, i));
+	for(uint32_t i = 0;i < numSpine;++i)
+		spines.push_back(CreateSwitch(2, i));
+
+	InstallInternetStack();
+
+	PointToPointHelper linkServerSwitch = MakeLink(hostRate, linkDelay);
+	PointToPointHelper linkSwitchSwitch = MakeLink(fabricRate, linkDelay);
+	for(uint32_t serverId = 0;serverId < servers.size();++serverId){
+		uint32_t unit = serverId / numRail / numServerperUnit;
+		ConnectServer(linkServerSwitch, serverId, rails[unit * numRail + serverId % numRail]);
+	}
+	for(uint32_t i = 0;i < rails.size();++i){
+		for(uint32_t j = 0;j < numSpine;++j)
+			InstallLink(linkSwitchSwitch, rails[i], spines[j]);
+	}
+
+	BuildEcmpRoute();
+}
+
+/**
+ * Check the routing tables: from every switch, every ECMP path towards every
+ * host must end at the host without loops or missing routes. Hosts are checked
+ * in parallel; each walk memoizes the switches already known to be good.
+ * Returns the number of (switch, host) pairs that are not routed correctly.
+ */
+uint64_t CheckReachability(){
+	uint32_t numSwitches = switches.size();
+	std::vector<uint32_t> serverPort;
+	std::vector<std::vector<PortPeer>> ports = GetSwitchPorts(serverPort);
+
+	std::vector<const SwitchNode*> raw(numSwitches);
+	for(uint32_t i = 0;i < numSwitches;++i)
+		raw[i] = PeekPointer(switches[i]);
+
+	enum State : uint8_t { UNKNOWN, VISITING, GOOD, BAD };
+	std::vector<uint64_t> failures(nics.size(), 0);
+
+	ParallelFor(nics.size(), [&](uint32_t dst){
+		std::vector<uint8_t> state(numSwitches, UNKNOWN);
+		// Iterative DFS: (switch, next route entry)
+		std::vector<std::pair<uint32_t, uint32_t>> stack;
+		for(uint32_t start = 0;start < numSwitches;++start){
+			if(state[start] != UNKNOWN)
+				continue;
+			stack.emplace_back(start, 0);
+			state[start] = VISITING;
+			while(!stack.empty()){
+				uint32_t sw = stack.back().first;
+				const std::vector<uint32_t>& route = raw[sw]->GetHostRoute(dst);
+				if(route.empty())
+					state[sw] = BAD;
+				if(state[sw] == BAD || stack.back().second == route.size()){
+					if(state[sw] == VISITING)
+						state[sw] = GOOD;
+					uint8_t result = state[sw];
+					stack.pop_back();
+					if(result == BAD && !stack.empty())
+						state[stack.back().first] = BAD;
+					continue;
+				}
+
+				uint32_t devId = route[stack.back().second++];
+				const PortPeer peer = devId < ports[sw].size() ? ports[sw][devId] : PortPeer();
+				if(peer.index == UINT32_MAX || (!peer.isSwitch && peer.index != dst))
+					state[sw] = BAD; // Black hole or wrong host
+				else if(peer.isSwitch){
+					if(state[peer.index] == VISITING || state[peer.index] == BAD)
+						state[sw] = BAD; // Loop or bad next hop
+					else if(state[peer.index] == UNKNOWN){
+						state[peer.index] = VISITING;
+						stack.emplace_back(peer.index, 0);
+					}
+				}
+			}
+		}
+		for(uint32_t sw = 0;sw < numSwitches;++sw)
+			failures[dst] += (state[sw] == BAD);
+	});
+
+	uint64_t total = 0;
+	for(uint32_t dst = 0;dst < nics.size();++dst){
+		if(failures[dst] > 0 && total == 0)
+			std::cerr << "Host " << dst << " is unreachable from " << failures[dst] << " switches" << std::endl;
+		total += failures[dst];
+	}
+	std::cout << "Reachability: " << total << " unrouted (switch, host) pairs" << std::endl;
+	return total;
+}
+
+#endif /* FABRIC_H */
@@ -4,38 +4,47 @@
 #include <stdio.h>
 
 #include "topology.h"
+#include "path-metric.h"
+#include "fluid.h"
 
 using namespace ns3;
 
 FILE* logFilePtr = nullptr;
 FILE* flowFilePtr = nullptr;
 
+// The next line of the trace; it gets its id when it starts
 FlowInfo currentFlow;
+uint32_t lastFlowId = 0;
+
+// Ids of the trace, workload, collective and incast flows, in the order they start
+uint32_t NextFlowId(){
+    return ++lastFlowId;
+}
 
 void ReadLine();
 
+void StartFlow(FlowInfo flow){
+    flow.minRttNs = GetMinRtt(flow.src, flow.dst);
+    flow.idealFctNs = GetIdealFct(flow.src, flow.dst, flow.size);
+
+    if(fluidThreshold > 0){
+        AddFluidFlow(flow, logFilePtr);
+        if(IsFluidFlow(flow))
+            return;
+    }
+
+    Ptr<PointToPointNetDevice> nic = nics[flow.src];
+    nic->SetFlow(flow, logFilePtr, ccVersion);
+}
+
 void SetFlow(){
-    // Set RTT for FatTree topology
-    if(currentFlow.src / 64 == currentFlow.dst / 64){
-		if(currentFlow.src / 16 == currentFlow.dst / 16){
-			currentFlow.minRttNs = 4000; // 4 us
-		}
-		else{
-			currentFlow.minRttNs = 8000; // 8 us
-		}
-	}
-	else{
-		currentFlow.minRttNs = 12000; // 12 us
-	}
-    
-    Ptr<PointToPointNetDevice> nic = nics[currentFlow.src];
-    nic->SetFlow(currentFlow, logFilePtr, ccVersion);
+    currentFlow.id = NextFlowId();
+    StartFlow(currentFlow);
     ReadLine();
 }
 
 void ReadLine(){
     if(fscanf(flowFilePtr, "%u %u %u %lu", &currentFlow.src, &currentFlow.dst, &currentFlow.size, &currentFlow.startTime) != EOF){
-        currentFlow.id += 1;
         if(Simulator::Now() != NanoSeconds(currentFlow.startTime)){
             Simulator::Schedule(NanoSeconds(currentFlow.startTime) - Simulator::Now(), &SetFlow);
         }
@@ -45,9 +54,54 @@ void ReadLine(){
     }
 }
 
+void OpenFctLog(){
+    if(logFilePtr == nullptr)
+        logFilePtr = fopen((logFile + ".fct").c_str(), "w");
+}
+
+// Completed flows by size class: small (< 100KB), medium (< 10MB) and large
+const uint32_t FCT_CLASSES = 3;
+const char* fctClassName[FCT_CLASSES] = {"small", "medium", "large"};
+std::vector<double> fctNs[FCT_CLASSES];
+std::vector<double> fctSlowdown[FCT_CLASSES];
+
+void RecordFct(const FlowInfo& flow){
+    uint32_t cls = flow.size < 100000 ? 0 : (flow.size < 10000000 ? 1 : 2);
+    double fct = Simulator::Now().GetNanoSeconds() - flow.startTime;
+    fctNs[cls].push_back(fct);
+    fctSlowdown[cls].push_back(std::max(1.0, fct / std::max<uint64_t>(1, flow.idealFctNs)));
+}
+
+void ConnectFctStats(){
+    for(auto& nic : nics)
+        nic->TraceConnectWithoutContext("FlowComplete", MakeCallback(&RecordFct));
+}
+
+void PrintFctStats(){
+    for(uint32_t cls = 0;cls < FCT_CLASSES;++cls){
+        uint32_t count = fctNs[cls].size();
+        if(count == 0)
+            continue;
+        double fctSum = 0, slowdownSum = 0;
+        for(uint32_t i = 0;i < count;++i){
+            fctSum += fctNs[cls][i];
+            slowdownSum += fctSlowdown[cls][i];
+        }
+        std::vector<double>& slowdown = fctSlowdown[cls];
+        std::nth_element(slowdown.begin(), slowdown.begin() + count * 99 / 100, slowdown.end());
+        std::cout << "FCT " << fctClassName[cls] << ": " << count << " flows, mean "
+            << fctSum / count / 1000 << "us, mean slowdown " << slowdownSum / count
+            << ", p99 slowdown " << slowdown[count * 99 / 100] << std::endl;
+    }
+}
+
 void ScheduleFlow(){
-    logFilePtr = fopen((logFile + ".fct").c_str(), "w");
+    OpenFctLog();
     flowFilePtr = fopen(("trace/" + flowFile + ".tr").c_str(), "r");
+    if(flowFilePtr == nullptr){
+        std::cout << "No flow file trace/" << flowFile << ".tr" << std::endl;
+        return;
+    }
 
     ReadLine();
 }
@@ -0,0 +1,245 @@
+#ifndef FLUID_H
+#define FLUID_H
+
+#include "topology.h"
+
+using namespace ns3;
+
+/**
+ * Fluid model for background flows: flows of at least fluidThreshold bytes
+ * do not send packets. They get max-min fair rates over fluidShare of the
+ * links of their ECMP path, recomputed whenever any flow starts or completes.
+ * Packet-level flows take part in the allocation with unlimited demand, so
+ * fluid flows leave them a fair share; one that meets no fluid flow leaves
+ * the rates as they are. The packet-level devices transmit at
+ * the capacity left by the fluid flows, and delay packets and mark them at
+ * the switches as if they had waited behind the background packets.
+ */
+struct FluidFlow
+{
+	FlowInfo flow;
+	std::vector<uint32_t> links;    // egress devices of the path
+	double remaining;               // bytes
+	double rate = 0;                // bps
+	bool foreground = false;        // packet-level flow, only takes its share
+};
+
+struct FluidLink
+{
+	Ptr<PointToPointNetDevice> dev;
+	double capacity;                // bps available to fluid flows
+	uint32_t fluidFlows = 0;        // fluid flows crossing it
+};
+
+const uint32_t FLUID_PACKET_SIZE = 4000;
+
+uint64_t fluidThreshold = 0;        // 0: no fluid flows
+double fluidShare = 0.9;
+
+std::vector<FluidLink> fluidLinks;
+std::unordered_map<Ptr<PointToPointNetDevice>, uint32_t> fluidLinkIndex;
+std::map<uint32_t, FluidFlow> fluidFlows; // flow id -> flow, ordered for reproducible allocation
+FILE* fluidLogPtr = nullptr;
+
+uint64_t fluidLastUpdate = 0;
+EventId fluidEvent;
+uint64_t fluidCompleted = 0;
+
+bool IsFluidFlow(const FlowInfo& flow){
+	return fluidThreshold > 0 && flow.size >= fluidThreshold;
+}
+
+uint32_t GetFluidLink(Ptr<PointToPointNetDevice> dev){
+	auto it = fluidLinkIndex.find(dev);
+	if(it != fluidLinkIndex.end())
+		return it->second;
+	FluidLink link;
+	link.dev = dev;
+	link.capacity = dev->GetDataRate().GetBitRate() * fluidShare;
+	fluidLinks.push_back(link);
+	return fluidLinkIndex[dev] = fluidLinks.size() - 1;
+}
+
+// Egress devices from the source NIC to the destination, one ECMP member per flow
+std::vector<uint32_t> GetFluidPath(const FlowInfo& flow){
+	std::vector<uint32_t> path;
+	Ptr<PointToPointNetDevice> dev = nics[flow.src];
+	for(uint32_t hop = 0;hop < 64;++hop){
+		path.push_back(GetFluidLink(dev));
+		Ptr<PointToPointNetDevice> peer = GetPeerDevice(dev);
+		NS_ABORT_MSG_IF(peer == nullptr, "Fluid flow " << flow.id << " reaches an unconnected port");
+		Ptr<SwitchNode> sw = DynamicCast<SwitchNode>(peer->GetNode());
+		if(sw == nullptr)
+			return path; // Reached a host
+
+		const std::vector<uint32_t>& route = sw->GetHostRoute(flow.dst);
+		NS_ABORT_MSG_IF(route.empty(), "No route for fluid flow " << flow.id);
+		dev = DynamicCast<PointToPointNetDevice>(sw->GetDevice(route[Hash32((const char*)&flow.id, sizeof(flow.id)) % route.size()]));
+	}
+	NS_ABORT_MSG("Routing loop for fluid flow " << flow.id);
+	return path;
+}
+
+// Progressive filling: saturate the most constrained link, freeze its flows, repeat
+void AllocateFluidRates(){
+	std::vector<double> capacity(fluidLinks.size());
+	std::vector<uint32_t> active(fluidLinks.size(), 0);
+	for(uint32_t i = 0;i < fluidLinks.size();++i)
+		capacity[i] = fluidLinks[i].capacity;
+
+	std::vector<FluidFlow*> unfrozen;
+	for(auto& it : fluidFlows){
+		unfrozen.push_back(&it.second);
+		for(uint32_t link : it.second.links)
+			active[link] += 1;
+	}
+
+	while(!unfrozen.empty()){
+		double share = -1;
+		for(uint32_t i = 0;i < fluidLinks.size();++i){
+			if(active[i] > 0 && (share < 0 || capacity[i] / active[i] < share))
+				share = capacity[i] / active[i];
+		}
+
+		std::vector<FluidFlow*> next;
+		for(FluidFlow* flow : unfrozen){
+			bool bottleneck = false;
+			for(uint32_t link : flow->links)
+				bottleneck |= capacity[link] / active[link] <= share * (1 + 1e-9);
+			if(!bottleneck){
+				next.push_back(flow);
+				continue;
+			}
+			flow->rate = std::max(0.0, share);
+			for(uint32_t link : flow->links){
+				capacity[link] -= flow->rate;
+				active[link] -= 1;
+			}
+		}
+		unfrozen.swap(next);
+	}
+
+	std::vector<double> load(fluidLinks.size(), 0);
+	for(auto& it : fluidFlows){
+		if(it.second.foreground)
+			continue;
+		for(uint32_t link : it.second.links)
+			load[link] += it.second.rate;
+	}
+	for(uint32_t i = 0;i < fluidLinks.size();++i){
+		// Mean M/D/1 queue of the background packets at its utilization
+		double rho = std::min(0.99, load[i] / fluidLinks[i].dev->GetDataRate().GetBitRate());
+		fluidLinks[i].dev->SetBackgroundRate(load[i]);
+		fluidLinks[i].dev->SetBackgroundQueue(FLUID_PACKET_SIZE * rho * rho / (2 * (1 - rho)));
+	}
+}
+
+// Whether a path crosses a link carrying a fluid flow
+bool MeetsFluid(const std::vector<uint32_t>& links){
+	for(uint32_t link : links){
+		if(fluidLinks[link].fluidFlows > 0)
+			return true;
+	}
+	return false;
+}
+
+void CountFluid(const FluidFlow& fluid, int32_t delta){
+	if(fluid.foreground)
+		return;
+	for(uint32_t link : fluid.links)
+		fluidLinks[link].fluidFlows += delta;
+}
+
+// Bring the fluid flows up to now and complete the finished ones
+void AdvanceFluid(){
+	uint64_t now = Simulator::Now().GetNanoSeconds();
+	double elapsed = (now - fluidLastUpdate) / 1e9;
+	fluidLastUpdate = now;
+
+	for(auto it = fluidFlows.begin();it != fluidFlows.end();){
+		FluidFlow& fluid = it->second;
+		if(!fluid.foreground)
+			fluid.remaining -= fluid.rate * elapsed / 8;
+		if(fluid.foreground || fluid.remaining > 0.5){
+			++it;
+			continue;
+		}
+
+		FlowInfo& flow = fluid.flow;
+		flow.endTime = now;
+		if(fluidLogPtr != nullptr){
+			fprintf(fluidLogPtr, "%u,%u,%u,%u,%lu,%lu,%lu,%u,%u,%lu\n",
+				flow.id, flow.src, flow.dst, flow.size, flow.startTime, flow.endTime,
+				flow.endTime - flow.startTime, 0, 0, flow.idealFctNs);
+			fflush(fluidLogPtr);
+		}
+		fluidCompleted += 1;
+		Simulator::ScheduleNow(&PointToPointNetDevice::NotifyFlowComplete, nics[flow.src], flow);
+		CountFluid(fluid, -1);
+		it = fluidFlows.erase(it);
+	}
+}
+
+void UpdateFluid();
+
+// New rates for the flows present, and the event of the next completion
+void ReallocateFluid(){
+	AllocateFluidRates();
+
+	// Next completion
+	Simulator::Cancel(fluidEvent);
+	double next = -1;
+	for(auto& it : fluidFlows){
+		if(!it.second.foreground && it.second.rate > 0){
+			double time = it.second.remaining * 8 / it.second.rate;
+			if(next < 0 || time < next)
+				next = time;
+		}
+	}
+	if(next >= 0)
+		fluidEvent = Simulator::Schedule(NanoSeconds(std::ceil(next * 1e9)), &UpdateFluid);
+}
+
+void UpdateFluid(){
+	AdvanceFluid();
+	ReallocateFluid();
+}
+
+void FluidForegroundComplete(const FlowInfo& flow){
+	auto it = fluidFlows.find(flow.id);
+	if(it == fluidFlows.end() || !it->second.foreground)
+		return;
+	if(!MeetsFluid(it->second.links)){
+		fluidFlows.erase(it);
+		return;
+	}
+	AdvanceFluid();
+	fluidFlows.erase(it);
+	ReallocateFluid();
+}
+
+// Add a fluid flow, or a packet-level flow competing with them
+void AddFluidFlow(FlowInfo flow, FILE* logPtr){
+	if(fluidLinks.empty()){
+		for(auto& nic : nics)
+			nic->TraceConnectWithoutContext("FlowComplete", MakeCallback(&FluidForegroundComplete));
+	}
+	fluidLogPtr = logPtr;
+
+	FluidFlow fluid;
+	fluid.flow = flow;
+	fluid.links = GetFluidPath(flow);
+	fluid.remaining = flow.size;
+	fluid.foreground = !IsFluidFlow(flow);
+	if(fluid.foreground && !MeetsFluid(fluid.links)){
+		fluidFlows[flow.id] = fluid;
+		return;
+	}
+
+	AdvanceFluid();
+	CountFluid(fluid, 1);
+	fluidFlows[flow.id] = fluid;
+	ReallocateFluid();
+}
+
+#endif /* FLUID_H */
@@ -0,0 +1,127 @@
+#ifndef INCAST_H
+#define INCAST_H
+
+#include "flow-schedule.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * Periodic synchronized incast: every period, fanIn random senders start a
+ * response of size bytes towards one random receiver of the target racks at
+ * the same time. The query completes with its last response; query completion
+ * times go to <log>.qct as id,dst,fanIn,size,start,end,qct.
+ */
+// Above the 3 streams of every uint32 host of the workload
+const int64_t INCAST_STREAM = 1LL << 40;
+
+struct IncastQuery
+{
+	uint32_t dst;
+	uint32_t remaining;
+	uint64_t startNs;
+};
+
+std::vector<IncastQuery> incastQueries;
+std::unordered_map<uint32_t, uint32_t> incastFlows; // flow id -> query
+std::vector<uint32_t> incastTargets;                // hosts that receive queries
+Ptr<UniformRandomVariable> incastRng;
+FILE* qctFilePtr = nullptr;
+
+uint32_t queryFanIn = 0;
+uint32_t querySize = 0;
+uint64_t queryPeriodNs = 0;
+uint64_t queryEndNs = 0;
+
+void IncastFlowComplete(const FlowInfo& flow){
+	auto it = incastFlows.find(flow.id);
+	if(it == incastFlows.end())
+		return; // Not an incast flow
+	IncastQuery& query = incastQueries[it->second];
+	uint32_t queryId = it->second;
+	incastFlows.erase(it);
+
+	if(--query.remaining == 0){
+		uint64_t now = Simulator::Now().GetNanoSeconds();
+		fprintf(qctFilePtr, "%u,%u,%u,%u,%lu,%lu,%lu\n",
+			queryId, query.dst, queryFanIn, querySize,
+			query.startNs, now, now - query.startNs);
+		fflush(qctFilePtr);
+	}
+}
+
+void StartIncast(){
+	uint32_t numHosts = nics.size();
+	IncastQuery query;
+	query.dst = incastTargets[incastRng->GetInteger(0, incastTargets.size() - 1)];
+	query.remaining = queryFanIn;
+	query.startNs = Simulator::Now().GetNanoSeconds();
+	uint32_t queryId = incastQueries.size();
+	incastQueries.push_back(query);
+
+	// Partial Fisher-Yates over the other hosts
+	std::vector<uint32_t> hosts;
+	hosts.reserve(numHosts - 1);
+	for(uint32_t host = 0;host < numHosts;++host){
+		if(host != query.dst)
+			hosts.push_back(host);
+	}
+	for(uint32_t i = 0;i < queryFanIn;++i){
+		std::swap(hosts[i], hosts[incastRng->GetInteger(i, hosts.size() - 1)]);
+
+		FlowInfo flow;
+		flow.id = NextFlowId();
+		flow.src = hosts[i];
+		flow.dst = query.dst;
+		flow.size = querySize;
+		flow.startTime = query.startNs;
+		incastFlows[flow.id] = queryId;
+		StartFlow(flow);
+	}
+
+	if(query.startNs + queryPeriodNs <= queryEndNs)
+		Simulator::Schedule(NanoSeconds(queryPeriodNs), &StartIncast);
+}
+
+/**
+ * Schedule incast queries every periodUs from startTime for duration seconds.
+ * racks is a comma-separated list of target rack indexes (empty: all racks).
+ */
+void ScheduleIncast(
+	uint32_t fanIn,
+	uint32_t size,
+	double periodUs,
+	std::string racks,
+	double startTime,
+	double duration){
+
+	NS_ABORT_MSG_IF(fanIn >= nics.size(), "Fan-in " << fanIn << " needs more than " << nics.size() << " hosts");
+	queryFanIn = fanIn;
+	querySize = std::max(1u, size);
+	queryPeriodNs = std::max(1.0, periodUs * 1000);
+	queryEndNs = (startTime + duration) * 1e9;
+
+	std::set<uint32_t> targetRacks;
+	std::istringstream rackList(racks);
+	std::string rack;
+	while(std::getline(rackList, rack, ','))
+		targetRacks.insert(std::stoul(rack));
+	for(uint32_t host = 0;host < nics.size();++host){
+		if(targetRacks.empty() || targetRacks.count(hostRack[host]))
+			incastTargets.push_back(host);
+	}
+	NS_ABORT_MSG_IF(incastTargets.empty(), "No host in racks " << racks);
+
+	incastRng = CreateObject<UniformRandomVariable>();
+	incastRng->SetStream(INCAST_STREAM);
+
+	OpenFctLog();
+	qctFilePtr = fopen((logFile + ".qct").c_str(), "w");
+	for(auto& nic : nics)
+		nic->TraceConnectWithoutContext("FlowComplete", MakeCallback(&IncastFlowComplete));
+
+	Simulator::Schedule(Seconds(startTime), &StartIncast);
+}
+
+#endif /* INCAST_H */
@@ -0,0 +1,133 @@
+#ifndef PATH_METRIC_H
+#define PATH_METRIC_H
+
+#include "topology.h"
+
+#include <limits>
+
+using namespace ns3;
+
+// Base RTT and bottleneck rate between two racks, without the host links
+struct PathMetric
+{
+	uint64_t rttNs = 0;
+	uint64_t bottleneckBps = std::numeric_limits<uint64_t>::max();
+};
+
+std::vector<uint32_t> hostRack;                  // host id -> rack index
+std::vector<uint64_t> hostUpRttNs;               // host -> ToR link, data serialized by the host
+std::vector<uint64_t> hostDownRttNs;             // ToR -> host link, data serialized by the ToR
+std::vector<uint64_t> hostBps;                   // rate of the host link
+std::vector<std::vector<PathMetric>> rackMetrics; // [src rack][dst rack]
+uint32_t maxPathSwitches = 0;                    // switches on the longest shortest-hop path
+
+uint64_t
+SerializationNs(uint32_t bytes, DataRate rate)
+{
+	return (uint64_t)bytes * 8 * 1000000000ULL / rate.GetBitRate();
+}
+
+/**
+ * Compute the base RTT of every (src rack, dst rack) pair once per topology.
+ * A BFS from each ToR follows the shortest-hop paths that ECMP routing uses and,
+ * among them, keeps the one with the lowest propagation delay (both ways) plus
+ * the serialization of one data packet of packetSize bytes per hop.
+ */
+void BuildPathMetric(uint32_t packetSize = 4000){
+	hostRack.assign(nics.size(), 0);
+	hostUpRttNs.assign(nics.size(), 0);
+	hostDownRttNs.assign(nics.size(), 0);
+	hostBps.assign(nics.size(), 0);
+
+	std::unordered_map<uint32_t, uint32_t> rackIndex; // node id -> rack index
+	std::vector<Ptr<Node>> racks;
+
+	for(uint32_t hostId = 0;hostId < nics.size();++hostId){
+		Ptr<PointToPointNetDevice> nic = nics[hostId];
+		Ptr<PointToPointNetDevice> peer = GetPeerDevice(nic);
+		if(peer == nullptr){
+			std::cerr << "Host " << hostId << " is not connected" << std::endl;
+			continue;
+		}
+		uint64_t delay = DynamicCast<PointToPointChannel>(nic->GetChannel())->GetDelay().GetNanoSeconds();
+		hostUpRttNs[hostId] = 2 * delay + SerializationNs(packetSize, nic->GetDataRate());
+		hostDownRttNs[hostId] = 2 * delay + SerializationNs(packetSize, peer->GetDataRate());
+		hostBps[hostId] = std::min(nic->GetDataRate().GetBitRate(), peer->GetDataRate().GetBitRate());
+
+		Ptr<Node> tor = peer->GetNode();
+		auto it = rackIndex.find(tor->GetId());
+		if(it == rackIndex.end()){
+			it = rackIndex.emplace(tor->GetId(), racks.size()).first;
+			racks.push_back(tor);
+		}
+		hostRack[hostId] = it->second;
+	}
+
+	uint32_t numRacks = racks.size();
+	rackMetrics.assign(numRacks, std::vector<PathMetric>(numRacks));
+
+	for(uint32_t src = 0;src < numRacks;++src){
+		std::unordered_map<uint32_t, uint32_t> hops;
+		std::unordered_map<uint32_t, PathMetric> metrics;
+		std::vector<Ptr<Node>> queue;
+
+		hops[racks[src]->GetId()] = 0;
+		metrics[racks[src]->GetId()] = PathMetric();
+		queue.push_back(racks[src]);
+
+		for(uint32_t head = 0;head < queue.size();++head){
+			Ptr<Node> node = queue[head];
+			uint32_t nodeHops = hops[node->GetId()];
+			PathMetric nodeMetric = metrics[node->GetId()];
+
+			for(uint32_t i = 0;i < node->GetNDevices();++i){
+				Ptr<PointToPointNetDevice> dev = DynamicCast<PointToPointNetDevice>(node->GetDevice(i));
+				if(dev == nullptr)
+					continue;
+				Ptr<PointToPointNetDevice> peer = GetPeerDevice(dev);
+				if(peer == nullptr || DynamicCast<SwitchNode>(peer->GetNode()) == nullptr)
+					continue; // Only switches forward packets
+
+				Ptr<Node> next = peer->GetNode();
+				uint64_t delay = DynamicCast<PointToPointChannel>(dev->GetChannel())->GetDelay().GetNanoSeconds();
+
+				PathMetric metric;
+				metric.rttNs = nodeMetric.rttNs + 2 * delay + SerializationNs(packetSize, dev->GetDataRate());
+				metric.bottleneckBps = std::min(nodeMetric.bottleneckBps, dev->GetDataRate().GetBitRate());
+
+				auto it = hops.find(next->GetId());
+				if(it == hops.end()){
+					hops[next->GetId()] = nodeHops + 1;
+					metrics[next->GetId()] = metric;
+					queue.push_back(next);
+				}
+				else if(it->second == nodeHops + 1 && metric.rttNs < metrics[next->GetId()].rttNs){
+					metrics[next->GetId()] = metric;
+				}
+			}
+		}
+
+		for(uint32_t dst = 0;dst < numRacks;++dst){
+			auto it = metrics.find(racks[dst]->GetId());
+			if(it == metrics.end()){
+				std::cerr << "Rack " << dst << " is not reachable from rack " << src << std::endl;
+				continue;
+			}
+			rackMetrics[src][dst] = it->second;
+			maxPathSwitches = std::max(maxPathSwitches, hops[racks[dst]->GetId()] + 1);
+		}
+	}
+}
+
+// Base RTT from src host to dst host, O(1)
+uint64_t GetMinRtt(uint32_t src, uint32_t dst){
+	return hostUpRttNs[src] + rackMetrics[hostRack[src]][hostRack[dst]].rttNs + hostDownRttNs[dst];
+}
+
+// FCT of a flow alone in the network: base RTT plus size at the bottleneck rate
+uint64_t GetIdealFct(uint32_t src, uint32_t dst, uint32_t size){
+	uint64_t bottleneck = std::min({hostBps[src], hostBps[dst], rackMetrics[hostRack[src]][hostRack[dst]].bottleneckBps});
+	return GetMinRtt(src, dst) + (uint64_t)size * 8 * 1000000000ULL / bottleneck;
+}
+
+#endif /* PATH_METRIC_H */
@@ -0,0 +1,171 @@
+#include "fabric.h"
+#include "collective.h"
+
+#include "ns3/channel-list.h"
+#include "ns3/test.h"
+
+#include <set>
+
+using namespace ns3;
+
+/**
+ * Tests of the scenario code that pfc.cc builds on. Test files are read
+ * relative to the repository root, run as:
+ *   ./ns3 run "pfc-test --suite=pfc-scenarios"
+ */
+
+// Forget the fabric of the previous test case, whose nodes Simulator::Destroy releases
+void ClearFabric(){
+	servers.clear();
+	nics.clear();
+	tors.clear();
+	aggs.clear();
+	cores.clear();
+	switches.clear();
+}
+
+Time GetLinkDelay(Ptr<PointToPointNetDevice> dev){
+	return DynamicCast<PointToPointChannel>(dev->GetChannel())->GetDelay();
+}
+
+class TopologyFileTest : public TestCase
+{
+public:
+	TopologyFileTest();
+
+private:
+	void DoRun() override;
+};
+
+TopologyFileTest::TopologyFileTest()
+	: TestCase("A topology file builds and routes its fabric")
+{
+}
+
+void
+TopologyFileTest::DoRun()
+{
+	BuildTopology("src/topology-read/examples/Fabric_toposample.txt");
+
+	NS_TEST_ASSERT_MSG_EQ(servers.size(), 4, "Wrong number of hosts");
+	NS_TEST_ASSERT_MSG_EQ(nics.size(), 4, "Wrong number of host links");
+	NS_TEST_ASSERT_MSG_EQ(tors.size(), 2, "Wrong number of level 1 switches");
+	NS_TEST_ASSERT_MSG_EQ(aggs.size(), 2, "Wrong number of level 2 switches");
+	NS_TEST_ASSERT_MSG_EQ(switches.size(), 4, "Wrong number of switches");
+	NS_TEST_ASSERT_MSG_EQ(NodeList::GetNNodes(), 8, "Wrong number of nodes");
+	NS_TEST_ASSERT_MSG_EQ(ChannelList::GetNChannels(), 8, "Wrong number of links");
+
+	for(uint32_t host = 0;host < 3;++host){
+		NS_TEST_ASSERT_MSG_EQ(nics[host]->GetDataRate(), DataRate("100Gbps"), "Wrong rate of host " << host);
+		NS_TEST_ASSERT_MSG_EQ(GetLinkDelay(nics[host]), MicroSeconds(1), "Wrong delay of host " << host);
+	}
+	NS_TEST_ASSERT_MSG_EQ(nics[3]->GetDataRate(), DataRate("25Gbps"), "Wrong rate of host 3");
+	NS_TEST_ASSERT_MSG_EQ(GetPeerDevice(nics[3])->GetDataRate(), DataRate("25Gbps"), "Wrong rate of the ToR port of host 3");
+	NS_TEST_ASSERT_MSG_EQ(GetLinkDelay(nics[3]), MicroSeconds(2), "Wrong delay of host 3");
+
+	// Each leaf has its hosts and one uplink to every spine
+	for(auto leaf : tors){
+		uint32_t uplinks = 0;
+		for(uint32_t i = 0;i < leaf->GetNDevices();++i){
+			Ptr<PointToPointNetDevice> dev = DynamicCast<PointToPointNetDevice>(leaf->GetDevice(i));
+			if(dev == nullptr || DynamicCast<SwitchNode>(GetPeerDevice(dev)->GetNode()) == nullptr)
+				continue;
+			uplinks += 1;
+			NS_TEST_ASSERT_MSG_EQ(dev->GetDataRate(), DataRate("400Gbps"), "Wrong rate of an uplink");
+			NS_TEST_ASSERT_MSG_EQ(GetLinkDelay(dev), NanoSeconds(500), "Wrong delay of an uplink");
+		}
+		NS_TEST_ASSERT_MSG_EQ(uplinks, 2, "Wrong number of uplinks");
+	}
+
+	NS_TEST_ASSERT_MSG_EQ(CheckReachability(), 0, "Unrouted (switch, host) pairs");
+
+	ClearFabric();
+	Simulator::Destroy();
+}
+
+// Runs a ring AllReduce on the four hosts of the sample fabric while a trace
+// replays: trace flows are read before they start, collective flows start
+// on completions, and every flow must still get its own id
+class CollectiveTraceTest : public TestCase
+{
+public:
+	CollectiveTraceTest();
+
+private:
+	void DoRun() override;
+	void FlowComplete(const FlowInfo& flow);
+
+	static const uint32_t TRACE_FLOWS = 20;
+	std::multiset<uint32_t> m_completed; // ids of the completed flows
+};
+
+CollectiveTraceTest::CollectiveTraceTest()
+	: TestCase("A collective next to a trace gives every flow its own id")
+{
+}
+
+void
+CollectiveTraceTest::FlowComplete(const FlowInfo& flow)
+{
+	m_completed.insert(flow.id);
+}
+
+void
+CollectiveTraceTest::DoRun()
+{
+	BuildTopology("src/topology-read/examples/Fabric_toposample.txt");
+	BuildPathMetric();
+	logFile = CreateTempDirFilename("collective-trace");
+	for(auto& nic : nics)
+		nic->TraceConnectWithoutContext("FlowComplete", MakeCallback(&CollectiveTraceTest::FlowComplete, this));
+
+	// Trace flows every 2us from the start of the collective
+	flowFilePtr = tmpfile();
+	for(uint32_t i = 0;i < TRACE_FLOWS;++i)
+		fprintf(flowFilePtr, "%u %u %u %lu\n", i % 4, (i + 1) % 4, 20000, 2000000000UL + 2000 * i);
+	rewind(flowFilePtr);
+	OpenFctLog();
+	ReadLine();
+
+	// 2 iterations of 2 (4 - 1) steps of 4 flows
+	ScheduleCollective("allreduce", 80000, 1, 4, 2, 0, 2.0);
+	Simulator::Stop(Seconds(3));
+	Simulator::Run();
+
+	uint32_t collectiveFlowCount = 2 * 6 * 4;
+	NS_TEST_ASSERT_MSG_EQ(collectives[0].iteration, 2, "The collective did not complete its iterations");
+	NS_TEST_ASSERT_MSG_EQ(m_completed.size(), TRACE_FLOWS + collectiveFlowCount, "Wrong number of completed flows");
+	NS_TEST_ASSERT_MSG_EQ(std::set<uint32_t>(m_completed.begin(), m_completed.end()).size(), m_completed.size(),
+		"Flows share an id");
+
+	fclose(flowFilePtr);
+	fclose(logFilePtr);
+	fclose(collFilePtr);
+	flowFilePtr = logFilePtr = collFilePtr = nullptr;
+	collectives.clear();
+	collectiveFlows.clear();
+	lastFlowId = 0;
+	ClearFabric();
+	Simulator::Destroy();
+}
+
+class PfcScenarioTestSuite : public TestSuite
+{
+public:
+	PfcScenarioTestSuite();
+};
+
+PfcScenarioTestSuite::PfcScenarioTestSuite()
+	: TestSuite("pfc-scenarios", Type::UNIT)
+{
+	AddTestCase(new TopologyFileTest, TestCase::Duration::QUICK);
+	AddTestCase(new CollectiveTraceTest, TestCase::Duration::QUICK);
+}
+
+static PfcScenarioTestSuite g_pfcScenarioTestSuite;
+
+int
+main(int argc, char* argv[])
+{
+	return TestRunner::Run(argc, argv);
+}
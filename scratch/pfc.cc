@@ -1,4 +1,8 @@
-#include "flow-schedule.h"
+#include "fabric.h"
+#include "collective.h"
+#include "incast.h"
+#include "workload.h"
+#include "sched-trace.h"
 
 using namespace ns3;
 
@@ -7,33 +11,242 @@ NS_LOG_COMPONENT_DEFINE("PFC");
 int
 main(int argc, char* argv[])
 {
-	srand(11);
-	
 	flowFile = "test";
+	std::string topoFile;
+
+	uint32_t K = 4;
+	uint32_t numBlock = 5;
+	uint32_t ratio = 4;
+	std::string hostRate = "100Gbps";
+	std::string fabricRate = "400Gbps";
+	std::string linkDelay = "1us";
+
+	std::string fabric = "fattree";
+	uint32_t hostsPerSwitch = 16;
+	uint32_t spines = 4;
+	uint32_t leaves = 20;
+	uint32_t groups = 5;
+	uint32_t routers = 4;
+	uint32_t globalLinks = 1;
+	uint32_t planes = 4;
+	uint32_t pods = 5;
+	uint32_t torsPerPod = 4;
+	uint32_t units = 5;
+	uint32_t serversPerUnit = 8;
+	uint32_t rails = 8;
+	bool checkRoute = true;
+	bool persistentQp = false;
+	uint32_t qpSched = 0;
+	uint32_t piasThreshold = 100000;
+	uint32_t trainSegments = 1;
+	uint32_t minRto = 0;
+	std::string intEncoding = "compact";
+	bool pint = false;
+	uint32_t intHops = 0;
+	uint32_t bufferInterval = 0;
+	uint32_t bufferDecimation = 0;
+	std::string benchFile;
+	std::string schedTrace;
 
 	double duration = 1.0;
 	double startTime = 2.0;
 
+	std::string cdfFile;
+	double load = 0.5;
+	double flowTime = 0.2;
+
+	std::string collective;
+	uint32_t collSize = 1 << 24;
+	uint32_t collJobs = 1;
+	uint32_t collRanks = 0;
+	uint32_t collIters = 1;
+	double collGap = 0;
+
+	uint32_t incastFanIn = 0;
+	uint32_t incastSize = 64000;
+	double incastPeriod = 1000;
+	std::string incastRacks;
+
 	CommandLine cmd(__FILE__);
 	cmd.AddValue("time", "the total run time (s), by default 1.0", duration);
 	cmd.AddValue("startTime", "the start time (s), by default 2.0", startTime);
 	cmd.AddValue("flow", "the flow file", flowFile);
+	cmd.AddValue("cdf", "generate flows from commands/traffic_cdf/<cdf>.txt instead of the flow file", cdfFile);
+	cmd.AddValue("load", "the load of generated flows on each host link, by default 0.5", load);
+	cmd.AddValue("flowTime", "the time (s) during which flows are generated, by default 0.2", flowTime);
+	cmd.AddValue("collective", "allreduce, treeallreduce, reducescatter, allgather or alltoall, by default none", collective);
+	cmd.AddValue("collSize", "the buffer size (bytes) of each collective, by default 16MB", collSize);
+	cmd.AddValue("collJobs", "the number of concurrent collective jobs, by default 1", collJobs);
+	cmd.AddValue("collRanks", "the ranks of each job, by default all hosts split over the jobs", collRanks);
+	cmd.AddValue("collIters", "the iterations of each job, by default 1", collIters);
+	cmd.AddValue("collGap", "the compute time (us) between iterations, by default 0", collGap);
+	cmd.AddValue("incastFanIn", "the senders of each incast query, by default 0 (no incast)", incastFanIn);
+	cmd.AddValue("incastSize", "the response size (bytes) of each incast sender, by default 64000", incastSize);
+	cmd.AddValue("incastPeriod", "the interval (us) between incast queries, by default 1000", incastPeriod);
+	cmd.AddValue("incastRacks", "the comma-separated target racks of incast queries, by default all", incastRacks);
+	cmd.AddValue("topo", "the topology file in topology/, by default the fat-tree below", topoFile);
+	cmd.AddValue("fabric", "fattree, leafspine, dragonfly, multiplane or rail, by default fattree", fabric);
+	cmd.AddValue("hostRate", "the rate of host links, by default 100Gbps", hostRate);
+	cmd.AddValue("fabricRate", "the rate of switch links, by default 400Gbps", fabricRate);
+	cmd.AddValue("delay", "the delay of every link, by default 1us", linkDelay);
+	cmd.AddValue("k", "fattree: switches per pod tier, by default 4", K);
+	cmd.AddValue("block", "fattree: number of pods, by default 5", numBlock);
+	cmd.AddValue("ratio", "fattree: hosts per ToR uplink, by default 4", ratio);
+	cmd.AddValue("hostsPerSwitch", "leafspine/dragonfly/multiplane: hosts per leaf, router or ToR, by default 16", hostsPerSwitch);
+	cmd.AddValue("spines", "leafspine/rail: spines, multiplane: spines per plane, by default 4", spines);
+	cmd.AddValue("leaves", "leafspine: leaves, by default 20", leaves);
+	cmd.AddValue("groups", "dragonfly: groups, by default 5", groups);
+	cmd.AddValue("routers", "dragonfly: routers per group, by default 4", routers);
+	cmd.AddValue("globalLinks", "dragonfly: global links per router, by default 1", globalLinks);
+	cmd.AddValue("planes", "multiplane: planes, by default 4", planes);
+	cmd.AddValue("pods", "multiplane: pods, by default 5", pods);
+	cmd.AddValue("torsPerPod", "multiplane: ToRs per pod, by default 4", torsPerPod);
+	cmd.AddValue("units", "rail: scalable units, by default 5", units);
+	cmd.AddValue("serversPerUnit", "rail: servers per scalable unit, by default 8", serversPerUnit);
+	cmd.AddValue("rails", "rail: GPUs (rails) per server, by default 8", rails);
+	cmd.AddValue("checkRoute", "check that every switch routes to every host, by default true", checkRoute);
 
     cmd.AddValue("cc", "the version of congestion control. 0 : no congestion control", ccVersion);
     cmd.AddValue("pfc", "the version of PFC. 0 : no PFC", pfcVersion);
+    cmd.AddValue("trim", "trim data packets to headers on buffer overflow", packetTrim);
+    cmd.AddValue("intEncoding", "the HPCC INT fields, compact (8 bytes per hop) or wide (16 bytes), by default compact", intEncoding);
+    cmd.AddValue("pint", "carry the HPCC INT of one sampled hop per packet", pint);
+    cmd.AddValue("intHops", "the HPCC INT slots per packet, by default the switches of the longest path", intHops);
+    cmd.AddValue("internetStack", "install the ns-3 internet stack on every node, unused by RDMA, by default false", internetStack);
+    cmd.AddValue("persistentQp", "send flows as messages of one QP per (src, dst, tenant)", persistentQp);
+    cmd.AddValue("qpSched", "the NIC arbitration among QPs. 0 : earliest pacing time, 1 : SRPT, 2 : WFQ, 3 : PIAS", qpSched);
+    cmd.AddValue("piasThreshold", "the bytes of a message sent at high priority with PIAS, by default 100000", piasThreshold);
+    cmd.AddValue("minRto", "the lower bound (us) of the adaptive retransmission timeout, by default 100 without PFC and 2000 (fixed) with PFC", minRto);
+    cmd.AddValue("train", "the most back-to-back segments sent as one packet train, by default 1 (off)", trainSegments);
+    cmd.AddValue("fluidSize", "flows of at least this size (bytes) are fluid background flows, by default 0 (none)", fluidThreshold);
+    cmd.AddValue("fluidShare", "the most of each link given to fluid flows, by default 0.9", fluidShare);
+    cmd.AddValue("bufferInterval", "sample every switch port buffer to <log>.buffer at this interval (ns), by default 0 (off)", bufferInterval);
+    cmd.AddValue("bufferDecimation", "sample a switch port buffer on every this many changes, by default 0 (off)", bufferDecimation);
+    cmd.AddValue("bench", "write the simulator throughput as JSON to this file", benchFile);
+    cmd.AddValue("schedTrace", "record the scheduler operations to this file for bench-scheduler", schedTrace);
     cmd.Parse(argc, argv);
 
+    if(!schedTrace.empty()){
+        TraceScheduler::schedTraceFile = schedTrace;
+        ObjectFactory factory;
+        factory.SetTypeId(TraceScheduler::GetTypeId());
+        Simulator::SetScheduler(factory);
+    }
+
+    Config::SetDefault("ns3::PointToPointNetDevice::PersistentQp", BooleanValue(persistentQp));
+    Config::SetDefault("ns3::PointToPointNetDevice::QpScheduler", UintegerValue(qpSched));
+    Config::SetDefault("ns3::PointToPointNetDevice::PiasThreshold", UintegerValue(piasThreshold));
+    Config::SetDefault("ns3::PointToPointNetDevice::TrainSegments", UintegerValue(trainSegments));
+    // PFC pauses routinely last longer than an RTT-derived timeout
+    if(minRto == 0)
+        minRto = pfcVersion == 0 ? 100 : 2000;
+    Config::SetDefault("ns3::RdmaQueuePair::MinRto", TimeValue(MicroSeconds(minRto)));
+
+    // PFC pauses and protects priority 2 only
+    if(ccVersion == 5 && pfcVersion != 0)
+        std::cerr << "Warning: receiver-driven transport sends grants and trimmed headers on priority 0, "
+                  << "unscheduled data on 1 and low-ranked scheduled data on 3, which PFC does not protect"
+                  << std::endl;
+    if(qpSched == 3 && pfcVersion != 0)
+        std::cerr << "Warning: PIAS sends the first bytes of each message on priority "
+                  << (uint32_t)RdmaQueuePair::m_piasPriority << ", which PFC does not protect" << std::endl;
+
+    if(intEncoding == "wide")
+        IntHeader::SetEncoding(IntHeader::WIDE);
+    else if(intEncoding != "compact")
+        NS_ABORT_MSG("Unknown INT encoding " << intEncoding);
+    HpccHeader::SetPint(pint);
+
+    if(!cdfFile.empty()){
+        std::ostringstream name;
+        name << cdfFile << "_" << load << "_" << flowTime;
+        flowFile = name.str();
+    }
+
     logFile = "logs/" + flowFile + "s_PFC" + std::to_string(pfcVersion) + "_CC" + std::to_string(ccVersion);
-	BuildFatTree(logFile);
-	std::cout << "Build Topology" << std::endl;
+    if(packetTrim)
+        logFile += "_Trim";
+    if(intEncoding != "compact")
+        logFile += "_Int" + intEncoding;
+    if(pint)
+        logFile += "_Pint";
+    if(persistentQp)
+        logFile += "_PQP";
+    if(qpSched != 0)
+        logFile += "_Sched" + std::to_string(qpSched);
+    if(trainSegments > 1)
+        logFile += "_Train" + std::to_string(trainSegments);
+    if(minRto != (pfcVersion == 0 ? 100 : 2000))
+        logFile += "_Rto" + std::to_string(minRto);
+    if(fluidThreshold > 0)
+        logFile += "_Fluid" + std::to_string(fluidThreshold);
+    if(!topoFile.empty())
+        logFile += "_" + topoFile;
+    else if(fabric != "fattree")
+        logFile += "_" + fabric;
+    if(!collective.empty())
+        logFile += "_" + collective;
+    if(incastFanIn > 0)
+        logFile += "_Incast" + std::to_string(incastFanIn);
+	auto buildStart = std::chrono::system_clock::now();
+	if(!topoFile.empty())
+		BuildTopology("topology/" + topoFile + ".txt");
+	else if(fabric == "fattree")
+		BuildFatTree(logFile, K, numBlock, ratio, hostRate, fabricRate, linkDelay);
+	else if(fabric == "leafspine")
+		BuildLeafSpine(leaves, spines, hostsPerSwitch, hostRate, fabricRate, linkDelay);
+	else if(fabric == "dragonfly")
+		BuildDragonfly(groups, routers, hostsPerSwitch, globalLinks, hostRate, fabricRate, linkDelay);
+	else if(fabric == "multiplane")
+		BuildMultiPlaneClos(planes, pods, torsPerPod, hostsPerSwitch, spines, hostRate, fabricRate, linkDelay);
+	else if(fabric == "rail")
+		BuildRailOptimized(units, serversPerUnit, rails, spines, hostRate, fabricRate, linkDelay);
+	else
+		NS_ABORT_MSG("Unknown fabric " << fabric);
+	ReportBuild("Topology", buildStart);
+
+	if(checkRoute && CheckReachability() > 0)
+		NS_ABORT_MSG("Routing does not reach every host");
+
+	BuildPathMetric();
+	std::cout << "Build Path Metric" << std::endl;
+	if(intHops == 0)
+		intHops = std::clamp<uint32_t>(maxPathSwitches, 1, HpccHeader::MAX_HOPS);
+	HpccHeader::SetHops(intHops);
+	ConnectFctStats();
+
+	if(bufferInterval > 0 || bufferDecimation > 0){
+		Ptr<BufferSampler> sampler = Create<BufferSampler>(logFile + ".buffer");
+		for(auto sw : switches){
+			sw->SetBufferSampler(sampler, bufferDecimation);
+			if(bufferInterval > 0)
+				Simulator::Schedule(Seconds(startTime), &SwitchNode::SampleBuffers, sw,
+					NanoSeconds(bufferInterval), Seconds(startTime + duration));
+		}
+	}
 
-	ScheduleFlow();
+	if(cdfFile.empty())
+		ScheduleFlow();
+	else
+		StartWorkload(cdfFile, load, startTime, flowTime);
+	if(!collective.empty())
+		ScheduleCollective(collective, collSize, collJobs, collRanks, collIters, collGap, startTime);
+	if(incastFanIn > 0)
+		ScheduleIncast(incastFanIn, incastSize, incastPeriod, incastRacks, startTime, flowTime);
 
 	std::cout << "Start Application" << std::endl;
 	auto start = std::chrono::system_clock::now();
 
 	Simulator::Stop(Seconds(startTime + duration + 5));
 	Simulator::Run();
+	std::chrono::duration<double> runTime = std::chrono::system_clock::now() - start;
+	if(!benchFile.empty())
+		WriteBenchmark(benchFile, runTime.count());
+	PrintFctStats();
+	if(!cdfFile.empty())
+		std::cout << "Generated " << workloadFlows << " flows" << std::endl;
+	if(fluidThreshold > 0)
+		std::cout << "Completed " << fluidCompleted << " fluid flows" << std::endl;
 	Simulator::Destroy();
 
 	auto end = std::chrono::system_clock::now();
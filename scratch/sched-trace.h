@@ -0,0 +1,74 @@
+#ifndef SCHED_TRACE_H
+#define SCHED_TRACE_H
+
+#include "ns3/core-module.h"
+
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * Record of the event-set operations of a run, replayed by bench-scheduler
+ * against every scheduler. Each operation is two uint64_t words: the event
+ * time, then (uid << 2) | op.
+ */
+enum SchedTraceOp : uint64_t
+{
+	SCHED_INSERT = 0,
+	SCHED_REMOVE_NEXT = 1,
+	SCHED_REMOVE = 2,
+};
+
+/**
+ * MapScheduler, the default, that writes its operations to schedTraceFile.
+ */
+class TraceScheduler : public MapScheduler
+{
+public:
+	static TypeId GetTypeId(){
+		static TypeId tid = TypeId("ns3::TraceScheduler")
+			.SetParent<MapScheduler>()
+			.SetGroupName("Core")
+			.AddConstructor<TraceScheduler>();
+		return tid;
+	}
+
+	static std::string schedTraceFile;
+
+	TraceScheduler(){
+		m_file = fopen(schedTraceFile.c_str(), "wb");
+		NS_ABORT_MSG_IF(m_file == nullptr, "Cannot open scheduler trace " << schedTraceFile);
+	}
+
+	~TraceScheduler() override{
+		fclose(m_file);
+	}
+
+	void Insert(const Scheduler::Event& ev) override{
+		Write(ev, SCHED_INSERT);
+		MapScheduler::Insert(ev);
+	}
+
+	Scheduler::Event RemoveNext() override{
+		Scheduler::Event ev = MapScheduler::RemoveNext();
+		Write(ev, SCHED_REMOVE_NEXT);
+		return ev;
+	}
+
+	void Remove(const Scheduler::Event& ev) override{
+		Write(ev, SCHED_REMOVE);
+		MapScheduler::Remove(ev);
+	}
+
+private:
+	void Write(const Scheduler::Event& ev, SchedTraceOp op){
+		uint64_t record[2] = {ev.key.m_ts, ((uint64_t)ev.key.m_uid << 2) | op};
+		fwrite(record, sizeof(record), 1, m_file);
+	}
+
+	FILE* m_file;
+};
+
+std::string TraceScheduler::schedTraceFile;
+
+#endif /* SCHED_TRACE_H */
@@ -4,8 +4,17 @@
 #include "ns3/core-module.h"
 #include "ns3/internet-module.h"
 #include "ns3/point-to-point-module.h"
+#include "ns3/topology-read-module.h"
 #include "ns3/traffic-control-module.h"
 
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+
 using namespace ns3;
 
 std::string flowFile;
@@ -13,14 +22,295 @@ std::string logFile;
 
 uint32_t ccVersion = 0;
 uint32_t pfcVersion = 0;
+bool packetTrim = false;
+bool internetStack = false;
 
-// Fat-tree
 std::vector<Ptr<Node>> servers;
 std::vector<Ptr<PointToPointNetDevice>> nics;
+// Switches of level 1 (ToR, leaf), 2 (aggregation, spine of two tiers) and 3, whatever the topology
 std::vector<Ptr<SwitchNode>> tors;
 std::vector<Ptr<SwitchNode>> aggs;
 std::vector<Ptr<SwitchNode>> cores;
 
+// Every switch, whatever the topology
+std::vector<Ptr<SwitchNode>> switches;
+
+// Run fn(i) for every i in [0, n) on all cores; fn may only modify state owned by i
+template <typename Fn>
+void ParallelFor(uint32_t n, Fn fn){
+	uint32_t numThreads = std::max(1u, std::min(n, std::thread::hardware_concurrency()));
+	std::atomic<uint32_t> next(0);
+	std::vector<std::thread> threads;
+	for(uint32_t t = 1;t < numThreads;++t){
+		threads.emplace_back([&](){
+			for(uint32_t i = next++;i < n;i = next++)
+				fn(i);
+		});
+	}
+	for(uint32_t i = next++;i < n;i = next++)
+		fn(i);
+	for(auto& thread : threads)
+		thread.join();
+}
+
+void ReportBuild(std::string name, std::chrono::system_clock::time_point start){
+	std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	std::cout << "Build " << name << " in " << diff.count() << "s, "
+		<< servers.size() << " hosts, " << switches.size() << " switches, "
+		<< "peak memory " << usage.ru_maxrss / 1024 << "MB" << std::endl;
+}
+
+// Resident memory of the process in bytes
+uint64_t ResidentMemory(){
+	uint64_t pages = 0, resident = 0;
+	FILE* statm = fopen("/proc/self/statm", "r");
+	if(statm != nullptr){
+		if(fscanf(statm, "%lu %lu", &pages, &resident) != 2)
+			resident = 0;
+		fclose(statm);
+	}
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * Install the ns-3 internet stack on every node if internetStack is set, and
+ * report what it costs. Nothing in the RDMA path needs it: NICs build and parse
+ * their own IPv4/UDP/BTH headers with host ids as addresses, and switches route
+ * on these ids.
+ */
+void InstallInternetStack(){
+	if(!internetStack)
+		return;
+	auto start = std::chrono::system_clock::now();
+	uint64_t before = ResidentMemory();
+	InternetStackHelper internet;
+	internet.InstallAll();
+	std::chrono::duration<double> diff = std::chrono::system_clock::now() - start;
+	std::cout << "Install Internet Stack in " << diff.count() << "s, "
+		<< NodeList::GetNNodes() << " nodes, "
+		<< (ResidentMemory() - before) / (1 << 20) << "MB" << std::endl;
+}
+
+/**
+ * Write the simulator throughput of a run as JSON, for commands/benchmark.py.
+ * Call after Simulator::Run and before Simulator::Destroy.
+ */
+void WriteBenchmark(std::string file, double wallTime){
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	uint64_t events = Simulator::GetEventCount();
+	uint64_t packets = PointToPointNetDevice::GetTxPacketCount();
+	EventImpl::AllocationStats alloc = Simulator::GetEventAllocationStats();
+
+	FILE* out = fopen(file.c_str(), "w");
+	NS_ABORT_MSG_IF(out == nullptr, "Cannot open benchmark file " << file);
+	fprintf(out, "{\n");
+	fprintf(out, "  \"hosts\": %lu,\n", servers.size());
+	fprintf(out, "  \"switches\": %lu,\n", switches.size());
+	fprintf(out, "  \"sim_time_s\": %.9f,\n", Simulator::Now().GetSeconds());
+	fprintf(out, "  \"wall_time_s\": %.6f,\n", wallTime);
+	fprintf(out, "  \"events\": %lu,\n", events);
+	fprintf(out, "  \"events_per_s\": %.1f,\n", events / wallTime);
+	fprintf(out, "  \"packets\": %lu,\n", packets);
+	fprintf(out, "  \"packets_per_s\": %.1f,\n", packets / wallTime);
+	fprintf(out, "  \"peak_rss_mb\": %.1f,\n", usage.ru_maxrss / 1024.0);
+	fprintf(out, "  \"scheduler_hwm\": %lu,\n", Simulator::GetEventHighWaterMark());
+	fprintf(out, "  \"event_allocs\": %lu,\n", alloc.allocations);
+	fprintf(out, "  \"event_heap_allocs\": %lu,\n", alloc.chunks + alloc.large);
+#ifdef NS3_FAST_FABRIC
+	fprintf(out, "  \"fast_fabric\": true\n");
+#else
+	fprintf(out, "  \"fast_fabric\": false\n");
+#endif
+	fprintf(out, "}\n");
+	fclose(out);
+}
+
+Ptr<PointToPointNetDevice>
+GetPeerDevice(Ptr<PointToPointNetDevice> dev)
+{
+	Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel>(dev->GetChannel());
+	if(channel == nullptr)
+		return nullptr;
+	for(uint32_t i = 0;i < channel->GetNDevices();++i){
+		Ptr<PointToPointNetDevice> peer = channel->GetPointToPointDevice(i);
+		if(peer != dev)
+			return peer;
+	}
+	return nullptr;
+}
+
+// Switch ids are SWITCH_ID_STRIDE * (level + 1) + index within the level
+const uint32_t SWITCH_ID_STRIDE = 1000000;
+
+uint32_t SwitchId(uint32_t level, uint32_t index){
+	NS_ABORT_MSG_IF(index >= SWITCH_ID_STRIDE, "More than " << SWITCH_ID_STRIDE << " switches at level " << level);
+	NS_ABORT_MSG_IF(level + 1 >= UINT32_MAX / SWITCH_ID_STRIDE, "Switch level " << level << " too high");
+	return SWITCH_ID_STRIDE * (level + 1) + index;
+}
+
+// Every switch has its own ECMP seed: with one seed per level, switches of the
+// same level on a path (e.g. Dragonfly local, global, local) would all make the same choice
+void ConfigureSwitch(Ptr<SwitchNode> sw, uint32_t level, uint32_t index){
+	sw->SetECMPHash(SwitchId(level, index));
+	sw->SetId(SwitchId(level, index));
+	sw->SetPFC(pfcVersion);
+	sw->SetCC(ccVersion);
+	sw->SetTrim(packetTrim);
+	switches.push_back(sw);
+	if(level == 1)
+		tors.push_back(sw);
+	else if(level == 2)
+		aggs.push_back(sw);
+	else if(level == 3)
+		cores.push_back(sw);
+}
+
+// Create the index-th switch of a level
+Ptr<SwitchNode> CreateSwitch(uint32_t level, uint32_t index){
+	Ptr<SwitchNode> sw = CreateObject<SwitchNode>();
+	ConfigureSwitch(sw, level, index);
+	return sw;
+}
+
+NetDeviceContainer InstallLink(PointToPointHelper& helper, Ptr<Node> a, Ptr<Node> b){
+	NetDeviceContainer ndc = helper.Install(a, b);
+	for(int i = 0;i < 2;++i){
+		auto nic = DynamicCast<PointToPointNetDevice>(ndc.Get(i));
+		nic->SetCC(ccVersion);
+		nic->SetPFC(pfcVersion);
+	}
+	return ndc;
+}
+
+void AddServerNic(uint32_t serverId, Ptr<NetDevice> dev){
+	auto nic = DynamicCast<PointToPointNetDevice>(dev);
+	nic->SetId(serverId);
+	nic->SetDeviceType(PointToPointNetDevice::NetDeviceType::SERVER);
+	if(nics.size() <= serverId)
+		nics.resize(serverId + 1);
+	NS_ABORT_MSG_IF(nics[serverId] != nullptr, "Host " << serverId << " has more than one link");
+	nics[serverId] = nic;
+}
+
+// Peer of a switch port: a switch index, a host id, or nothing
+struct PortPeer
+{
+	uint32_t index = UINT32_MAX;
+	bool isSwitch = false;
+};
+
+/**
+ * Peers of every port of every switch, as [switch index][device id].
+ * serverPort is filled with the port of the rack switch facing each host.
+ */
+std::vector<std::vector<PortPeer>> GetSwitchPorts(std::vector<uint32_t>& serverPort){
+	std::unordered_map<uint32_t, PortPeer> peers; // node id -> peer
+	for(uint32_t i = 0;i < switches.size();++i)
+		peers[switches[i]->Node::GetId()] = PortPeer{i, true};
+	for(uint32_t serverId = 0;serverId < nics.size();++serverId){
+		if(nics[serverId] != nullptr)
+			peers[nics[serverId]->GetNode()->GetId()] = PortPeer{serverId, false};
+	}
+
+	serverPort.assign(nics.size(), UINT32_MAX);
+	std::vector<std::vector<PortPeer>> ports(switches.size());
+	for(uint32_t i = 0;i < switches.size();++i){
+		ports[i].resize(switches[i]->GetNDevices());
+		for(uint32_t devId = 0;devId < switches[i]->GetNDevices();++devId){
+			Ptr<PointToPointNetDevice> dev = DynamicCast<PointToPointNetDevice>(switches[i]->GetDevice(devId));
+			Ptr<PointToPointNetDevice> peer = dev ? GetPeerDevice(dev) : nullptr;
+			if(peer == nullptr)
+				continue;
+			auto it = peers.find(peer->GetNode()->GetId());
+			if(it == peers.end())
+				continue;
+			ports[i][devId] = it->second;
+			if(!it->second.isSwitch)
+				serverPort[it->second.index] = devId;
+		}
+	}
+	return ports;
+}
+
+/**
+ * Shortest-path ECMP routing for any topology made of servers (one NIC each) and switches.
+ * A BFS from every rack (the switch a server is attached to) gives the hop count of each
+ * switch to the rack; a switch then routes the servers of the rack over all its ports to
+ * switches one hop closer. Racks and switches are independent, so both steps run in parallel.
+ */
+void BuildEcmpRoute(){
+	uint32_t numSwitches = switches.size();
+	std::vector<uint32_t> serverPort;
+	std::vector<std::vector<PortPeer>> ports = GetSwitchPorts(serverPort);
+
+	std::vector<std::vector<uint32_t>> rackServers(numSwitches); // switch index -> servers
+	for(uint32_t i = 0;i < numSwitches;++i){
+		for(auto& peer : ports[i]){
+			if(peer.index != UINT32_MAX && !peer.isSwitch)
+				rackServers[i].push_back(peer.index);
+		}
+	}
+	for(uint32_t serverId = 0;serverId < nics.size();++serverId){
+		if(serverPort[serverId] == UINT32_MAX)
+			std::cerr << "Host " << serverId << " is not connected to a switch" << std::endl;
+	}
+
+	std::vector<uint32_t> rackSwitch; // rack -> switch index
+	for(uint32_t i = 0;i < numSwitches;++i){
+		if(!rackServers[i].empty())
+			rackSwitch.push_back(i);
+	}
+
+	uint32_t numRacks = rackSwitch.size();
+	std::vector<std::vector<uint32_t>> hops(numRacks);
+	ParallelFor(numRacks, [&](uint32_t rack){
+		std::vector<uint32_t>& dist = hops[rack];
+		dist.assign(numSwitches, UINT32_MAX);
+		std::vector<uint32_t> queue{rackSwitch[rack]};
+		dist[rackSwitch[rack]] = 0;
+		for(uint32_t head = 0;head < queue.size();++head){
+			uint32_t sw = queue[head];
+			for(auto& peer : ports[sw]){
+				if(peer.isSwitch && dist[peer.index] == UINT32_MAX){
+					dist[peer.index] = dist[sw] + 1;
+					queue.push_back(peer.index);
+				}
+			}
+		}
+	});
+
+	// Raw pointers: Ptr copies are not thread-safe
+	std::vector<SwitchNode*> raw(numSwitches);
+	for(uint32_t i = 0;i < numSwitches;++i)
+		raw[i] = PeekPointer(switches[i]);
+
+	ParallelFor(numSwitches, [&](uint32_t sw){
+		std::vector<uint32_t> next;
+		for(uint32_t rack = 0;rack < numRacks;++rack){
+			const std::vector<uint32_t>& dist = hops[rack];
+			const std::vector<uint32_t>& hosts = rackServers[rackSwitch[rack]];
+			if(dist[sw] == UINT32_MAX)
+				continue;
+			if(dist[sw] == 0){
+				for(uint32_t serverId : hosts)
+					raw[sw]->AddHostRouteTo(serverId, serverPort[serverId]);
+				continue;
+			}
+			next.clear();
+			for(uint32_t devId = 0;devId < ports[sw].size();++devId){
+				const PortPeer& peer = ports[sw][devId];
+				if(peer.isSwitch && dist[peer.index] + 1 == dist[sw])
+					next.push_back(devId);
+			}
+			for(uint32_t serverId : hosts)
+				raw[sw]->AddHostRouteTo(serverId, next);
+		}
+	});
+}
+
 void BuildFatTreeRoute(
 	uint32_t K, 
     uint32_t NUM_BLOCK ,
@@ -32,11 +322,13 @@ void BuildFatTreeRoute(
     uint32_t numTors = K * NUM_BLOCK;
     uint32_t numAggs = K * NUM_BLOCK;
     uint32_t numCores = K * K;
+	// Device id of the first link, behind the loopback of the internet stack
+	uint32_t first = internetStack ? 1 : 0;
 
 	for(uint32_t coreId = 0;coreId < numCores;++coreId){
 		for(uint32_t serverId = 0;serverId < servers.size();++serverId){
 			uint32_t blockId = serverId / K / K / RATIO;
-			cores[coreId]->AddHostRouteTo(serverId, blockId + 1);
+			cores[coreId]->AddHostRouteTo(serverId, first + blockId);
 		}
 	}
 
@@ -44,12 +336,12 @@ void BuildFatTreeRoute(
 		for(uint32_t serverId = 0;serverId < servers.size();++serverId){
 			uint32_t blockId = serverId / K / K / RATIO;
 			if(blockId != aggId / K){
-				for(uint32_t coreId = 1;coreId <= K;++coreId){
-					aggs[aggId]->AddHostRouteTo(serverId, K + coreId);
+				for(uint32_t coreId = 0;coreId < K;++coreId){
+					aggs[aggId]->AddHostRouteTo(serverId, first + K + coreId);
 				}
 			}
 			else{
-				aggs[aggId]->AddHostRouteTo(serverId, (serverId / numServerperRack) % K + 1);
+				aggs[aggId]->AddHostRouteTo(serverId, first + (serverId / numServerperRack) % K);
 			}
 		}
 	}
@@ -58,12 +350,12 @@ void BuildFatTreeRoute(
 		for(uint32_t serverId = 0;serverId < servers.size();++serverId){
 			uint32_t rackId = serverId / numServerperRack;
 			if(rackId != torId){
-				for(uint32_t aggId = 1;aggId <= K;++aggId){
-					tors[torId]->AddHostRouteTo(serverId, numServerperRack + aggId);
+				for(uint32_t aggId = 0;aggId < K;++aggId){
+					tors[torId]->AddHostRouteTo(serverId, first + numServerperRack + aggId);
 				}
 			}
 			else{
-				tors[torId]->AddHostRouteTo(serverId, serverId % numServerperRack + 1);
+				tors[torId]->AddHostRouteTo(serverId, first + serverId % numServerperRack);
 			}
 		}
 	}
@@ -73,7 +365,10 @@ void BuildFatTree(
     std::string logFile,
     uint32_t K = 4, 
     uint32_t NUM_BLOCK = 5,
-	uint32_t RATIO = 4){
+	uint32_t RATIO = 4,
+	std::string hostRate = "100Gbps",
+	std::string fabricRate = "400Gbps",
+	std::string linkDelay = "1us"){
 
 	uint32_t numServer = K * K * NUM_BLOCK * RATIO;
     uint32_t numServerperRack = K * RATIO;
@@ -83,63 +378,37 @@ void BuildFatTree(
     uint32_t numCores = K * K;
 
 	servers.resize(numServer);
-	tors.resize(numTors);
-	aggs.resize(numAggs);
-	cores.resize(numCores);
 
 	for(uint32_t i = 0;i < numServer;++i){
 		servers[i] = CreateObject<Node>();
 	}
+	// Paths cross each tier at most once, so the fat-tree keeps its seed per tier
 	for(uint32_t i = 0;i < numTors;++i){
-		tors[i] = CreateObject<SwitchNode>(); 
-		tors[i]->SetECMPHash(1);
-		tors[i]->SetId(2000 + i);
-        tors[i]->SetPFC(pfcVersion);
-		tors[i]->SetCC(ccVersion);
+		CreateSwitch(1, i)->SetECMPHash(1);
 	}
 	for(uint32_t i = 0;i < numAggs;++i){
-		aggs[i] = CreateObject<SwitchNode>();
-		aggs[i]->SetECMPHash(2);
-		aggs[i]->SetId(3000 + i);
-		aggs[i]->SetPFC(pfcVersion);
-		aggs[i]->SetCC(ccVersion);
+		CreateSwitch(2, i)->SetECMPHash(2);
 	}
 	for(uint32_t i = 0;i < numCores;++i){
-		cores[i] = CreateObject<SwitchNode>();
-		cores[i]->SetECMPHash(3);
-		cores[i]->SetId(4000 + i);
-		cores[i]->SetPFC(pfcVersion);
-		cores[i]->SetCC(ccVersion);
+		CreateSwitch(3, i)->SetECMPHash(3);
 	}
 
-	InternetStackHelper internet;
-    internet.InstallAll();
+	InstallInternetStack();
 
 	// Initilize link
 	PointToPointHelper linkServerSwitch;
-	linkServerSwitch.SetDeviceAttribute("DataRate", StringValue("100Gbps"));
-	linkServerSwitch.SetChannelAttribute("Delay", StringValue("1us"));
+	linkServerSwitch.SetDeviceAttribute("DataRate", StringValue(hostRate));
+	linkServerSwitch.SetChannelAttribute("Delay", StringValue(linkDelay));
 
 	PointToPointHelper linkSwitchSwitch;
-	linkSwitchSwitch.SetDeviceAttribute("DataRate", StringValue("400Gbps"));
-	linkSwitchSwitch.SetChannelAttribute("Delay", StringValue("1us"));
+	linkSwitchSwitch.SetDeviceAttribute("DataRate", StringValue(fabricRate));
+	linkSwitchSwitch.SetChannelAttribute("Delay", StringValue(linkDelay));
 
-	Ipv4AddressHelper ipv4;
 	for(uint32_t torId = 0;torId < numTors;++torId){
 		for(uint32_t j = 0;j < numServerperRack;++j){
 			uint32_t serverId = torId * numServerperRack + j;
-			NetDeviceContainer ndc = linkServerSwitch.Install(servers[serverId], tors[torId]);
-			for(int i = 0;i < 2;++i){
-				auto nic = DynamicCast<PointToPointNetDevice>(ndc.Get(i));
-				nic->SetCC(ccVersion);
-				nic->SetPFC(pfcVersion);
-			}
-			auto nic = DynamicCast<PointToPointNetDevice>(ndc.Get(0));
-			nic->SetId(serverId);
-			nic->SetCC(ccVersion);
-			nic->SetPFC(pfcVersion);
-			nic->SetDeviceType(PointToPointNetDevice::NetDeviceType::SERVER);
-			nics.push_back(nic);
+			NetDeviceContainer ndc = InstallLink(linkServerSwitch, servers[serverId], tors[torId]);
+			AddServerNic(serverId, ndc.Get(0));
 		}
 	}
 	
@@ -148,12 +417,7 @@ void BuildFatTree(
 			for(uint32_t k = 0;k < K;++k){
                 uint32_t torId = blockId * K + j;
                 uint32_t aggId = blockId * K + k;
-				NetDeviceContainer ndc = linkSwitchSwitch.Install(tors[torId], aggs[aggId]);
-				for(int i = 0;i < 2;++i){
-					auto nic = DynamicCast<PointToPointNetDevice>(ndc.Get(i));
-					nic->SetCC(ccVersion);
-					nic->SetPFC(pfcVersion);
-				}
+				InstallLink(linkSwitchSwitch, tors[torId], aggs[aggId]);
 			}
 		}
 	}
@@ -163,12 +427,7 @@ void BuildFatTree(
 			for(uint32_t k = 0;k < K;++k){
                 uint32_t aggId = blockId * K + j;
                 uint32_t coreId = j * K + k;
-				NetDeviceContainer ndc = linkSwitchSwitch.Install(aggs[aggId], cores[coreId]);
-				for(int i = 0;i < 2;++i){
-					auto nic = DynamicCast<PointToPointNetDevice>(ndc.Get(i));
-					nic->SetCC(ccVersion);
-					nic->SetPFC(pfcVersion);
-				}
+				InstallLink(linkSwitchSwitch, aggs[aggId], cores[coreId]);
 			}
 		}
 	}
@@ -176,4 +435,62 @@ void BuildFatTree(
 	BuildFatTreeRoute(K, NUM_BLOCK, RATIO);
 }
 
+/**
+ * Build the topology described in topoFile (see FabricTopologyReader).
+ * Hosts keep their declaration order as host id and switches get the id
+ * of their level and index within the level, as in BuildFatTree.
+ */
+void BuildTopology(std::string topoFile){
+	TopologyReaderHelper readerHelper;
+	readerHelper.SetFileName(topoFile);
+	readerHelper.SetFileType("Fabric");
+	Ptr<FabricTopologyReader> reader = DynamicCast<FabricTopologyReader>(readerHelper.GetTopologyReader());
+	NodeContainer nodes = reader->Read();
+	NS_ABORT_MSG_IF(nodes.GetN() == 0, "Cannot read topology " << topoFile);
+
+	std::unordered_map<uint32_t, uint32_t> serverIndex; // node id -> host id
+	NodeContainer hosts = reader->GetHosts();
+	for(uint32_t i = 0;i < hosts.GetN();++i){
+		servers.push_back(hosts.Get(i));
+		serverIndex[hosts.Get(i)->GetId()] = i;
+	}
+
+	std::unordered_map<uint32_t, uint32_t> levelCount;
+	NodeContainer fabric = reader->GetSwitches();
+	for(uint32_t i = 0;i < fabric.GetN();++i){
+		Ptr<SwitchNode> sw = DynamicCast<SwitchNode>(fabric.Get(i));
+		NS_ABORT_MSG_IF(sw == nullptr, "Switch " << i << " is not a SwitchNode");
+		uint32_t level = reader->GetSwitchLevel(i);
+		ConfigureSwitch(sw, level, levelCount[level]++);
+	}
+
+	InstallInternetStack();
+
+	// One helper per (rate, delay) pair
+	std::map<std::pair<std::string, std::string>, PointToPointHelper> links;
+	nics.assign(servers.size(), nullptr);
+	for(auto it = reader->LinksBegin();it != reader->LinksEnd();++it){
+		std::string rate = it->GetAttribute("DataRate");
+		std::string delay = it->GetAttribute("Delay");
+		auto helper = links.find({rate, delay});
+		if(helper == links.end()){
+			helper = links.emplace(std::make_pair(rate, delay), PointToPointHelper()).first;
+			helper->second.SetDeviceAttribute("DataRate", StringValue(rate));
+			helper->second.SetChannelAttribute("Delay", StringValue(delay));
+		}
+
+		NetDeviceContainer ndc = InstallLink(helper->second, it->GetFromNode(), it->GetToNode());
+		Ptr<Node> ends[2] = {it->GetFromNode(), it->GetToNode()};
+		for(int i = 0;i < 2;++i){
+			auto server = serverIndex.find(ends[i]->GetId());
+			if(server != serverIndex.end())
+				AddServerNic(server->second, ndc.Get(i));
+		}
+	}
+	for(uint32_t serverId = 0;serverId < nics.size();++serverId)
+		NS_ABORT_MSG_IF(nics[serverId] == nullptr, "Host " << serverId << " has no link");
+
+	BuildEcmpRoute();
+}
+
 #endif 
\ No newline at end of file
@@ -0,0 +1,104 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "flow-schedule.h"
+
+#include <fstream>
+
+using namespace ns3;
+
+/**
+ * On-the-fly version of commands/traffic_gen.py: every host runs its own Poisson
+ * arrival process at the given fraction of its link rate, with flow sizes from a
+ * traffic_cdf/*.txt CDF and uniform destinations. Each host owns the RNG streams
+ * of its arrivals, sizes and destinations, so a host's flows do not depend on
+ * the number of hosts or on the other hosts. The other RNG streams start at
+ * 1 << 40, above those of any uint32 host.
+ */
+const int64_t WORKLOAD_STREAM_BASE = 100000;
+
+struct HostWorkload
+{
+	Ptr<ExponentialRandomVariable> arrival;
+	Ptr<EmpiricalRandomVariable> size;
+	Ptr<UniformRandomVariable> dst;
+};
+
+std::vector<HostWorkload> workloads;
+uint64_t workloadEndNs = 0;
+uint64_t workloadFlows = 0;
+
+// CDF as (size, probability) points; returns the mean size
+double ReadCdf(std::string cdfFile, std::vector<std::pair<double, double>>& cdf){
+	std::ifstream in("commands/traffic_cdf/" + cdfFile + ".txt");
+	NS_ABORT_MSG_IF(!in.is_open(), "Cannot open CDF " << cdfFile);
+
+	double x, y;
+	while(in >> x >> y)
+		cdf.emplace_back(x, y);
+	NS_ABORT_MSG_IF(cdf.size() < 2 || cdf.front().second != 0.0 || cdf.back().second != 1.0,
+		"Not valid CDF " << cdfFile);
+
+	double avg = 0;
+	for(uint32_t i = 1;i < cdf.size();++i)
+		avg += (cdf[i].first + cdf[i - 1].first) / 2.0 * (cdf[i].second - cdf[i - 1].second);
+	return avg;
+}
+
+void GenerateFlow(uint32_t src){
+	HostWorkload& host = workloads[src];
+	uint32_t numHosts = workloads.size();
+
+	FlowInfo flow;
+	flow.id = NextFlowId();
+	flow.src = src;
+	flow.dst = host.dst->GetInteger(0, numHosts - 2);
+	if(flow.dst >= src)
+		flow.dst += 1;
+	flow.size = std::max(1.0, host.size->Interpolate());
+	flow.startTime = Simulator::Now().GetNanoSeconds();
+	StartFlow(flow);
+	workloadFlows += 1;
+
+	uint64_t interval = std::max(1.0, host.arrival->GetValue());
+	if(flow.startTime + interval <= workloadEndNs)
+		Simulator::Schedule(NanoSeconds(interval), &GenerateFlow, src);
+}
+
+/**
+ * Start the workload on all hosts from startTime for duration seconds.
+ * load is the fraction of each host's link rate offered by its flows.
+ */
+void StartWorkload(std::string cdfFile, double load, double startTime, double duration){
+	std::vector<std::pair<double, double>> cdf;
+	double avgSize = ReadCdf(cdfFile, cdf);
+	uint32_t numHosts = nics.size();
+	NS_ABORT_MSG_IF(numHosts < 2, "The workload needs at least two hosts");
+
+	OpenFctLog();
+	uint64_t startNs = startTime * 1e9;
+	workloadEndNs = startNs + duration * 1e9;
+	workloads.resize(numHosts);
+
+	for(uint32_t src = 0;src < numHosts;++src){
+		HostWorkload& host = workloads[src];
+		double flowsPerNs = nics[src]->GetDataRate().GetBitRate() * load / 8.0 / avgSize / 1e9;
+
+		host.arrival = CreateObject<ExponentialRandomVariable>();
+		host.arrival->SetAttribute("Mean", DoubleValue(1.0 / flowsPerNs));
+		host.size = CreateObject<EmpiricalRandomVariable>();
+		for(auto& point : cdf)
+			host.size->CDF(point.first, point.second);
+		host.dst = CreateObject<UniformRandomVariable>();
+
+		host.arrival->SetStream(WORKLOAD_STREAM_BASE + 3 * src);
+		host.size->SetStream(WORKLOAD_STREAM_BASE + 3 * src + 1);
+		host.dst->SetStream(WORKLOAD_STREAM_BASE + 3 * src + 2);
+
+		uint64_t first = startNs + std::max(1.0, host.arrival->GetValue());
+		if(first <= workloadEndNs)
+			Simulator::Schedule(NanoSeconds(first), &GenerateFlow, src);
+	}
+}
+
+#endif /* WORKLOAD_H */
@@ -50,14 +50,14 @@ CalendarScheduler::GetTypeId()
 
 CalendarScheduler::CalendarScheduler()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     Init(2, 1, 0);
     m_qSize = 0;
 }
 
 CalendarScheduler::~CalendarScheduler()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     delete[] m_buckets;
     m_buckets = nullptr;
 }
@@ -65,7 +65,7 @@ CalendarScheduler::~CalendarScheduler()
 void
 CalendarScheduler::SetReverse(bool reverse)
 {
-    NS_LOG_FUNCTION(this << reverse);
+    NS_LOG_FUNCTION_HOT(this << reverse);
     m_reverse = reverse;
 
     if (m_reverse)
@@ -85,7 +85,7 @@ CalendarScheduler::SetReverse(bool reverse)
 void
 CalendarScheduler::Init(uint32_t nBuckets, uint64_t width, uint64_t startPrio)
 {
-    NS_LOG_FUNCTION(this << nBuckets << width << startPrio);
+    NS_LOG_FUNCTION_HOT(this << nBuckets << width << startPrio);
     m_buckets = new Bucket[nBuckets];
     m_nBuckets = nBuckets;
     m_width = width;
@@ -97,7 +97,7 @@ CalendarScheduler::Init(uint32_t nBuckets, uint64_t width, uint64_t startPrio)
 void
 CalendarScheduler::PrintInfo()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     std::cout << "nBuckets=" << m_nBuckets << ", width=" << m_width << std::endl;
     std::cout << "Bucket Distribution ";
@@ -111,7 +111,7 @@ CalendarScheduler::PrintInfo()
 uint32_t
 CalendarScheduler::Hash(uint64_t ts) const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     uint32_t bucket = (ts / m_width) % m_nBuckets;
     return bucket;
@@ -120,10 +120,10 @@ CalendarScheduler::Hash(uint64_t ts) const
 void
 CalendarScheduler::DoInsert(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << ev.key.m_ts << ev.key.m_uid);
+    NS_LOG_FUNCTION_HOT(this << ev.key.m_ts << ev.key.m_uid);
     // calculate bucket index.
     uint32_t bucket = Hash(ev.key.m_ts);
-    NS_LOG_LOGIC("insert in bucket=" << bucket);
+    NS_LOG_LOGIC_HOT("insert in bucket=" << bucket);
 
     // insert in bucket list.
     auto end = m_buckets[bucket].end();
@@ -141,7 +141,7 @@ CalendarScheduler::DoInsert(const Event& ev)
 void
 CalendarScheduler::Insert(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << &ev);
+    NS_LOG_FUNCTION_HOT(this << &ev);
     DoInsert(ev);
     m_qSize++;
     ResizeUp();
@@ -150,14 +150,14 @@ CalendarScheduler::Insert(const Event& ev)
 bool
 CalendarScheduler::IsEmpty() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_qSize == 0;
 }
 
 Scheduler::Event
 CalendarScheduler::PeekNext() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     NS_ASSERT(!IsEmpty());
     uint32_t i = m_lastBucket;
     uint64_t bucketTop = m_bucketTop;
@@ -191,7 +191,7 @@ CalendarScheduler::PeekNext() const
 Scheduler::Event
 CalendarScheduler::DoRemoveNext()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     uint32_t i = m_lastBucket;
     uint64_t bucketTop = m_bucketTop;
@@ -237,12 +237,12 @@ CalendarScheduler::DoRemoveNext()
 Scheduler::Event
 CalendarScheduler::RemoveNext()
 {
-    NS_LOG_FUNCTION(this << m_lastBucket << m_bucketTop);
+    NS_LOG_FUNCTION_HOT(this << m_lastBucket << m_bucketTop);
     NS_ASSERT(!IsEmpty());
 
     Scheduler::Event ev = DoRemoveNext();
-    NS_LOG_LOGIC("remove ts=" << ev.key.m_ts << ", key=" << ev.key.m_uid
-                              << ", from bucket=" << m_lastBucket);
+    NS_LOG_LOGIC_HOT("remove ts=" << ev.key.m_ts << ", key=" << ev.key.m_uid
+                                  << ", from bucket=" << m_lastBucket);
     m_qSize--;
     ResizeDown();
     return ev;
@@ -251,7 +251,7 @@ CalendarScheduler::RemoveNext()
 void
 CalendarScheduler::Remove(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << &ev);
+    NS_LOG_FUNCTION_HOT(this << &ev);
     NS_ASSERT(!IsEmpty());
     // bucket index of event
     uint32_t bucket = Hash(ev.key.m_ts);
@@ -275,7 +275,7 @@ CalendarScheduler::Remove(const Event& ev)
 void
 CalendarScheduler::ResizeUp()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     if (m_qSize > m_nBuckets * 2 && m_nBuckets < 32768)
     {
@@ -286,7 +286,7 @@ CalendarScheduler::ResizeUp()
 void
 CalendarScheduler::ResizeDown()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     if (m_qSize < m_nBuckets / 2)
     {
@@ -297,7 +297,7 @@ CalendarScheduler::ResizeDown()
 uint64_t
 CalendarScheduler::CalculateNewWidth()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     if (m_qSize < 2)
     {
@@ -376,7 +376,7 @@ CalendarScheduler::CalculateNewWidth()
 void
 CalendarScheduler::DoResize(uint32_t newSize, uint64_t newWidth)
 {
-    NS_LOG_FUNCTION(this << newSize << newWidth);
+    NS_LOG_FUNCTION_HOT(this << newSize << newWidth);
 
     Bucket* oldBuckets = m_buckets;
     uint32_t oldNBuckets = m_nBuckets;
@@ -396,7 +396,7 @@ CalendarScheduler::DoResize(uint32_t newSize, uint64_t newWidth)
 void
 CalendarScheduler::Resize(uint32_t newSize)
 {
-    NS_LOG_FUNCTION(this << newSize);
+    NS_LOG_FUNCTION_HOT(this << newSize);
 
     // PrintInfo ();
     uint64_t newWidth = CalculateNewWidth();
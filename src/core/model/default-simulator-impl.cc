@@ -13,6 +13,7 @@
 #include "scheduler.h"
 #include "simulator.h"
 
+#include <algorithm>
 #include <cmath>
 
 /**
@@ -51,6 +52,7 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_eventHighWaterMark = 0;
     m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
 }
@@ -126,7 +128,7 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_unscheduledEvents--;
     m_eventCount++;
 
-    NS_LOG_LOGIC("handle " << next.key.m_ts);
+    NS_LOG_LOGIC_HOT("handle " << next.key.m_ts);
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
@@ -134,6 +136,7 @@ DefaultSimulatorImpl::ProcessOneEvent()
     next.impl->Unref();
 
     ProcessEventsWithContext();
+    m_eventHighWaterMark = std::max<uint64_t>(m_eventHighWaterMark, m_unscheduledEvents);
 }
 
 bool
@@ -211,7 +214,7 @@ DefaultSimulatorImpl::Stop(const Time& delay)
 EventId
 DefaultSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
 {
-    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_LOG_FUNCTION_HOT(this << delay.GetTimeStep() << event);
     NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
                   "Simulator::Schedule Thread-unsafe invocation!");
 
@@ -232,7 +235,7 @@ DefaultSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
 void
 DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event)
 {
-    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+    NS_LOG_FUNCTION_HOT(this << context << delay.GetTimeStep() << event);
 
     if (m_mainThreadId == std::this_thread::get_id())
     {
@@ -386,4 +389,10 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetEventHighWaterMark() const
+{
+    return m_eventHighWaterMark;
+}
+
 } // namespace ns3
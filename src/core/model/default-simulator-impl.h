@@ -66,6 +66,7 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
+    uint64_t GetEventHighWaterMark() const override;
 
   private:
     void DoDispose() override;
@@ -122,6 +123,8 @@ class DefaultSimulatorImpl : public SimulatorImpl
      *  not counting the Destroy events; this is used for validation
      */
     int m_unscheduledEvents;
+    /** Most events pending at once, sampled after each event. */
+    uint64_t m_eventHighWaterMark;
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
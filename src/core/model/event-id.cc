@@ -28,7 +28,7 @@ EventId::EventId()
       m_context(0),
       m_uid(0)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 }
 
 EventId::EventId(const Ptr<EventImpl>& impl, uint64_t ts, uint32_t context, uint32_t uid)
@@ -37,62 +37,62 @@ EventId::EventId(const Ptr<EventImpl>& impl, uint64_t ts, uint32_t context, uint
       m_context(context),
       m_uid(uid)
 {
-    NS_LOG_FUNCTION(this << impl << ts << context << uid);
+    NS_LOG_FUNCTION_HOT(this << impl << ts << context << uid);
 }
 
 void
 EventId::Cancel()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     Simulator::Cancel(*this);
 }
 
 void
 EventId::Remove()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     Simulator::Remove(*this);
 }
 
 bool
 EventId::IsExpired() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return Simulator::IsExpired(*this);
 }
 
 bool
 EventId::IsPending() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return !IsExpired();
 }
 
 EventImpl*
 EventId::PeekEventImpl() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return PeekPointer(m_eventImpl);
 }
 
 uint64_t
 EventId::GetTs() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_ts;
 }
 
 uint32_t
 EventId::GetContext() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_context;
 }
 
 uint32_t
 EventId::GetUid() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_uid;
 }
 
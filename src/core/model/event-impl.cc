@@ -10,6 +10,12 @@
 
 #include "log.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
 /**
  * @file
  * @ingroup events
@@ -21,21 +27,222 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+/** Granularity of the size classes of the event arena. */
+const std::size_t SIZE_CLASS = 16;
+/** Number of size classes. */
+const std::size_t N_SIZE_CLASSES = EventImpl::MAX_POOLED_SIZE / SIZE_CLASS;
+/** Size of the chunks the arena carves events from. */
+const std::size_t CHUNK_SIZE = 64 * 1024;
+
+/** A free event block, linked through its first bytes. */
+struct FreeBlock
+{
+    FreeBlock* next; //!< Next free block of the size class
+};
+
+/**
+ * Free lists and current chunk of a thread. Blocks freed by another thread
+ * than the one that allocated them join the free lists of the freeing thread,
+ * so the chunks belong to the process and are returned by ReleaseArena.
+ */
+struct EventArena
+{
+    FreeBlock* freeLists[N_SIZE_CLASSES]{}; //!< Free blocks per size class
+    char* chunk{nullptr};                    //!< Unused part of the current chunk
+    std::size_t chunkLeft{0};                //!< Bytes left in the current chunk
+    uint64_t generation{0};                  //!< Chunks the free lists and chunk point into
+    std::atomic<int64_t> live{0};            //!< Pooled events allocated minus freed by the thread
+    bool exited{false};                      //!< The thread has exited, guarded by the registry
+    EventImpl::AllocationStats stats{};      //!< Counters of the thread
+};
+
+/** The chunks of all threads and the arenas carving them. */
+struct ArenaRegistry
+{
+    std::mutex mutex;                  //!< Guards chunks, arenas and EventArena::exited
+    std::vector<char*> chunks;         //!< Chunks of the current generation
+    std::vector<EventArena*> arenas;   //!< Arenas of the threads, exited or not
+    std::atomic<uint64_t> generation{0}; //!< Bumped when the chunks are returned
+};
+
+/**
+ * @returns The registry. Never destroyed, as events held by static objects
+ * may be freed after the static objects of this library.
+ */
+ArenaRegistry&
+GetRegistry()
+{
+    static ArenaRegistry* registry = new ArenaRegistry;
+    return *registry;
+}
+
+/** Registers the arena of a thread and hands it to the registry on exit. */
+struct ArenaHandle
+{
+    EventArena* arena; //!< Arena of the thread
+
+    ArenaHandle()
+        : arena(new EventArena)
+    {
+        ArenaRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.arenas.push_back(arena);
+    }
+
+    ~ArenaHandle()
+    {
+        // Its events may still be alive elsewhere, the registry frees it at release
+        ArenaRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        arena->exited = true;
+    }
+};
+
+/** @returns The arena of the calling thread, emptied if its chunks were returned. */
+EventArena&
+GetArena()
+{
+    static thread_local ArenaHandle handle;
+    EventArena& arena = *handle.arena;
+    uint64_t generation = GetRegistry().generation.load(std::memory_order_acquire);
+    if (arena.generation != generation)
+    {
+        std::fill(std::begin(arena.freeLists), std::end(arena.freeLists), nullptr);
+        arena.chunk = nullptr;
+        arena.chunkLeft = 0;
+        arena.generation = generation;
+    }
+    return arena;
+}
+
+/**
+ * Count a pooled event of the thread. Only the thread writes its counter,
+ * so a relaxed load and store are enough for ReleaseArena to read it.
+ */
+void
+AddLive(EventArena& arena, int64_t delta)
+{
+    arena.live.store(arena.live.load(std::memory_order_relaxed) + delta,
+                     std::memory_order_relaxed);
+}
+} // namespace
+
 EventImpl::~EventImpl()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 }
 
 EventImpl::EventImpl()
     : m_cancel(false)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
+}
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    EventArena& arena = GetArena();
+    arena.stats.allocations++;
+    if (size > MAX_POOLED_SIZE)
+    {
+        arena.stats.large++;
+        return ::operator new(size);
+    }
+
+    AddLive(arena, 1);
+    std::size_t sizeClass = (size - 1) / SIZE_CLASS;
+    FreeBlock* block = arena.freeLists[sizeClass];
+    if (block != nullptr)
+    {
+        arena.freeLists[sizeClass] = block->next;
+        arena.stats.reused++;
+        return block;
+    }
+
+    std::size_t blockSize = (sizeClass + 1) * SIZE_CLASS;
+    if (arena.chunkLeft < blockSize)
+    {
+        arena.chunk = static_cast<char*>(::operator new(CHUNK_SIZE));
+        arena.chunkLeft = CHUNK_SIZE;
+        arena.stats.chunks++;
+        ArenaRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.chunks.push_back(arena.chunk);
+    }
+    void* p = arena.chunk;
+    arena.chunk += blockSize;
+    arena.chunkLeft -= blockSize;
+    return p;
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    EventArena& arena = GetArena();
+    arena.stats.frees++;
+    if (size > MAX_POOLED_SIZE)
+    {
+        ::operator delete(p);
+        return;
+    }
+
+    AddLive(arena, -1);
+    std::size_t sizeClass = (size - 1) / SIZE_CLASS;
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = arena.freeLists[sizeClass];
+    arena.freeLists[sizeClass] = block;
+}
+
+EventImpl::AllocationStats
+EventImpl::GetAllocationStats()
+{
+    return GetArena().stats;
+}
+
+bool
+EventImpl::ReleaseArena()
+{
+    ArenaRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    int64_t live = 0;
+    for (EventArena* arena : registry.arenas)
+    {
+        live += arena->live.load(std::memory_order_relaxed);
+    }
+    if (live != 0)
+    {
+        NS_LOG_LOGIC(live << " pooled events alive, keeping " << registry.chunks.size()
+                          << " chunks");
+        return false;
+    }
+
+    for (char* chunk : registry.chunks)
+    {
+        ::operator delete(chunk);
+    }
+    registry.chunks.clear();
+    registry.arenas.erase(std::remove_if(registry.arenas.begin(),
+                                         registry.arenas.end(),
+                                         [](EventArena* arena) {
+                                             if (!arena->exited)
+                                             {
+                                                 return false;
+                                             }
+                                             delete arena;
+                                             return true;
+                                         }),
+                          registry.arenas.end());
+    // Every thread drops its free lists and chunk on its next event
+    registry.generation.fetch_add(1, std::memory_order_release);
+    return true;
 }
 
 void
 EventImpl::Invoke()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     if (!m_cancel)
     {
         Notify();
@@ -45,14 +252,14 @@ EventImpl::Invoke()
 void
 EventImpl::Cancel()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     m_cancel = true;
 }
 
 bool
 EventImpl::IsCancelled()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_cancel;
 }
 
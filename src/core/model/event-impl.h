@@ -10,6 +10,7 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -56,6 +57,50 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Counters of the event allocator of a thread.
+     *
+     * Events of up to MAX_POOLED_SIZE bytes are carved from arena chunks
+     * into per-size-class free lists and recycled when freed, so once the
+     * event population has been reached, scheduling takes no heap allocation.
+     */
+    struct AllocationStats
+    {
+        uint64_t allocations; //!< Events allocated by the thread
+        uint64_t reused;      //!< Of which taken from a free list
+        uint64_t large;       //!< Of which too large for the arena, from the heap
+        uint64_t frees;       //!< Events freed by the thread
+        uint64_t chunks;      //!< Arena chunks taken from the heap
+    };
+
+    /**
+     * @returns The allocation counters of the calling thread.
+     */
+    static AllocationStats GetAllocationStats();
+
+    /**
+     * Return the arena chunks of all threads to the heap, if no pooled event
+     * is alive. Called by Simulator::Destroy, once no thread schedules events.
+     * @returns Whether the chunks were returned.
+     */
+    static bool ReleaseArena();
+
+    /**
+     * Allocate an event from the free list of its size class.
+     * @param [in] size The size of the event.
+     * @returns The memory of the event.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Return an event to the free list of its size class.
+     * @param [in] p The memory of the event.
+     * @param [in] size The size of the event.
+     */
+    static void operator delete(void* p, std::size_t size);
+
+    /** Largest event kept in the arena, in bytes. */
+    static const std::size_t MAX_POOLED_SIZE = 256;
+
   protected:
     /**
      * Implementation for Invoke().
@@ -39,7 +39,7 @@ HeapScheduler::GetTypeId()
 
 HeapScheduler::HeapScheduler()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     // we purposely waste an item at the start of
     // the array to make sure the indexes in the
     // array start at one.
@@ -49,71 +49,71 @@ HeapScheduler::HeapScheduler()
 
 HeapScheduler::~HeapScheduler()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 }
 
 std::size_t
 HeapScheduler::Parent(std::size_t id) const
 {
-    NS_LOG_FUNCTION(this << id);
+    NS_LOG_FUNCTION_HOT(this << id);
     return id / 2;
 }
 
 std::size_t
 HeapScheduler::Sibling(std::size_t id) const
 {
-    NS_LOG_FUNCTION(this << id);
+    NS_LOG_FUNCTION_HOT(this << id);
     return id + 1;
 }
 
 std::size_t
 HeapScheduler::LeftChild(std::size_t id) const
 {
-    NS_LOG_FUNCTION(this << id);
+    NS_LOG_FUNCTION_HOT(this << id);
     return id * 2;
 }
 
 std::size_t
 HeapScheduler::RightChild(std::size_t id) const
 {
-    NS_LOG_FUNCTION(this << id);
+    NS_LOG_FUNCTION_HOT(this << id);
     return id * 2 + 1;
 }
 
 std::size_t
 HeapScheduler::Root() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return 1;
 }
 
 bool
 HeapScheduler::IsRoot(std::size_t id) const
 {
-    NS_LOG_FUNCTION(this << id);
+    NS_LOG_FUNCTION_HOT(this << id);
     return (id == Root());
 }
 
 std::size_t
 HeapScheduler::Last() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_heap.size() - 1;
 }
 
 bool
 HeapScheduler::IsBottom(std::size_t id) const
 {
-    NS_LOG_FUNCTION(this << id);
+    NS_LOG_FUNCTION_HOT(this << id);
     return (id >= m_heap.size());
 }
 
 void
 HeapScheduler::Exch(std::size_t a, std::size_t b)
 {
-    NS_LOG_FUNCTION(this << a << b);
+    NS_LOG_FUNCTION_HOT(this << a << b);
     NS_ASSERT(b < m_heap.size() && a < m_heap.size());
-    NS_LOG_DEBUG("Exch " << a << ", " << b);
+    NS_LOG_DEBUG_HOT("Exch " << a << ", " << b);
     Event tmp(m_heap[a]);
     m_heap[a] = m_heap[b];
     m_heap[b] = tmp;
@@ -122,28 +122,28 @@ HeapScheduler::Exch(std::size_t a, std::size_t b)
 bool
 HeapScheduler::IsLessStrictly(std::size_t a, std::size_t b) const
 {
-    NS_LOG_FUNCTION(this << a << b);
+    NS_LOG_FUNCTION_HOT(this << a << b);
     return m_heap[a] < m_heap[b];
 }
 
 std::size_t
 HeapScheduler::Smallest(std::size_t a, std::size_t b) const
 {
-    NS_LOG_FUNCTION(this << a << b);
+    NS_LOG_FUNCTION_HOT(this << a << b);
     return IsLessStrictly(a, b) ? a : b;
 }
 
 bool
 HeapScheduler::IsEmpty() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return (m_heap.size() == 1);
 }
 
 void
 HeapScheduler::BottomUp()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     std::size_t index = Last();
     while (!IsRoot(index) && IsLessStrictly(index, Parent(index)))
     {
@@ -155,7 +155,7 @@ HeapScheduler::BottomUp()
 void
 HeapScheduler::TopDown(std::size_t start)
 {
-    NS_LOG_FUNCTION(this << start);
+    NS_LOG_FUNCTION_HOT(this << start);
     std::size_t index = start;
     std::size_t right = RightChild(index);
     while (!IsBottom(right))
@@ -190,7 +190,7 @@ HeapScheduler::TopDown(std::size_t start)
 void
 HeapScheduler::Insert(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << &ev);
+    NS_LOG_FUNCTION_HOT(this << &ev);
     m_heap.push_back(ev);
     BottomUp();
 }
@@ -198,14 +198,14 @@ HeapScheduler::Insert(const Event& ev)
 Scheduler::Event
 HeapScheduler::PeekNext() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_heap[Root()];
 }
 
 Scheduler::Event
 HeapScheduler::RemoveNext()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     Event next = m_heap[Root()];
     Exch(Root(), Last());
     m_heap.pop_back();
@@ -216,7 +216,7 @@ HeapScheduler::RemoveNext()
 void
 HeapScheduler::Remove(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << &ev);
+    NS_LOG_FUNCTION_HOT(this << &ev);
     std::size_t uid = ev.key.m_uid;
     for (std::size_t i = 1; i < m_heap.size(); i++)
     {
@@ -0,0 +1,314 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+namespace
+{
+/** Buckets with more events are spread over a finer rung rather than sorted. */
+const uint32_t BUCKET_THRESHOLD = 50;
+/** Bottom grown past this size by insertions is spread over a new rung. */
+const uint32_t BOTTOM_LIMIT = 4 * BUCKET_THRESHOLD;
+/** Most rungs in use; further buckets are sorted whatever their size. */
+const uint32_t MAX_RUNGS = 8;
+
+/** Order of Bottom: decreasing, so the next event is last. */
+bool
+Later(const Scheduler::Event& a, const Scheduler::Event& b)
+{
+    return b.key < a.key;
+}
+} // namespace
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LadderScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<LadderScheduler>();
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topMin(0),
+      m_topMax(0),
+      m_topStart(0),
+      m_nRungs(0),
+      m_qSize(0)
+{
+    NS_LOG_FUNCTION_HOT(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION_HOT(this);
+}
+
+uint32_t
+LadderScheduler::FindRung(uint64_t ts) const
+{
+    // Rungs cover adjacent ranges that get earlier and finer downwards;
+    // consumed buckets of the lowest rung are in Bottom
+    for (uint32_t i = 0; i < m_nRungs; ++i)
+    {
+        const Rung& rung = m_rungs[i];
+        if (ts >= rung.start + rung.current * rung.width)
+        {
+            return i;
+        }
+    }
+    return m_nRungs;
+}
+
+LadderScheduler::Rung&
+LadderScheduler::AddRung(uint64_t start, uint64_t width, uint32_t nBuckets)
+{
+    if (m_nRungs == m_rungs.size())
+    {
+        m_rungs.emplace_back();
+    }
+    Rung& rung = m_rungs[m_nRungs++];
+    rung.start = start;
+    rung.width = width;
+    rung.current = 0;
+    rung.count = 0;
+    if (rung.buckets.size() < nBuckets)
+    {
+        rung.buckets.resize(nBuckets);
+    }
+    return rung;
+}
+
+void
+LadderScheduler::InsertInRung(Rung& rung, const Scheduler::Event& ev)
+{
+    uint64_t index = (ev.key.m_ts - rung.start) / rung.width;
+    NS_ASSERT(index >= rung.current && index < rung.buckets.size());
+    rung.buckets[index].push_back(ev);
+    rung.count++;
+}
+
+void
+LadderScheduler::InsertInBottom(const Scheduler::Event& ev)
+{
+    m_bottom.insert(std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, Later), ev);
+}
+
+void
+LadderScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION_HOT(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    m_qSize++;
+    uint64_t ts = ev.key.m_ts;
+    if (ts >= m_topStart)
+    {
+        if (m_top.empty())
+        {
+            m_topMin = ts;
+            m_topMax = ts;
+        }
+        m_topMin = std::min(m_topMin, ts);
+        m_topMax = std::max(m_topMax, ts);
+        m_top.push_back(ev);
+    }
+    else
+    {
+        uint32_t i = FindRung(ts);
+        if (i < m_nRungs)
+        {
+            InsertInRung(m_rungs[i], ev);
+        }
+        else
+        {
+            InsertInBottom(ev);
+            if (m_bottom.size() > BOTTOM_LIMIT && m_nRungs < MAX_RUNGS)
+            {
+                SpreadBottom();
+            }
+        }
+    }
+    Refill();
+}
+
+void
+LadderScheduler::SpreadBottom()
+{
+    // Bottom ends before the first bucket not consumed by the lowest rung
+    uint64_t end = m_topStart;
+    if (m_nRungs > 0)
+    {
+        const Rung& lowest = m_rungs[m_nRungs - 1];
+        end = lowest.start + lowest.current * lowest.width;
+    }
+    uint64_t start = m_bottom.back().key.m_ts;
+    if (end - start < 2)
+    {
+        return; // Cannot be spread
+    }
+
+    uint32_t n = m_bottom.size();
+    uint64_t width = std::max<uint64_t>(1, (end - start + n - 1) / n);
+    Rung& rung = AddRung(start, width, (end - start + width - 1) / width);
+    for (const auto& ev : m_bottom)
+    {
+        InsertInRung(rung, ev);
+    }
+    m_bottom.clear();
+}
+
+void
+LadderScheduler::Refill()
+{
+    while (m_bottom.empty())
+    {
+        if (m_nRungs == 0)
+        {
+            if (m_top.empty())
+            {
+                return;
+            }
+            // New epoch: spread Top over one bucket per event
+            uint32_t n = m_top.size();
+            uint64_t width = (m_topMax - m_topMin) / n + 1;
+            Rung& rung = AddRung(m_topMin, width, n);
+            m_topStart = m_topMin + width * n;
+            for (const auto& ev : m_top)
+            {
+                InsertInRung(rung, ev);
+            }
+            m_top.clear();
+        }
+
+        Rung& rung = m_rungs[m_nRungs - 1];
+        while (rung.count > 0 && rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        if (rung.count == 0)
+        {
+            m_nRungs--;
+            continue;
+        }
+
+        Bucket& bucket = rung.buckets[rung.current];
+        uint64_t bucketStart = rung.start + rung.current * rung.width;
+        uint64_t bucketWidth = rung.width;
+        rung.current++;
+        rung.count -= bucket.size();
+
+        if (bucket.size() > BUCKET_THRESHOLD && bucketWidth > 1 && m_nRungs < MAX_RUNGS)
+        {
+            // Spread over a finer rung; the bucket storage stays with its rung
+            uint32_t n = bucket.size();
+            uint64_t width = (bucketWidth + n - 1) / n;
+            Bucket events;
+            events.swap(bucket);
+            Rung& child = AddRung(bucketStart, width, (bucketWidth + width - 1) / width);
+            for (const auto& ev : events)
+            {
+                InsertInRung(child, ev);
+            }
+            events.clear();
+            // AddRung may have moved the parent rung; give the storage back by index
+            m_rungs[m_nRungs - 2].buckets[m_rungs[m_nRungs - 2].current - 1].swap(events);
+        }
+        else
+        {
+            m_bottom.swap(bucket);
+            std::sort(m_bottom.begin(), m_bottom.end(), Later);
+        }
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION_HOT(this);
+    return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION_HOT(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION_HOT(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    m_qSize--;
+    Refill();
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION_HOT(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+    uint64_t ts = ev.key.m_ts;
+    Bucket* bucket = &m_bottom;
+    Rung* rung = nullptr;
+    if (ts >= m_topStart)
+    {
+        bucket = &m_top;
+    }
+    else
+    {
+        uint32_t i = FindRung(ts);
+        if (i < m_nRungs)
+        {
+            rung = &m_rungs[i];
+            bucket = &rung->buckets[(ts - rung->start) / rung->width];
+        }
+    }
+
+    auto it = std::find_if(bucket->begin(), bucket->end(), [&ev](const Scheduler::Event& e) {
+        return e.key.m_uid == ev.key.m_uid;
+    });
+    NS_ASSERT_MSG(it != bucket->end(), "Event " << ev.key.m_uid << " not found");
+    if (bucket == &m_bottom)
+    {
+        m_bottom.erase(it); // Keep Bottom sorted
+    }
+    else
+    {
+        *it = bucket->back();
+        bucket->pop_back();
+    }
+    if (rung != nullptr)
+    {
+        rung->count--;
+    }
+    m_qSize--;
+    Refill();
+}
+
+} // namespace ns3
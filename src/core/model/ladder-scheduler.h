@@ -0,0 +1,156 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a ladder queue event scheduler
+ *
+ * This class implements the ladder queue of
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Tang, Goh and Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * Events are kept in three tiers:
+ * - Top: an unsorted vector of the far-future events, at or after
+ *   the end of the ladder.
+ * - Ladder: rungs of unsorted buckets of uniform width. When the
+ *   first bucket of the lowest rung holds more than a threshold
+ *   of events, they are spread over a new, finer rung instead of
+ *   being sorted.
+ * - Bottom: a small sorted vector of the earliest events, from
+ *   which events are removed.
+ *
+ * The bucket widths follow the event density of each epoch, so the
+ * many events clustered just after Now() get fine buckets while a thin
+ * tail of distant timers stays unsorted in Top, and no global resize
+ * is ever needed.
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or a bucket; bounded sort into Bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Last element of Bottom
+ * Remove()     | Linear          | Search within Top, a bucket or Bottom
+ * RemoveNext() | ~Constant       | Each event is moved down a bounded number of rungs
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | Buckets of the rungs             | `std::vector` per bucket, reused across epochs
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Bucket type: an unsorted vector of Events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A rung of the ladder. */
+    struct Rung
+    {
+        uint64_t start;               //!< Time of the first bucket
+        uint64_t width;               //!< Duration of a bucket
+        uint32_t current;             //!< First bucket not yet consumed
+        uint32_t count;               //!< Events in the rung
+        std::vector<Bucket> buckets; //!< Buckets of the rung
+    };
+
+    /**
+     * Find the rung covering a time.
+     *
+     * @param [in] ts The dimensionless time.
+     * @returns The rung index, or the number of rungs if the time is in Bottom.
+     */
+    uint32_t FindRung(uint64_t ts) const;
+    /**
+     * Start a new lowest rung of buckets of the given width from the given time.
+     *
+     * @param [in] start The time of the first bucket.
+     * @param [in] width The bucket width, in dimensionless time units.
+     * @param [in] nBuckets The number of buckets.
+     * @returns The new rung.
+     */
+    Rung& AddRung(uint64_t start, uint64_t width, uint32_t nBuckets);
+    /**
+     * Insert an event into a rung.
+     *
+     * @param [in] rung The rung.
+     * @param [in] ev The event.
+     */
+    void InsertInRung(Rung& rung, const Scheduler::Event& ev);
+    /**
+     * Insert an event into Bottom, keeping it sorted.
+     *
+     * @param [in] ev The event.
+     */
+    void InsertInBottom(const Scheduler::Event& ev);
+    /** Move the next events down to Bottom, if it is empty. */
+    void Refill();
+    /**
+     * Spread the events of Bottom over a new rung, when Bottom has grown
+     * past its limit through insertions.
+     */
+    void SpreadBottom();
+
+    /** Unsorted events at or after m_topStart. */
+    Bucket m_top;
+    /** Earliest time in Top. */
+    uint64_t m_topMin;
+    /** Latest time in Top. */
+    uint64_t m_topMax;
+    /** End of the ladder: events from this time on go to Top. */
+    uint64_t m_topStart;
+    /** Rungs, the first m_nRungs of which are in use, from the coarsest. */
+    std::vector<Rung> m_rungs;
+    /** Number of rungs in use. */
+    uint32_t m_nRungs;
+    /** Earliest events, in decreasing order, so the next event is last. */
+    Bucket m_bottom;
+    /** Number of events in queue. */
+    uint32_t m_qSize;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
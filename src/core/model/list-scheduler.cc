@@ -40,7 +40,7 @@ ListScheduler::GetTypeId()
 
 ListScheduler::ListScheduler()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 }
 
 ListScheduler::~ListScheduler()
@@ -50,7 +50,7 @@ ListScheduler::~ListScheduler()
 void
 ListScheduler::Insert(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << &ev);
+    NS_LOG_FUNCTION_HOT(this << &ev);
     for (auto i = m_events.begin(); i != m_events.end(); i++)
     {
         if (ev.key < i->key)
@@ -65,21 +65,21 @@ ListScheduler::Insert(const Event& ev)
 bool
 ListScheduler::IsEmpty() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_events.empty();
 }
 
 Scheduler::Event
 ListScheduler::PeekNext() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_events.front();
 }
 
 Scheduler::Event
 ListScheduler::RemoveNext()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     Event next = m_events.front();
     m_events.pop_front();
     return next;
@@ -88,7 +88,7 @@ ListScheduler::RemoveNext()
 void
 ListScheduler::Remove(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << &ev);
+    NS_LOG_FUNCTION_HOT(this << &ev);
     for (auto i = m_events.begin(); i != m_events.end(); i++)
     {
         if (i->key.m_uid == ev.key.m_uid)
@@ -270,6 +270,48 @@ void LogComponentDisableAll(LogLevel level);
  */
 #define NS_LOG_LOGIC(msg) NS_LOG(ns3::LOG_LOGIC, msg)
 
+/**
+ * @ingroup logging
+ * @{
+ * Logging macros for functions run for every packet or event.
+ *
+ * They are the plain NS_LOG_* macros, unless ns-3 is configured with
+ * NS3_FAST_FABRIC: then they compile to nothing even when logging is
+ * enabled, and leave no component check in the hot paths.
+ */
+#ifdef NS3_FAST_FABRIC
+
+/**
+ * Empty implementation of the hot path logging macros.
+ *
+ * @param [in] expr The logging expression, type checked but not run.
+ */
+#define NS_LOG_HOT_NOOP_INTERNAL(expr)                                                             \
+    do                                                                                             \
+        if (false)                                                                                 \
+        {                                                                                          \
+            expr;                                                                                  \
+        }                                                                                          \
+    while (false)
+
+#define NS_LOG_FUNCTION_HOT(parameters)                                                            \
+    NS_LOG_HOT_NOOP_INTERNAL(ns3::ParameterLogger(std::clog) << parameters)
+#define NS_LOG_FUNCTION_NOARGS_HOT()
+#define NS_LOG_DEBUG_HOT(msg) NS_LOG_HOT_NOOP_INTERNAL(std::clog << msg)
+#define NS_LOG_INFO_HOT(msg) NS_LOG_HOT_NOOP_INTERNAL(std::clog << msg)
+#define NS_LOG_LOGIC_HOT(msg) NS_LOG_HOT_NOOP_INTERNAL(std::clog << msg)
+
+#else /* NS3_FAST_FABRIC */
+
+#define NS_LOG_FUNCTION_HOT(parameters) NS_LOG_FUNCTION(parameters)
+#define NS_LOG_FUNCTION_NOARGS_HOT() NS_LOG_FUNCTION_NOARGS()
+#define NS_LOG_DEBUG_HOT(msg) NS_LOG_DEBUG(msg)
+#define NS_LOG_INFO_HOT(msg) NS_LOG_INFO(msg)
+#define NS_LOG_LOGIC_HOT(msg) NS_LOG_LOGIC(msg)
+
+#endif /* NS3_FAST_FABRIC */
+/**@}*/
+
 namespace ns3
 {
 
@@ -132,13 +132,17 @@ template <typename MEM, typename OBJ, typename... Ts>
 std::enable_if_t<std::is_member_pointer_v<MEM>, EventImpl*>
 MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
 {
+    // The method, object and arguments are stored in place rather than in a
+    // std::function, which would take a heap allocation of its own.
     class EventMemberImpl : public EventImpl
     {
       public:
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_obj(obj),
+              m_function(function),
+              m_arguments(args...)
         {
         }
 
@@ -150,10 +154,13 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
       private:
         void Notify() override
         {
-            m_function();
+            std::apply([this](auto&... args) { std::invoke(m_function, m_obj, args...); },
+                       m_arguments);
         }
 
-        std::function<void()> m_function;
+        OBJ m_obj;
+        MEM m_function;
+        std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
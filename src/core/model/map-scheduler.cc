@@ -40,18 +40,18 @@ MapScheduler::GetTypeId()
 
 MapScheduler::MapScheduler()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 }
 
 MapScheduler::~MapScheduler()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 }
 
 void
 MapScheduler::Insert(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_LOG_FUNCTION_HOT(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
     std::pair<EventMapI, bool> result;
     result = m_list.insert(std::make_pair(ev.key, ev.impl));
     NS_ASSERT(result.second);
@@ -60,42 +60,42 @@ MapScheduler::Insert(const Event& ev)
 bool
 MapScheduler::IsEmpty() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_list.empty();
 }
 
 Scheduler::Event
 MapScheduler::PeekNext() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     auto i = m_list.begin();
     NS_ASSERT(i != m_list.end());
 
     Event ev;
     ev.impl = i->second;
     ev.key = i->first;
-    NS_LOG_DEBUG(this << ": " << ev.impl << ", " << ev.key.m_ts << ", " << ev.key.m_uid);
+    NS_LOG_DEBUG_HOT(this << ": " << ev.impl << ", " << ev.key.m_ts << ", " << ev.key.m_uid);
     return ev;
 }
 
 Scheduler::Event
 MapScheduler::RemoveNext()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     auto i = m_list.begin();
     NS_ASSERT(i != m_list.end());
     Event ev;
     ev.impl = i->second;
     ev.key = i->first;
     m_list.erase(i);
-    NS_LOG_DEBUG("@" << this << ": " << ev.impl << ", " << ev.key.m_ts << ", " << ev.key.m_uid);
+    NS_LOG_DEBUG_HOT("@" << this << ": " << ev.impl << ", " << ev.key.m_ts << ", " << ev.key.m_uid);
     return ev;
 }
 
 void
 MapScheduler::Remove(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_LOG_FUNCTION_HOT(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
     auto i = m_list.find(ev.key);
     NS_ASSERT(i->second == ev.impl);
     m_list.erase(i);
@@ -41,39 +41,39 @@ PriorityQueueScheduler::GetTypeId()
 
 PriorityQueueScheduler::PriorityQueueScheduler()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 }
 
 PriorityQueueScheduler::~PriorityQueueScheduler()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 }
 
 void
 PriorityQueueScheduler::Insert(const Event& ev)
 {
-    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_LOG_FUNCTION_HOT(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
     m_queue.push(ev);
 }
 
 bool
 PriorityQueueScheduler::IsEmpty() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_queue.empty();
 }
 
 Scheduler::Event
 PriorityQueueScheduler::PeekNext() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_queue.top();
 }
 
 Scheduler::Event
 PriorityQueueScheduler::RemoveNext()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     Scheduler::Event ev = m_queue.top();
     m_queue.pop();
     return ev;
@@ -98,7 +98,7 @@ PriorityQueueScheduler::EventPriorityQueue::remove(const Scheduler::Event& ev)
 void
 PriorityQueueScheduler::Remove(const Scheduler::Event& ev)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     m_queue.remove(ev);
 }
 
@@ -68,7 +68,9 @@ RandomVariableStream::GetTypeId()
 }
 
 RandomVariableStream::RandomVariableStream()
-    : m_rng(nullptr)
+    : m_rng(nullptr),
+      m_isAntithetic(false),
+      m_stream(-1)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -114,7 +116,10 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t nextStream = RngSeedManager::GetNextStreamIndex();
         NS_ASSERT(nextStream <= ((1ULL) << 63));
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " automatic stream: " << nextStream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), nextStream, RngSeedManager::GetRun());
+        m_rng = new RngStream(RngSeedManager::GetSeed(),
+                              nextStream,
+                              RngSeedManager::GetRun(),
+                              RngSeedManager::GetGenerator());
     }
     else
     {
@@ -123,7 +128,10 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t base = ((1ULL) << 63);
         uint64_t target = base + stream;
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " configured stream: " << stream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), target, RngSeedManager::GetRun());
+        m_rng = new RngStream(RngSeedManager::GetSeed(),
+                              target,
+                              RngSeedManager::GetRun(),
+                              RngSeedManager::GetGenerator());
     }
     m_stream = stream;
 }
@@ -8,6 +8,8 @@
 #ifndef RNG_SEED_MANAGER_H
 #define RNG_SEED_MANAGER_H
 
+#include "rng-stream.h"
+
 #include <stdint.h>
 
 /**
@@ -88,6 +90,24 @@ class RngSeedManager
      */
     static uint64_t GetRun();
 
+    /**
+     * @brief Set the generator of subsequently instantiated
+     * RandomVariableStream objects.
+     *
+     * Changing the generator changes every random sequence, just as
+     * changing the seed does; the stream and run numbers keep their
+     * meaning.
+     *
+     * @param [in] generator The generator algorithm.
+     */
+    static void SetGenerator(RngStream::Generator generator);
+    /**
+     * @brief Get the current generator.
+     * @returns The generator algorithm.
+     * @see SetGenerator
+     */
+    static RngStream::Generator GetGenerator();
+
     /**
      * Get the next automatically assigned stream index.
      * @returns The next stream index.
@@ -321,6 +321,56 @@ void PowerOfTwoMatrix (int n, Matrix a1p, Matrix a2p)
 
 // clang-format on
 
+/** Namespace for Philox4x32-10 implementation details. */
+namespace Philox
+{
+
+/** First round multiplier. */
+const uint32_t M0 = 0xD2511F53;
+/** Second round multiplier. */
+const uint32_t M1 = 0xCD9E8D57;
+/** First key increment, the golden ratio. */
+const uint32_t W0 = 0x9E3779B9;
+/** Second key increment, sqrt(3) - 1. */
+const uint32_t W1 = 0xBB67AE85;
+/** Number of rounds. */
+const int ROUNDS = 10;
+
+/**
+ * Encrypt a counter with a key.
+ *
+ * @param [in] counter The counter.
+ * @param [in] key The key.
+ * @param [out] out The random block.
+ */
+void
+Block(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4])
+{
+    uint32_t c0 = counter[0];
+    uint32_t c1 = counter[1];
+    uint32_t c2 = counter[2];
+    uint32_t c3 = counter[3];
+    uint32_t k0 = key[0];
+    uint32_t k1 = key[1];
+    for (int i = 0; i < ROUNDS; ++i)
+    {
+        uint64_t p0 = static_cast<uint64_t>(M0) * c0;
+        uint64_t p1 = static_cast<uint64_t>(M1) * c2;
+        c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+        c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+        c1 = static_cast<uint32_t>(p1);
+        c3 = static_cast<uint32_t>(p0);
+        k0 += W0;
+        k1 += W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+} // namespace Philox
+
 namespace ns3
 {
 
@@ -329,6 +379,11 @@ using namespace MRG32k3a;
 double
 RngStream::RandU01()
 {
+    if (m_generator == PHILOX)
+    {
+        return PhiloxU01();
+    }
+
     int32_t k;
     double p1;
     double p2;
@@ -364,7 +419,34 @@ RngStream::RandU01()
     return u;
 }
 
-RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
+double
+RngStream::PhiloxU01()
+{
+    if (m_blockUsed == 4)
+    {
+        Philox::Block(m_counter, m_key, m_block);
+        m_blockUsed = 0;
+        // 64-bit block index
+        if (++m_counter[0] == 0)
+        {
+            ++m_counter[1];
+        }
+    }
+    // 53 bits from two words, centered so that 0 and 1 are never returned
+    uint64_t bits = (static_cast<uint64_t>(m_block[m_blockUsed]) << 32) | m_block[m_blockUsed + 1];
+    m_blockUsed += 2;
+    return ((bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+RngStream::RngStream(uint32_t seedNumber,
+                     uint64_t stream,
+                     uint64_t substream,
+                     Generator generator)
+    : m_generator(generator),
+      m_key{static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32) ^ seedNumber},
+      m_counter{0, 0, static_cast<uint32_t>(substream), static_cast<uint32_t>(substream >> 32)},
+      m_block{0, 0, 0, 0},
+      m_blockUsed(4)
 {
     if (seedNumber >= m1 || seedNumber >= m2 || seedNumber == 0)
     {
@@ -374,11 +456,19 @@ RngStream::RngStream(uint32_t seedNumber, uint64_t stream, uint64_t substream)
     {
         m_currentState[i] = seedNumber;
     }
-    AdvanceNthBy(stream, 127, m_currentState);
-    AdvanceNthBy(substream, 76, m_currentState);
+    if (m_generator == MRG32K3A)
+    {
+        AdvanceNthBy(stream, 127, m_currentState);
+        AdvanceNthBy(substream, 76, m_currentState);
+    }
 }
 
 RngStream::RngStream(const RngStream& r)
+    : m_generator(r.m_generator),
+      m_key{r.m_key[0], r.m_key[1]},
+      m_counter{r.m_counter[0], r.m_counter[1], r.m_counter[2], r.m_counter[3]},
+      m_block{r.m_block[0], r.m_block[1], r.m_block[2], r.m_block[3]},
+      m_blockUsed(r.m_blockUsed)
 {
     for (int i = 0; i < 6; ++i)
     {
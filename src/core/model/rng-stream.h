@@ -34,18 +34,36 @@ namespace ns3
  * holds a static instance of this class.  The details of this
  * class are explained in:
  * http://www.iro.umontreal.ca/~lecuyer/myftp/papers/streams00.pdf
+ *
+ * It can instead run the Philox4x32-10 counter-based generator of
+ * ["Parallel Random Numbers: As Easy as 1, 2, 3" by Salmon et al.][Salmon],
+ * selected by the RngGenerator global value.  The stream number is the
+ * Philox key, mixed with the seed, and the substream number and a block
+ * index are its counter, so streams and substreams stay independent without
+ * the jump-ahead matrices of MRG32k3a, and each value costs a few integer
+ * multiplies rather than floating-point divisions.
+ *
+ * [Salmon]: https://doi.org/10.1145/2063384.2063405 "Salmon"
  */
 class RngStream
 {
   public:
+    /** The generator algorithm. */
+    enum Generator
+    {
+        MRG32K3A, //!< Combined multiple-recursive generator, the default
+        PHILOX,   //!< Philox4x32-10 counter-based generator
+    };
+
     /**
      * Construct from explicit seed, stream and substream values.
      *
      * @param [in] seed The starting seed.
      * @param [in] stream The stream number.
      * @param [in] substream The sub-stream number.
+     * @param [in] generator The generator algorithm.
      */
-    RngStream(uint32_t seed, uint64_t stream, uint64_t substream);
+    RngStream(uint32_t seed, uint64_t stream, uint64_t substream, Generator generator = MRG32K3A);
     /**
      * Copy constructor.
      *
@@ -69,9 +87,25 @@ class RngStream
      * @param [in] state The state vector to advance.
      */
     void AdvanceNthBy(uint64_t nth, int by, double state[6]);
+    /**
+     * Generate the next random number with Philox.
+     *
+     * @returns The next random.
+     */
+    double PhiloxU01();
 
+    /** The generator algorithm. */
+    Generator m_generator;
     /** The RNG state vector. */
     double m_currentState[6];
+    /** Philox key, from the seed and stream. */
+    uint32_t m_key[2];
+    /** Philox counter: the block index, then the substream. */
+    uint32_t m_counter[4];
+    /** Philox output of the current block. */
+    uint32_t m_block[4];
+    /** Words of m_block already used. */
+    uint32_t m_blockUsed;
 };
 
 } // namespace ns3
@@ -29,4 +29,10 @@ SimulatorImpl::GetTypeId()
     return tid;
 }
 
+uint64_t
+SimulatorImpl::GetEventHighWaterMark() const
+{
+    return 0;
+}
+
 } // namespace ns3
@@ -89,6 +89,8 @@ class SimulatorImpl : public Object
     virtual uint32_t GetContext() const = 0;
     /** @copydoc Simulator::GetEventCount */
     virtual uint64_t GetEventCount() const = 0;
+    /** @copydoc Simulator::GetEventHighWaterMark */
+    virtual uint64_t GetEventHighWaterMark() const;
 
     /**
      * Hook called before processing each event.
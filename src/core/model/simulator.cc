@@ -147,6 +147,8 @@ Simulator::Destroy()
     (*pimpl)->Destroy();
     (*pimpl)->Unref();
     *pimpl = nullptr;
+    // Events still held, e.g. by an EventId, keep the chunks for the next run
+    EventImpl::ReleaseArena();
 }
 
 void
@@ -205,7 +207,7 @@ Simulator::Now()
 Time
 Simulator::GetDelayLeft(const EventId& id)
 {
-    NS_LOG_FUNCTION(&id);
+    NS_LOG_FUNCTION_HOT(&id);
     return GetImpl()->GetDelayLeft(id);
 }
 
@@ -315,6 +317,18 @@ Simulator::GetEventCount()
     return GetImpl()->GetEventCount();
 }
 
+uint64_t
+Simulator::GetEventHighWaterMark()
+{
+    return GetImpl()->GetEventHighWaterMark();
+}
+
+EventImpl::AllocationStats
+Simulator::GetEventAllocationStats()
+{
+    return EventImpl::GetAllocationStats();
+}
+
 uint32_t
 Simulator::GetSystemId()
 {
@@ -111,6 +111,8 @@ class Simulator
      * After this method has been invoked, it is actually possible
      * to restart a new simulation with a set of calls to Simulator::Run,
      * Simulator::Schedule and Simulator::ScheduleWithContext.
+     * The event arena is returned to the heap once no event is held,
+     * see EventImpl::ReleaseArena.
      */
     static void Destroy();
 
@@ -205,6 +207,20 @@ class Simulator
      */
     static uint64_t GetEventCount();
 
+    /**
+     * Get the most events that were pending in the scheduler at once.
+     * @returns The scheduler high-water mark, or 0 if the implementation
+     * does not track it.
+     */
+    static uint64_t GetEventHighWaterMark();
+
+    /**
+     * Get the counters of the event allocator of the calling thread,
+     * usually the simulation thread.
+     * @returns The event allocation counters.
+     */
+    static EventImpl::AllocationStats GetEventAllocationStats();
+
     /**
      * @name Schedule events (in the same context) to run at a future time.
      */
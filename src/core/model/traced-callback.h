@@ -19,6 +19,28 @@
  * ns3::TracedCallback declaration and template implementation.
  */
 
+/**
+ * @ingroup tracing
+ * Invoke a TracedCallback from a function run for every packet or event.
+ *
+ * Unless ns-3 is configured with NS3_FAST_FABRIC, this is the plain
+ * call; then it compiles to nothing, with its arguments neither copied
+ * nor evaluated, and the trace source never fires.
+ *
+ * @param [in] trace The TracedCallback.
+ */
+#ifdef NS3_FAST_FABRIC
+#define NS_TRACE_HOT(trace, ...)                                                                   \
+    do                                                                                             \
+        if (false)                                                                                 \
+        {                                                                                          \
+            trace(__VA_ARGS__);                                                                    \
+        }                                                                                          \
+    while (false)
+#else
+#define NS_TRACE_HOT(trace, ...) trace(__VA_ARGS__)
+#endif
+
 namespace ns3
 {
 
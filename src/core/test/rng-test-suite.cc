@@ -5,6 +5,7 @@
 #include "ns3/double.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/rng-seed-manager.h"
+#include "ns3/rng-stream.h"
 #include "ns3/test.h"
 
 #include <cmath>
@@ -63,7 +64,11 @@ class RngUniformTestCase : public TestCase
     /// Number of measurements.
     static const uint32_t N_MEASUREMENTS = 1000000;
 
-    RngUniformTestCase();
+    /**
+     * Constructor.
+     * @param generator The generator algorithm.
+     */
+    RngUniformTestCase(RngStream::Generator generator = RngStream::MRG32K3A);
     ~RngUniformTestCase() override;
 
     /**
@@ -75,10 +80,15 @@ class RngUniformTestCase : public TestCase
 
   private:
     void DoRun() override;
+
+    /// The generator algorithm.
+    RngStream::Generator m_generator;
 };
 
-RngUniformTestCase::RngUniformTestCase()
-    : TestCase("Uniform Random Number Generator")
+RngUniformTestCase::RngUniformTestCase(RngStream::Generator generator)
+    : TestCase(generator == RngStream::PHILOX ? "Uniform Random Number Generator, Philox"
+                                              : "Uniform Random Number Generator"),
+      m_generator(generator)
 {
 }
 
@@ -125,6 +135,7 @@ void
 RngUniformTestCase::DoRun()
 {
     RngSeedManager::SetSeed(static_cast<uint32_t>(time(nullptr)));
+    RngSeedManager::SetGenerator(m_generator);
 
     double sum = 0.;
     double maxStatistic = gsl_cdf_chisq_Qinv(0.05, N_BINS);
@@ -137,6 +148,7 @@ RngUniformTestCase::DoRun()
     }
 
     sum /= (double)N_RUNS;
+    RngSeedManager::SetGenerator(RngStream::MRG32K3A);
 
     NS_TEST_ASSERT_MSG_LT(sum, maxStatistic, "Chi-squared statistic out of range");
 }
@@ -465,6 +477,70 @@ RngParetoTestCase::DoRun()
     NS_TEST_ASSERT_MSG_LT(sum, maxStatistic, "Chi-squared statistic out of range");
 }
 
+/**
+ * @ingroup rng-tests
+ *
+ * Test case for the Philox counter-based generator: known answers,
+ * reproducibility and independence of streams and substreams.
+ */
+class RngPhiloxTestCase : public TestCase
+{
+  public:
+    RngPhiloxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+RngPhiloxTestCase::RngPhiloxTestCase()
+    : TestCase("Philox counter-based generator")
+{
+}
+
+void
+RngPhiloxTestCase::DoRun()
+{
+    // Seed 1 and stream 1 << 32 give a zero key; the first block is the
+    // Philox4x32-10 known answer for a zero counter and key
+    RngStream zero(1, 1ULL << 32, 0, RngStream::PHILOX);
+    NS_TEST_ASSERT_MSG_EQ(zero.RandU01(),
+                          ((0x6627e8d5e169c58dULL >> 11) + 0.5) / 9007199254740992.0,
+                          "First value differs from the Philox4x32-10 known answer");
+    NS_TEST_ASSERT_MSG_EQ(zero.RandU01(),
+                          ((0xbc57ac4c9b00dbd8ULL >> 11) + 0.5) / 9007199254740992.0,
+                          "Second value differs from the Philox4x32-10 known answer");
+
+    const uint32_t n = 10000;
+    RngStream a(3, 7, 1, RngStream::PHILOX);
+    RngStream same(3, 7, 1, RngStream::PHILOX);
+    RngStream otherStream(3, 8, 1, RngStream::PHILOX);
+    RngStream otherRun(3, 7, 2, RngStream::PHILOX);
+    RngStream otherSeed(4, 7, 1, RngStream::PHILOX);
+    double sum = 0;
+    uint32_t equalStream = 0;
+    uint32_t equalRun = 0;
+    uint32_t equalSeed = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        double u = a.RandU01();
+        NS_TEST_ASSERT_MSG_EQ(u, same.RandU01(), "Same seed, stream and run must repeat");
+        NS_TEST_ASSERT_MSG_GT(u, 0.0, "Value out of (0, 1)");
+        NS_TEST_ASSERT_MSG_LT(u, 1.0, "Value out of (0, 1)");
+        equalStream += u == otherStream.RandU01();
+        equalRun += u == otherRun.RandU01();
+        equalSeed += u == otherSeed.RandU01();
+        sum += u;
+    }
+    NS_TEST_ASSERT_MSG_EQ(equalStream, 0, "Streams must differ");
+    NS_TEST_ASSERT_MSG_EQ(equalRun, 0, "Substreams must differ");
+    NS_TEST_ASSERT_MSG_EQ(equalSeed, 0, "Seeds must differ");
+    NS_TEST_ASSERT_MSG_EQ_TOL(sum / n, 0.5, 0.01, "Mean of uniform values out of range");
+
+    // Copies continue the same sequence
+    RngStream copy(a);
+    NS_TEST_ASSERT_MSG_EQ(copy.RandU01(), a.RandU01(), "Copy must continue the sequence");
+}
+
 /**
  * @ingroup rng-tests
  *
@@ -480,6 +556,8 @@ RngTestSuite::RngTestSuite()
     : TestSuite("random-number-generators", Type::UNIT)
 {
     AddTestCase(new RngUniformTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new RngUniformTestCase(RngStream::PHILOX), TestCase::Duration::QUICK);
+    AddTestCase(new RngPhiloxTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RngNormalTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RngExponentialTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RngParetoTestCase, TestCase::Duration::QUICK);
@@ -7,6 +7,7 @@
  */
 #include "ns3/calendar-scheduler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
@@ -640,6 +641,79 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that freed events are recycled by the event arena.
+ */
+class SimulatorEventArenaTestCase : public TestCase
+{
+  public:
+    SimulatorEventArenaTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Reschedule itself until the count is exhausted.
+     * @param count Events left to schedule.
+     * @param value Argument to keep the event size of a typical member event.
+     */
+    void Tick(uint32_t count, uint64_t value);
+};
+
+SimulatorEventArenaTestCase::SimulatorEventArenaTestCase()
+    : TestCase("Event arena")
+{
+}
+
+void
+SimulatorEventArenaTestCase::Tick(uint32_t count, uint64_t value)
+{
+    if (count > 0)
+    {
+        Simulator::Schedule(NanoSeconds(1), &SimulatorEventArenaTestCase::Tick, this, count - 1, value);
+    }
+}
+
+void
+SimulatorEventArenaTestCase::DoRun()
+{
+    Simulator::Schedule(NanoSeconds(1), &SimulatorEventArenaTestCase::Tick, this, 1000, 0);
+    Simulator::Run();
+    EventImpl::AllocationStats before = Simulator::GetEventAllocationStats();
+
+    Simulator::Schedule(NanoSeconds(1), &SimulatorEventArenaTestCase::Tick, this, 10000, 0);
+    Simulator::Run();
+    EventImpl::AllocationStats after = Simulator::GetEventAllocationStats();
+    Simulator::Destroy();
+
+    // The next run carves a new chunk, which an event held past Destroy keeps
+    Simulator::Schedule(NanoSeconds(1), &SimulatorEventArenaTestCase::Tick, this, 10, 0);
+    EventId held =
+        Simulator::Schedule(NanoSeconds(1), &SimulatorEventArenaTestCase::Tick, this, 0, 0);
+    Simulator::Run();
+    EventImpl::AllocationStats next = Simulator::GetEventAllocationStats();
+    Simulator::Destroy();
+    Simulator::Schedule(NanoSeconds(1), &SimulatorEventArenaTestCase::Tick, this, 10, 0);
+    Simulator::Run();
+    EventImpl::AllocationStats kept = Simulator::GetEventAllocationStats();
+    held = EventId();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(after.allocations - before.allocations,
+                          10001,
+                          "Every event should be allocated");
+    NS_TEST_EXPECT_MSG_EQ(after.reused - before.reused,
+                          10001,
+                          "Every event should come from a free list");
+    NS_TEST_EXPECT_MSG_EQ(after.chunks, before.chunks, "No arena chunk should be added");
+    NS_TEST_EXPECT_MSG_EQ(next.chunks,
+                          after.chunks + 1,
+                          "Destroy should return the chunks to the heap");
+    NS_TEST_EXPECT_MSG_EQ(kept.chunks, next.chunks, "A held event should keep the chunks");
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -651,6 +725,9 @@ class SimulatorTestSuite : public TestSuite
     SimulatorTestSuite()
         : TestSuite("simulator")
     {
+        // First, as the events test cases hold events past their Destroy
+        AddTestCase(new SimulatorEventArenaTestCase(), TestCase::Duration::QUICK);
+
         ObjectFactory factory;
         factory.SetTypeId(ListScheduler::GetTypeId());
 
@@ -663,6 +740,8 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
     }
 };
 
@@ -122,6 +122,45 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * @ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check that NS_TRACE_HOT fires the trace
+ * unless built with NS3_FAST_FABRIC, and then leaves its arguments alone.
+ */
+class HotTracedCallbackTestCase : public TestCase
+{
+  public:
+    HotTracedCallbackTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+HotTracedCallbackTestCase::HotTracedCallbackTestCase()
+    : TestCase("Check NS_TRACE_HOT")
+{
+}
+
+void
+HotTracedCallbackTestCase::DoRun()
+{
+    uint32_t calls = 0;
+    uint32_t evaluated = 0;
+    TracedCallback<uint32_t> trace;
+    trace.ConnectWithoutContext(Callback<void, uint32_t>([&calls](uint32_t) { calls++; }));
+
+    NS_TRACE_HOT(trace, ++evaluated);
+
+#ifdef NS3_FAST_FABRIC
+    NS_TEST_ASSERT_MSG_EQ(calls, 0, "Trace fired in a NS3_FAST_FABRIC build");
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 0, "Trace arguments evaluated in a NS3_FAST_FABRIC build");
+#else
+    NS_TEST_ASSERT_MSG_EQ(calls, 1, "Trace not fired");
+    NS_TEST_ASSERT_MSG_EQ(evaluated, 1, "Trace arguments not evaluated once");
+#endif
+}
+
 /**
  * @ingroup tracedcallback-tests
  *
@@ -137,6 +176,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new HotTracedCallbackTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
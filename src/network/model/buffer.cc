@@ -11,11 +11,11 @@
 #include "ns3/log.h"
 
 #define LOG_INTERNAL_STATE(y)                                                                      \
-    NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
-                   << ", zero start=" << m_zeroAreaStart << ", zero end=" << m_zeroAreaEnd         \
-                   << ", count=" << m_data->m_count << ", size=" << m_data->m_size                 \
-                   << ", dirty start=" << m_data->m_dirtyStart                                     \
-                   << ", dirty end=" << m_data->m_dirtyEnd)
+    NS_LOG_LOGIC_HOT(y << "start=" << m_start << ", end=" << m_end                                 \
+                       << ", zero start=" << m_zeroAreaStart << ", zero end=" << m_zeroAreaEnd     \
+                       << ", count=" << m_data->m_count << ", size=" << m_data->m_size             \
+                       << ", dirty start=" << m_data->m_dirtyStart                                 \
+                       << ", dirty end=" << m_data->m_dirtyEnd)
 
 namespace
 {
@@ -74,7 +74,7 @@ Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     if (IS_INITIALIZED(g_freeList))
     {
         for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
@@ -89,7 +89,7 @@ Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 void
 Buffer::Recycle(Buffer::Data* data)
 {
-    NS_LOG_FUNCTION(data);
+    NS_LOG_FUNCTION_HOT(data);
     NS_ASSERT(data->m_count == 0);
     NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
     g_maxSize = std::max(g_maxSize, data->m_size);
@@ -108,7 +108,7 @@ Buffer::Recycle(Buffer::Data* data)
 Buffer::Data*
 Buffer::Create(uint32_t dataSize)
 {
-    NS_LOG_FUNCTION(dataSize);
+    NS_LOG_FUNCTION_HOT(dataSize);
     /* try to find a buffer correctly sized. */
     if (IS_UNINITIALIZED(g_freeList))
     {
@@ -136,7 +136,7 @@ Buffer::Create(uint32_t dataSize)
 void
 Buffer::Recycle(Buffer::Data* data)
 {
-    NS_LOG_FUNCTION(data);
+    NS_LOG_FUNCTION_HOT(data);
     NS_ASSERT(data->m_count == 0);
     Deallocate(data);
 }
@@ -144,7 +144,7 @@ Buffer::Recycle(Buffer::Data* data)
 Buffer::Data*
 Buffer::Create(uint32_t size)
 {
-    NS_LOG_FUNCTION(size);
+    NS_LOG_FUNCTION_HOT(size);
     return Allocate(size);
 }
 #endif /* BUFFER_FREE_LIST */
@@ -154,7 +154,7 @@ constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-pro
 Buffer::Data*
 Buffer::Allocate(uint32_t reqSize)
 {
-    NS_LOG_FUNCTION(reqSize);
+    NS_LOG_FUNCTION_HOT(reqSize);
     if (reqSize == 0)
     {
         reqSize = 1;
@@ -172,7 +172,7 @@ Buffer::Allocate(uint32_t reqSize)
 void
 Buffer::Deallocate(Buffer::Data* data)
 {
-    NS_LOG_FUNCTION(data);
+    NS_LOG_FUNCTION_HOT(data);
     NS_ASSERT(data->m_count == 0);
     auto buf = reinterpret_cast<uint8_t*>(data);
     delete[] buf;
@@ -180,19 +180,19 @@ Buffer::Deallocate(Buffer::Data* data)
 
 Buffer::Buffer()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     Initialize(0);
 }
 
 Buffer::Buffer(uint32_t dataSize)
 {
-    NS_LOG_FUNCTION(this << dataSize);
+    NS_LOG_FUNCTION_HOT(this << dataSize);
     Initialize(dataSize);
 }
 
 Buffer::Buffer(uint32_t dataSize, bool initialize)
 {
-    NS_LOG_FUNCTION(this << dataSize << initialize);
+    NS_LOG_FUNCTION_HOT(this << dataSize << initialize);
     if (initialize)
     {
         Initialize(dataSize);
@@ -202,7 +202,7 @@ Buffer::Buffer(uint32_t dataSize, bool initialize)
 bool
 Buffer::CheckInternalState() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 #if 0
   // If you want to modify any code in this file, enable this checking code.
   // Otherwise, there is not much point is enabling it because the
@@ -236,7 +236,7 @@ Buffer::CheckInternalState() const
 void
 Buffer::Initialize(uint32_t zeroSize)
 {
-    NS_LOG_FUNCTION(this << zeroSize);
+    NS_LOG_FUNCTION_HOT(this << zeroSize);
     m_data = Buffer::Create(0);
     m_start = std::min(m_data->m_size, g_recommendedStart);
     m_maxZeroAreaStart = m_start;
@@ -275,7 +275,7 @@ Buffer::operator=(const Buffer& o)
 
 Buffer::~Buffer()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
     m_data->m_count--;
@@ -288,21 +288,43 @@ Buffer::~Buffer()
 uint32_t
 Buffer::GetInternalSize() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_zeroAreaStart - m_start + m_end - m_zeroAreaEnd;
 }
 
 uint32_t
 Buffer::GetInternalEnd() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_end - (m_zeroAreaEnd - m_zeroAreaStart);
 }
 
+void
+Buffer::MakeWritable()
+{
+    NS_LOG_FUNCTION_HOT(this);
+    NS_ASSERT(CheckInternalState());
+    if (m_data->m_count == 1)
+    {
+        return;
+    }
+    /* Copy the bytes at the same internal offsets, so that the zero area
+     * and the start and end offsets still hold.
+     */
+    Buffer::Data* newData = Buffer::Create(m_start + GetInternalSize());
+    memcpy(newData->m_data + m_start, m_data->m_data + m_start, GetInternalSize());
+    m_data->m_count--;
+    m_data = newData;
+    m_data->m_dirtyStart = m_start;
+    m_data->m_dirtyEnd = m_end;
+    LOG_INTERNAL_STATE("writable ");
+    NS_ASSERT(CheckInternalState());
+}
+
 void
 Buffer::AddAtStart(uint32_t start)
 {
-    NS_LOG_FUNCTION(this << start);
+    NS_LOG_FUNCTION_HOT(this << start);
     NS_ASSERT(CheckInternalState());
     bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
     if (m_start >= start && !isDirty)
@@ -348,7 +370,7 @@ Buffer::AddAtStart(uint32_t start)
 void
 Buffer::AddAtEnd(uint32_t end)
 {
-    NS_LOG_FUNCTION(this << end);
+    NS_LOG_FUNCTION_HOT(this << end);
     NS_ASSERT(CheckInternalState());
     bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
@@ -394,7 +416,7 @@ Buffer::AddAtEnd(uint32_t end)
 void
 Buffer::AddAtEnd(const Buffer& o)
 {
-    NS_LOG_FUNCTION(this << &o);
+    NS_LOG_FUNCTION_HOT(this << &o);
 
     if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
         m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
@@ -435,7 +457,7 @@ Buffer::AddAtEnd(const Buffer& o)
 void
 Buffer::RemoveAtStart(uint32_t start)
 {
-    NS_LOG_FUNCTION(this << start);
+    NS_LOG_FUNCTION_HOT(this << start);
     NS_ASSERT(CheckInternalState());
     uint32_t newStart = m_start + start;
     if (newStart <= m_zeroAreaStart)
@@ -481,7 +503,7 @@ Buffer::RemoveAtStart(uint32_t start)
 void
 Buffer::RemoveAtEnd(uint32_t end)
 {
-    NS_LOG_FUNCTION(this << end);
+    NS_LOG_FUNCTION_HOT(this << end);
     NS_ASSERT(CheckInternalState());
     uint32_t newEnd = m_end - std::min(end, m_end - m_start);
     if (newEnd > m_zeroAreaEnd)
@@ -517,7 +539,7 @@ Buffer::RemoveAtEnd(uint32_t end)
 Buffer
 Buffer::CreateFragment(uint32_t start, uint32_t length) const
 {
-    NS_LOG_FUNCTION(this << start << length);
+    NS_LOG_FUNCTION_HOT(this << start << length);
     NS_ASSERT(CheckInternalState());
     Buffer tmp = *this;
     tmp.RemoveAtStart(start);
@@ -529,7 +551,7 @@ Buffer::CreateFragment(uint32_t start, uint32_t length) const
 Buffer
 Buffer::CreateFullCopy() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     NS_ASSERT(CheckInternalState());
     if (m_zeroAreaEnd - m_zeroAreaStart != 0)
     {
@@ -554,7 +576,7 @@ Buffer::CreateFullCopy() const
 uint32_t
 Buffer::GetSerializedSize() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint32_t dataStart = (m_zeroAreaStart - m_start + 3) & (~0x3);
     uint32_t dataEnd = (m_end - m_zeroAreaEnd + 3) & (~0x3);
 
@@ -570,7 +592,7 @@ Buffer::GetSerializedSize() const
 uint32_t
 Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
-    NS_LOG_FUNCTION(this << &buffer << maxSize);
+    NS_LOG_FUNCTION_HOT(this << &buffer << maxSize);
     auto p = reinterpret_cast<uint32_t*>(buffer);
     uint32_t size = 0;
 
@@ -636,7 +658,7 @@ Buffer::Serialize(uint8_t* buffer, uint32_t maxSize) const
 uint32_t
 Buffer::Deserialize(const uint8_t* buffer, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << &buffer << size);
+    NS_LOG_FUNCTION_HOT(this << &buffer << size);
     auto p = reinterpret_cast<const uint32_t*>(buffer);
     uint32_t sizeCheck = size - 4;
 
@@ -681,7 +703,7 @@ Buffer::Deserialize(const uint8_t* buffer, uint32_t size)
 void
 Buffer::TransformIntoRealBuffer() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     NS_ASSERT(CheckInternalState());
     Buffer tmp = CreateFullCopy();
     *const_cast<Buffer*>(this) = tmp;
@@ -691,7 +713,7 @@ Buffer::TransformIntoRealBuffer() const
 const uint8_t*
 Buffer::PeekData() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     NS_ASSERT(CheckInternalState());
     TransformIntoRealBuffer();
     NS_ASSERT(CheckInternalState());
@@ -701,7 +723,7 @@ Buffer::PeekData() const
 void
 Buffer::CopyData(std::ostream* os, uint32_t size) const
 {
-    NS_LOG_FUNCTION(this << &os << size);
+    NS_LOG_FUNCTION_HOT(this << &os << size);
     if (size > 0)
     {
         uint32_t tmpsize = std::min(m_zeroAreaStart - m_start, size);
@@ -730,7 +752,7 @@ Buffer::CopyData(std::ostream* os, uint32_t size) const
 uint32_t
 Buffer::CopyData(uint8_t* buffer, uint32_t size) const
 {
-    NS_LOG_FUNCTION(this << &buffer << size);
+    NS_LOG_FUNCTION_HOT(this << &buffer << size);
     uint32_t originalSize = size;
     if (size > 0)
     {
@@ -768,7 +790,7 @@ Buffer::CopyData(uint8_t* buffer, uint32_t size) const
 uint32_t
 Buffer::Iterator::GetDistanceFrom(const Iterator& o) const
 {
-    NS_LOG_FUNCTION(this << &o);
+    NS_LOG_FUNCTION_HOT(this << &o);
     NS_ASSERT(m_data == o.m_data);
     int32_t diff = m_current - o.m_current;
     if (diff < 0)
@@ -784,21 +806,21 @@ Buffer::Iterator::GetDistanceFrom(const Iterator& o) const
 bool
 Buffer::Iterator::IsEnd() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_current == m_dataEnd;
 }
 
 bool
 Buffer::Iterator::IsStart() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_current == m_dataStart;
 }
 
 bool
 Buffer::Iterator::CheckNoZero(uint32_t start, uint32_t end) const
 {
-    NS_LOG_FUNCTION(this << &start << &end);
+    NS_LOG_FUNCTION_HOT(this << &start << &end);
     return !(start < m_dataStart || end > m_dataEnd ||
              (end > m_zeroStart && start < m_zeroEnd && m_zeroEnd != m_zeroStart && start != end));
 }
@@ -806,14 +828,14 @@ Buffer::Iterator::CheckNoZero(uint32_t start, uint32_t end) const
 bool
 Buffer::Iterator::Check(uint32_t i) const
 {
-    NS_LOG_FUNCTION(this << &i);
+    NS_LOG_FUNCTION_HOT(this << &i);
     return i >= m_dataStart && !(i >= m_zeroStart && i < m_zeroEnd) && i <= m_dataEnd;
 }
 
 void
 Buffer::Iterator::Write(Iterator start, Iterator end)
 {
-    NS_LOG_FUNCTION(this << &start << &end);
+    NS_LOG_FUNCTION_HOT(this << &start << &end);
     NS_ASSERT(start.m_data == end.m_data);
     NS_ASSERT(start.m_current <= end.m_current);
     NS_ASSERT(start.m_zeroStart == end.m_zeroStart);
@@ -847,7 +869,7 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
 void
 Buffer::Iterator::WriteU16(uint16_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8(data & 0xff);
     data >>= 8;
     WriteU8(data & 0xff);
@@ -856,7 +878,7 @@ Buffer::Iterator::WriteU16(uint16_t data)
 void
 Buffer::Iterator::WriteU32(uint32_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8(data & 0xff);
     data >>= 8;
     WriteU8(data & 0xff);
@@ -869,7 +891,7 @@ Buffer::Iterator::WriteU32(uint32_t data)
 void
 Buffer::Iterator::WriteU64(uint64_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8(data & 0xff);
     data >>= 8;
     WriteU8(data & 0xff);
@@ -890,7 +912,7 @@ Buffer::Iterator::WriteU64(uint64_t data)
 void
 Buffer::Iterator::WriteHtolsbU16(uint16_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8((data >> 0) & 0xff);
     WriteU8((data >> 8) & 0xff);
 }
@@ -898,7 +920,7 @@ Buffer::Iterator::WriteHtolsbU16(uint16_t data)
 void
 Buffer::Iterator::WriteHtolsbU32(uint32_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8((data >> 0) & 0xff);
     WriteU8((data >> 8) & 0xff);
     WriteU8((data >> 16) & 0xff);
@@ -908,7 +930,7 @@ Buffer::Iterator::WriteHtolsbU32(uint32_t data)
 void
 Buffer::Iterator::WriteHtolsbU64(uint64_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8((data >> 0) & 0xff);
     WriteU8((data >> 8) & 0xff);
     WriteU8((data >> 16) & 0xff);
@@ -922,7 +944,7 @@ Buffer::Iterator::WriteHtolsbU64(uint64_t data)
 void
 Buffer::Iterator::WriteHtonU64(uint64_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8((data >> 56) & 0xff);
     WriteU8((data >> 48) & 0xff);
     WriteU8((data >> 40) & 0xff);
@@ -936,7 +958,7 @@ Buffer::Iterator::WriteHtonU64(uint64_t data)
 void
 Buffer::Iterator::Write(const uint8_t* buffer, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << &buffer << size);
+    NS_LOG_FUNCTION_HOT(this << &buffer << size);
     NS_ASSERT_MSG(CheckNoZero(m_current, size), GetWriteErrorMessage());
     uint8_t* to;
     if (m_current <= m_zeroStart)
@@ -954,7 +976,7 @@ Buffer::Iterator::Write(const uint8_t* buffer, uint32_t size)
 uint32_t
 Buffer::Iterator::ReadU32()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint8_t byte0 = ReadU8();
     uint8_t byte1 = ReadU8();
     uint8_t byte2 = ReadU8();
@@ -972,7 +994,7 @@ Buffer::Iterator::ReadU32()
 uint64_t
 Buffer::Iterator::ReadU64()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint8_t byte0 = ReadU8();
     uint8_t byte1 = ReadU8();
     uint8_t byte2 = ReadU8();
@@ -1003,7 +1025,7 @@ Buffer::Iterator::ReadU64()
 uint16_t
 Buffer::Iterator::SlowReadNtohU16()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint16_t retval = 0;
     retval |= ReadU8();
     retval <<= 8;
@@ -1014,7 +1036,7 @@ Buffer::Iterator::SlowReadNtohU16()
 uint32_t
 Buffer::Iterator::SlowReadNtohU32()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint32_t retval = 0;
     retval |= ReadU8();
     retval <<= 8;
@@ -1029,7 +1051,7 @@ Buffer::Iterator::SlowReadNtohU32()
 uint64_t
 Buffer::Iterator::ReadNtohU64()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint64_t retval = 0;
     retval |= ReadU8();
     retval <<= 8;
@@ -1052,7 +1074,7 @@ Buffer::Iterator::ReadNtohU64()
 uint16_t
 Buffer::Iterator::ReadLsbtohU16()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint8_t byte0 = ReadU8();
     uint8_t byte1 = ReadU8();
     uint16_t data = byte1;
@@ -1064,7 +1086,7 @@ Buffer::Iterator::ReadLsbtohU16()
 uint32_t
 Buffer::Iterator::ReadLsbtohU32()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint8_t byte0 = ReadU8();
     uint8_t byte1 = ReadU8();
     uint8_t byte2 = ReadU8();
@@ -1082,7 +1104,7 @@ Buffer::Iterator::ReadLsbtohU32()
 uint64_t
 Buffer::Iterator::ReadLsbtohU64()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint8_t byte0 = ReadU8();
     uint8_t byte1 = ReadU8();
     uint8_t byte2 = ReadU8();
@@ -1113,7 +1135,7 @@ Buffer::Iterator::ReadLsbtohU64()
 void
 Buffer::Iterator::Read(uint8_t* buffer, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << &buffer << size);
+    NS_LOG_FUNCTION_HOT(this << &buffer << size);
     for (uint32_t i = 0; i < size; i++)
     {
         buffer[i] = ReadU8();
@@ -1123,14 +1145,14 @@ Buffer::Iterator::Read(uint8_t* buffer, uint32_t size)
 uint16_t
 Buffer::Iterator::CalculateIpChecksum(uint16_t size)
 {
-    NS_LOG_FUNCTION(this << size);
+    NS_LOG_FUNCTION_HOT(this << size);
     return CalculateIpChecksum(size, 0);
 }
 
 uint16_t
 Buffer::Iterator::CalculateIpChecksum(uint16_t size, uint32_t initialChecksum)
 {
-    NS_LOG_FUNCTION(this << size << initialChecksum);
+    NS_LOG_FUNCTION_HOT(this << size << initialChecksum);
     /* see RFC 1071 to understand this code. */
     uint32_t sum = initialChecksum;
 
@@ -1154,21 +1176,21 @@ Buffer::Iterator::CalculateIpChecksum(uint16_t size, uint32_t initialChecksum)
 uint32_t
 Buffer::Iterator::GetSize() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_dataEnd - m_dataStart;
 }
 
 uint32_t
 Buffer::Iterator::GetRemainingSize() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_dataEnd - m_current;
 }
 
 std::string
 Buffer::Iterator::GetReadErrorMessage() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     std::string str = "You have attempted to read beyond the bounds of the "
                       "available buffer space. This usually indicates that a "
                       "Header::Deserialize or Trailer::Deserialize method "
@@ -1182,7 +1204,7 @@ Buffer::Iterator::GetReadErrorMessage() const
 std::string
 Buffer::Iterator::GetWriteErrorMessage() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     std::string str;
     if (m_current < m_dataStart)
     {
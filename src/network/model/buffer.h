@@ -556,6 +556,15 @@ class Buffer
      */
     inline Buffer::Iterator End() const;
 
+    /**
+     * Give this Buffer its own copy of its bytes if other Buffers share
+     * them, so that bytes already in the Buffer can be overwritten in place
+     * through Begin().
+     * Any call to this method invalidates any Iterator
+     * pointing to this Buffer.
+     */
+    void MakeWritable();
+
     /**
      * @brief Return the number of bytes required for serialization.
      * @return the number of bytes.
@@ -55,7 +55,7 @@ static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     for (auto i = begin(); i != end(); i++)
     {
         auto buffer = (uint8_t*)(*i);
@@ -67,13 +67,13 @@ ByteTagListDataFreeList::~ByteTagListDataFreeList()
 ByteTagList::Iterator::Item::Item(TagBuffer buf_)
     : buf(buf_)
 {
-    NS_LOG_FUNCTION(this << &buf_);
+    NS_LOG_FUNCTION_HOT(this << &buf_);
 }
 
 bool
 ByteTagList::Iterator::HasNext() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_current < m_end;
 }
 
@@ -95,7 +95,7 @@ ByteTagList::Iterator::Next()
 void
 ByteTagList::Iterator::PrepareForNext()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     while (m_current < m_end)
     {
         TagBuffer buf = TagBuffer(m_current, m_end);
@@ -125,14 +125,14 @@ ByteTagList::Iterator::Iterator(uint8_t* start,
       m_offsetEnd(offsetEnd),
       m_adjustment(adjustment)
 {
-    NS_LOG_FUNCTION(this << &start << &end << offsetStart << offsetEnd << adjustment);
+    NS_LOG_FUNCTION_HOT(this << &start << &end << offsetStart << offsetEnd << adjustment);
     PrepareForNext();
 }
 
 uint32_t
 ByteTagList::Iterator::GetOffsetStart() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_offsetStart;
 }
 
@@ -143,7 +143,7 @@ ByteTagList::ByteTagList()
       m_used(0),
       m_data(nullptr)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 }
 
 ByteTagList::ByteTagList(const ByteTagList& o)
@@ -153,7 +153,7 @@ ByteTagList::ByteTagList(const ByteTagList& o)
       m_used(o.m_used),
       m_data(o.m_data)
 {
-    NS_LOG_FUNCTION(this << &o);
+    NS_LOG_FUNCTION_HOT(this << &o);
     if (m_data != nullptr)
     {
         m_data->count++;
@@ -183,7 +183,7 @@ ByteTagList::operator=(const ByteTagList& o)
 
 ByteTagList::~ByteTagList()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     Deallocate(m_data);
     m_data = nullptr;
     m_used = 0;
@@ -192,7 +192,7 @@ ByteTagList::~ByteTagList()
 TagBuffer
 ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
 {
-    NS_LOG_FUNCTION(this << tid << bufferSize << start << end);
+    NS_LOG_FUNCTION_HOT(this << tid << bufferSize << start << end);
     uint32_t spaceNeeded = m_used + bufferSize + 4 + 4 + 4 + 4;
     NS_ASSERT(m_used <= spaceNeeded);
     if (m_data == nullptr)
@@ -228,7 +228,7 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
 void
 ByteTagList::Add(const ByteTagList& o)
 {
-    NS_LOG_FUNCTION(this << &o);
+    NS_LOG_FUNCTION_HOT(this << &o);
     ByteTagList::Iterator i = o.BeginAll();
     while (i.HasNext())
     {
@@ -241,7 +241,7 @@ ByteTagList::Add(const ByteTagList& o)
 void
 ByteTagList::RemoveAll()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     Deallocate(m_data);
     m_minStart = INT32_MAX;
     m_maxEnd = INT32_MIN;
@@ -253,7 +253,7 @@ ByteTagList::RemoveAll()
 ByteTagList::Iterator
 ByteTagList::BeginAll() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     // I am not totally sure but I might need to use
     // INT32_MIN instead of zero below.
     return Begin(0, OFFSET_MAX);
@@ -262,7 +262,7 @@ ByteTagList::BeginAll() const
 ByteTagList::Iterator
 ByteTagList::Begin(int32_t offsetStart, int32_t offsetEnd) const
 {
-    NS_LOG_FUNCTION(this << offsetStart << offsetEnd);
+    NS_LOG_FUNCTION_HOT(this << offsetStart << offsetEnd);
     if (m_data == nullptr)
     {
         return Iterator(nullptr, nullptr, offsetStart, offsetEnd, 0);
@@ -276,7 +276,7 @@ ByteTagList::Begin(int32_t offsetStart, int32_t offsetEnd) const
 void
 ByteTagList::AddAtEnd(int32_t appendOffset)
 {
-    NS_LOG_FUNCTION(this << appendOffset);
+    NS_LOG_FUNCTION_HOT(this << appendOffset);
     if (m_maxEnd <= appendOffset - m_adjustment)
     {
         return;
@@ -308,7 +308,7 @@ ByteTagList::AddAtEnd(int32_t appendOffset)
 void
 ByteTagList::AddAtStart(int32_t prependOffset)
 {
-    NS_LOG_FUNCTION(this << prependOffset);
+    NS_LOG_FUNCTION_HOT(this << prependOffset);
     if (m_minStart >= prependOffset - m_adjustment)
     {
         return;
@@ -343,7 +343,7 @@ ByteTagList::AddAtStart(int32_t prependOffset)
 ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
-    NS_LOG_FUNCTION(this << size);
+    NS_LOG_FUNCTION_HOT(this << size);
     while (!g_freeList.empty())
     {
         ByteTagListData* data = g_freeList.back();
@@ -369,7 +369,7 @@ ByteTagList::Allocate(uint32_t size)
 void
 ByteTagList::Deallocate(ByteTagListData* data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     if (data == nullptr)
     {
         return;
@@ -395,7 +395,7 @@ ByteTagList::Deallocate(ByteTagListData* data)
 ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
-    NS_LOG_FUNCTION(this << size);
+    NS_LOG_FUNCTION_HOT(this << size);
     uint8_t* buffer = new uint8_t[size + sizeof(ByteTagListData) - 4];
     ByteTagListData* data = (ByteTagListData*)buffer;
     data->count = 1;
@@ -407,7 +407,7 @@ ByteTagList::Allocate(uint32_t size)
 void
 ByteTagList::Deallocate(ByteTagListData* data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     if (data == 0)
     {
         return;
@@ -425,7 +425,7 @@ ByteTagList::Deallocate(ByteTagListData* data)
 uint32_t
 ByteTagList::GetSerializedSize() const
 {
-    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_FUNCTION_NOARGS_HOT();
 
     uint32_t size = 0;
 
@@ -454,7 +454,7 @@ ByteTagList::GetSerializedSize() const
 uint32_t
 ByteTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 {
-    NS_LOG_FUNCTION(this << buffer << maxSize);
+    NS_LOG_FUNCTION_HOT(this << buffer << maxSize);
 
     uint32_t* p = buffer;
     uint32_t size = 0;
@@ -474,7 +474,7 @@ ByteTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     {
         ByteTagList::Iterator::Item item = i.Next();
 
-        NS_LOG_INFO("Serializing " << item.tid);
+        NS_LOG_INFO_HOT("Serializing " << item.tid);
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
         uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
@@ -538,7 +538,7 @@ ByteTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 uint32_t
 ByteTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << buffer << size);
+    NS_LOG_FUNCTION_HOT(this << buffer << size);
     const uint32_t* p = buffer;
     uint32_t sizeCheck = size - 4;
 
@@ -546,7 +546,7 @@ ByteTagList::Deserialize(const uint32_t* buffer, uint32_t size)
     uint32_t numberTagData = *p++;
     sizeCheck -= 4;
 
-    NS_LOG_INFO("Deserializing number of tags " << numberTagData);
+    NS_LOG_INFO_HOT("Deserializing number of tags " << numberTagData);
 
     for (uint32_t i = 0; i < numberTagData; ++i)
     {
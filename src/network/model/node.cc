@@ -279,7 +279,7 @@ Node::PromiscReceiveFromDevice(Ptr<NetDevice> device,
                                const Address& to,
                                NetDevice::PacketType packetType)
 {
-    NS_LOG_FUNCTION(this << device << packet << protocol << &from << &to << packetType);
+    NS_LOG_FUNCTION_HOT(this << device << packet << protocol << &from << &to << packetType);
     return ReceiveFromDevice(device, packet, protocol, from, to, packetType, true);
 }
 
@@ -289,7 +289,7 @@ Node::NonPromiscReceiveFromDevice(Ptr<NetDevice> device,
                                   uint16_t protocol,
                                   const Address& from)
 {
-    NS_LOG_FUNCTION(this << device << packet << protocol << &from);
+    NS_LOG_FUNCTION_HOT(this << device << packet << protocol << &from);
     return ReceiveFromDevice(device,
                              packet,
                              protocol,
@@ -308,8 +308,8 @@ Node::ReceiveFromDevice(Ptr<NetDevice> device,
                         NetDevice::PacketType packetType,
                         bool promiscuous)
 {
-    NS_LOG_FUNCTION(this << device << packet << protocol << &from << &to << packetType
-                         << promiscuous);
+    NS_LOG_FUNCTION_HOT(this << device << packet << protocol << &from << &to << packetType
+                             << promiscuous);
     NS_ASSERT_MSG(Simulator::GetContext() == GetId(),
                   "Received packet with erroneous context ; "
                       << "make sure the channels in use are correctly updating events context "
@@ -330,9 +330,10 @@ Node::ReceiveFromDevice(Ptr<NetDevice> device,
             }
         }
     }
-    NS_LOG_DEBUG("Node " << GetId() << " ReceiveFromDevice:  dev " << device->GetIfIndex()
-                         << " (type=" << device->GetInstanceTypeId().GetName() << ") Packet UID "
-                         << packet->GetUid() << " handler found: " << found);
+    NS_LOG_DEBUG_HOT("Node " << GetId() << " ReceiveFromDevice:  dev " << device->GetIfIndex()
+                             << " (type=" << device->GetInstanceTypeId().GetName()
+                             << ") Packet UID " << packet->GetUid()
+                             << " handler found: " << found);
     return found;
 }
 
@@ -32,7 +32,7 @@ PacketMetadata::DataFreeList PacketMetadata::m_freeList;
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     for (auto i = begin(); i != end(); i++)
     {
         PacketMetadata::Deallocate(*i);
@@ -43,7 +43,7 @@ PacketMetadata::DataFreeList::~DataFreeList()
 void
 PacketMetadata::Enable()
 {
-    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_FUNCTION_NOARGS_HOT();
     NS_ASSERT_MSG(!m_metadataSkipped,
                   "Error: attempting to enable the packet metadata "
                   "subsystem too late in the simulation, which is not allowed.\n"
@@ -57,7 +57,7 @@ PacketMetadata::Enable()
 void
 PacketMetadata::EnableChecking()
 {
-    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_FUNCTION_NOARGS_HOT();
     Enable();
     m_enableChecking = true;
 }
@@ -65,7 +65,7 @@ PacketMetadata::EnableChecking()
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
-    NS_LOG_FUNCTION(this << size);
+    NS_LOG_FUNCTION_HOT(this << size);
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
@@ -91,7 +91,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
 void
 PacketMetadata::Reserve(uint32_t size)
 {
-    NS_LOG_FUNCTION(this << size);
+    NS_LOG_FUNCTION_HOT(this << size);
     NS_ASSERT(m_data != nullptr);
     if (m_data->m_size >= m_used + size &&
         (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
@@ -122,7 +122,7 @@ PacketMetadata::IsPointerOk(uint16_t pointer) const
 bool
 PacketMetadata::IsStateOk() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     bool ok = m_used <= m_data->m_size;
     ok &= IsPointerOk(m_head);
     ok &= IsPointerOk(m_tail);
@@ -154,7 +154,7 @@ PacketMetadata::IsStateOk() const
 uint32_t
 PacketMetadata::GetUleb128Size(uint32_t value) const
 {
-    NS_LOG_FUNCTION(this << value);
+    NS_LOG_FUNCTION_HOT(this << value);
     if (value < 0x80)
     {
         return 1;
@@ -177,7 +177,7 @@ PacketMetadata::GetUleb128Size(uint32_t value) const
 uint32_t
 PacketMetadata::ReadUleb128(const uint8_t** pBuffer) const
 {
-    NS_LOG_FUNCTION(this << &pBuffer);
+    NS_LOG_FUNCTION_HOT(this << &pBuffer);
     const uint8_t* buffer = *pBuffer;
     uint32_t result;
     uint8_t byte;
@@ -227,7 +227,7 @@ PacketMetadata::ReadUleb128(const uint8_t** pBuffer) const
 void
 PacketMetadata::Append16(uint16_t value, uint8_t* buffer)
 {
-    NS_LOG_FUNCTION(this << value << &buffer);
+    NS_LOG_FUNCTION_HOT(this << value << &buffer);
     buffer[0] = value & 0xff;
     value >>= 8;
     buffer[1] = value;
@@ -236,7 +236,7 @@ PacketMetadata::Append16(uint16_t value, uint8_t* buffer)
 void
 PacketMetadata::Append32(uint32_t value, uint8_t* buffer)
 {
-    NS_LOG_FUNCTION(this << value << &buffer);
+    NS_LOG_FUNCTION_HOT(this << value << &buffer);
     buffer[0] = value & 0xff;
     buffer[1] = (value >> 8) & 0xff;
     buffer[2] = (value >> 16) & 0xff;
@@ -246,7 +246,7 @@ PacketMetadata::Append32(uint32_t value, uint8_t* buffer)
 void
 PacketMetadata::AppendValueExtra(uint32_t value, uint8_t* buffer)
 {
-    NS_LOG_FUNCTION(this << value << &buffer);
+    NS_LOG_FUNCTION_HOT(this << value << &buffer);
     if (value < 0x200000)
     {
         uint8_t byte = value & (~0x80);
@@ -292,7 +292,7 @@ PacketMetadata::AppendValueExtra(uint32_t value, uint8_t* buffer)
 void
 PacketMetadata::AppendValue(uint32_t value, uint8_t* buffer)
 {
-    NS_LOG_FUNCTION(this << value << &buffer);
+    NS_LOG_FUNCTION_HOT(this << value << &buffer);
     if (value < 0x80)
     {
         buffer[0] = value;
@@ -312,7 +312,7 @@ PacketMetadata::AppendValue(uint32_t value, uint8_t* buffer)
 void
 PacketMetadata::UpdateTail(uint16_t written)
 {
-    NS_LOG_FUNCTION(this << written);
+    NS_LOG_FUNCTION_HOT(this << written);
     if (m_head == 0xffff)
     {
         NS_ASSERT(m_tail == 0xffff);
@@ -338,7 +338,7 @@ PacketMetadata::UpdateTail(uint16_t written)
 void
 PacketMetadata::UpdateHead(uint16_t written)
 {
-    NS_LOG_FUNCTION(this << written);
+    NS_LOG_FUNCTION_HOT(this << written);
     if (m_head == 0xffff)
     {
         NS_ASSERT(m_tail == 0xffff);
@@ -364,8 +364,8 @@ PacketMetadata::UpdateHead(uint16_t written)
 uint16_t
 PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
 {
-    NS_LOG_FUNCTION(this << item->next << item->prev << item->typeUid << item->size
-                         << item->chunkUid);
+    NS_LOG_FUNCTION_HOT(this << item->next << item->prev << item->typeUid << item->size
+                             << item->chunkUid);
     NS_ASSERT(m_data != nullptr);
     NS_ASSERT(m_used != item->prev && m_used != item->next);
     uint32_t typeUidSize = GetUleb128Size(item->typeUid);
@@ -395,9 +395,9 @@ PacketMetadata::AddBig(uint32_t next,
                        const PacketMetadata::SmallItem* item,
                        const PacketMetadata::ExtraItem* extraItem)
 {
-    NS_LOG_FUNCTION(this << next << prev << item->next << item->prev << item->typeUid << item->size
-                         << item->chunkUid << extraItem->fragmentStart << extraItem->fragmentEnd
-                         << extraItem->packetUid);
+    NS_LOG_FUNCTION_HOT(this << next << prev << item->next << item->prev << item->typeUid
+                             << item->size << item->chunkUid << extraItem->fragmentStart
+                             << extraItem->fragmentEnd << extraItem->packetUid);
     NS_ASSERT(m_data != nullptr);
     uint32_t typeUid = ((item->typeUid & 0x1) == 0x1) ? item->typeUid : item->typeUid + 1;
     NS_ASSERT(m_used != prev && m_used != next);
@@ -440,9 +440,9 @@ PacketMetadata::ReplaceTail(PacketMetadata::SmallItem* item,
                             PacketMetadata::ExtraItem* extraItem,
                             uint32_t available)
 {
-    NS_LOG_FUNCTION(this << item->next << item->prev << item->typeUid << item->size
-                         << item->chunkUid << extraItem->fragmentStart << extraItem->fragmentEnd
-                         << extraItem->packetUid << available);
+    NS_LOG_FUNCTION_HOT(this << item->next << item->prev << item->typeUid << item->size
+                             << item->chunkUid << extraItem->fragmentStart << extraItem->fragmentEnd
+                             << extraItem->packetUid << available);
 
     NS_ASSERT(m_data != nullptr);
     /* If the tail we want to replace is located at the end of the data array,
@@ -513,9 +513,9 @@ PacketMetadata::ReadItems(uint16_t current,
                           PacketMetadata::SmallItem* item,
                           PacketMetadata::ExtraItem* extraItem) const
 {
-    NS_LOG_FUNCTION(this << current << item->chunkUid << item->prev << item->next << item->size
-                         << item->typeUid << extraItem->fragmentEnd << extraItem->fragmentStart
-                         << extraItem->packetUid);
+    NS_LOG_FUNCTION_HOT(this << current << item->chunkUid << item->prev << item->next << item->size
+                             << item->typeUid << extraItem->fragmentEnd << extraItem->fragmentStart
+                             << extraItem->packetUid);
     NS_ASSERT(current <= m_data->m_size);
     const uint8_t* buffer = &m_data->m_data[current];
     item->next = buffer[0];
@@ -553,8 +553,8 @@ PacketMetadata::ReadItems(uint16_t current,
 PacketMetadata::Data*
 PacketMetadata::Create(uint32_t size)
 {
-    NS_LOG_FUNCTION(size);
-    NS_LOG_LOGIC("create size=" << size << ", max=" << m_maxSize);
+    NS_LOG_FUNCTION_HOT(size);
+    NS_LOG_LOGIC_HOT("create size=" << size << ", max=" << m_maxSize);
     if (size > m_maxSize)
     {
         m_maxSize = size;
@@ -565,27 +565,27 @@ PacketMetadata::Create(uint32_t size)
         m_freeList.pop_back();
         if (data->m_size >= size)
         {
-            NS_LOG_LOGIC("create found size=" << data->m_size);
+            NS_LOG_LOGIC_HOT("create found size=" << data->m_size);
             data->m_count = 1;
             return data;
         }
-        NS_LOG_LOGIC("create dealloc size=" << data->m_size);
+        NS_LOG_LOGIC_HOT("create dealloc size=" << data->m_size);
         PacketMetadata::Deallocate(data);
     }
-    NS_LOG_LOGIC("create alloc size=" << m_maxSize);
+    NS_LOG_LOGIC_HOT("create alloc size=" << m_maxSize);
     return PacketMetadata::Allocate(m_maxSize);
 }
 
 void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
-    NS_LOG_FUNCTION(data);
+    NS_LOG_FUNCTION_HOT(data);
     if (!m_enable)
     {
         PacketMetadata::Deallocate(data);
         return;
     }
-    NS_LOG_LOGIC("recycle size=" << data->m_size << ", list=" << m_freeList.size());
+    NS_LOG_LOGIC_HOT("recycle size=" << data->m_size << ", list=" << m_freeList.size());
     NS_ASSERT(data->m_count == 0);
     if (m_freeList.size() > 1000 || data->m_size < m_maxSize)
     {
@@ -600,7 +600,7 @@ PacketMetadata::Recycle(PacketMetadata::Data* data)
 PacketMetadata::Data*
 PacketMetadata::Allocate(uint32_t n)
 {
-    NS_LOG_FUNCTION(n);
+    NS_LOG_FUNCTION_HOT(n);
     uint32_t size = sizeof(Data);
     if (n <= PACKET_METADATA_DATA_M_DATA_SIZE)
     {
@@ -618,7 +618,7 @@ PacketMetadata::Allocate(uint32_t n)
 void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
-    NS_LOG_FUNCTION(data);
+    NS_LOG_FUNCTION_HOT(data);
     auto buf = (uint8_t*)data;
     delete[] buf;
 }
@@ -626,7 +626,7 @@ PacketMetadata::Deallocate(PacketMetadata::Data* data)
 PacketMetadata
 PacketMetadata::CreateFragment(uint32_t start, uint32_t end) const
 {
-    NS_LOG_FUNCTION(this << start << end);
+    NS_LOG_FUNCTION_HOT(this << start << end);
     PacketMetadata fragment = *this;
     fragment.RemoveAtStart(start);
     fragment.RemoveAtEnd(end);
@@ -636,7 +636,7 @@ PacketMetadata::CreateFragment(uint32_t start, uint32_t end) const
 void
 PacketMetadata::AddHeader(const Header& header, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << &header << size);
+    NS_LOG_FUNCTION_HOT(this << &header << size);
     uint32_t uid = header.GetInstanceTypeId().GetUid() << 1;
     DoAddHeader(uid, size);
     NS_ASSERT(IsStateOk());
@@ -645,7 +645,7 @@ PacketMetadata::AddHeader(const Header& header, uint32_t size)
 void
 PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << uid << size);
+    NS_LOG_FUNCTION_HOT(this << uid << size);
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -667,7 +667,7 @@ void
 PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
 {
     uint32_t uid = header.GetInstanceTypeId().GetUid() << 1;
-    NS_LOG_FUNCTION(this << &header << size);
+    NS_LOG_FUNCTION_HOT(this << &header << size);
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -712,7 +712,7 @@ void
 PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
 {
     uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
-    NS_LOG_FUNCTION(this << &trailer << size);
+    NS_LOG_FUNCTION_HOT(this << &trailer << size);
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -734,7 +734,7 @@ void
 PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
 {
     uint32_t uid = trailer.GetInstanceTypeId().GetUid() << 1;
-    NS_LOG_FUNCTION(this << &trailer << size);
+    NS_LOG_FUNCTION_HOT(this << &trailer << size);
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -778,7 +778,7 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
 void
 PacketMetadata::AddAtEnd(const PacketMetadata& o)
 {
-    NS_LOG_FUNCTION(this << &o);
+    NS_LOG_FUNCTION_HOT(this << &o);
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -854,7 +854,7 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
 void
 PacketMetadata::AddPaddingAtEnd(uint32_t end)
 {
-    NS_LOG_FUNCTION(this << end);
+    NS_LOG_FUNCTION_HOT(this << end);
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -865,7 +865,7 @@ PacketMetadata::AddPaddingAtEnd(uint32_t end)
 void
 PacketMetadata::RemoveAtStart(uint32_t start)
 {
-    NS_LOG_FUNCTION(this << start);
+    NS_LOG_FUNCTION_HOT(this << start);
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -926,7 +926,7 @@ PacketMetadata::RemoveAtStart(uint32_t start)
 void
 PacketMetadata::RemoveAtEnd(uint32_t end)
 {
-    NS_LOG_FUNCTION(this << end);
+    NS_LOG_FUNCTION_HOT(this << end);
     if (!m_enable)
     {
         m_metadataSkipped = true;
@@ -989,7 +989,7 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
 uint32_t
 PacketMetadata::GetTotalSize() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint32_t totalSize = 0;
     uint16_t current = m_head;
     uint16_t tail = m_tail;
@@ -1012,14 +1012,14 @@ PacketMetadata::GetTotalSize() const
 uint64_t
 PacketMetadata::GetUid() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_packetUid;
 }
 
 PacketMetadata::ItemIterator
 PacketMetadata::BeginItem(Buffer buffer) const
 {
-    NS_LOG_FUNCTION(this << &buffer);
+    NS_LOG_FUNCTION_HOT(this << &buffer);
     return ItemIterator(this, buffer);
 }
 
@@ -1030,13 +1030,13 @@ PacketMetadata::ItemIterator::ItemIterator(const PacketMetadata* metadata, Buffe
       m_offset(0),
       m_hasReadTail(false)
 {
-    NS_LOG_FUNCTION(this << metadata << &buffer);
+    NS_LOG_FUNCTION_HOT(this << metadata << &buffer);
 }
 
 bool
 PacketMetadata::ItemIterator::HasNext() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     if (m_current == 0xffff)
     {
         return false;
@@ -1051,7 +1051,7 @@ PacketMetadata::ItemIterator::HasNext() const
 PacketMetadata::Item
 PacketMetadata::ItemIterator::Next()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     PacketMetadata::Item item;
     PacketMetadata::SmallItem smallItem;
     PacketMetadata::ExtraItem extraItem;
@@ -1102,7 +1102,7 @@ PacketMetadata::ItemIterator::Next()
 uint32_t
 PacketMetadata::GetSerializedSize() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint32_t totalSize = 0;
 
     // add 8 bytes for the packet uid
@@ -1147,7 +1147,7 @@ PacketMetadata::GetSerializedSize() const
 uint32_t
 PacketMetadata::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
-    NS_LOG_FUNCTION(this << &buffer << maxSize);
+    NS_LOG_FUNCTION_HOT(this << &buffer << maxSize);
     uint8_t* start = buffer;
 
     buffer = AddToRawU64(m_packetUid, start, buffer, maxSize);
@@ -1162,7 +1162,7 @@ PacketMetadata::Serialize(uint8_t* buffer, uint32_t maxSize) const
     while (current != 0xffff)
     {
         ReadItems(current, &item, &extraItem);
-        NS_LOG_LOGIC("bytesWritten=" << static_cast<uint32_t>(buffer - start)
+        NS_LOG_LOGIC_HOT("bytesWritten=" << static_cast<uint32_t>(buffer - start)
                                      << ", typeUid=" << item.typeUid << ", size=" << item.size
                                      << ", chunkUid=" << item.chunkUid
                                      << ", fragmentStart=" << extraItem.fragmentStart
@@ -1253,7 +1253,7 @@ PacketMetadata::Serialize(uint8_t* buffer, uint32_t maxSize) const
 uint32_t
 PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << &buffer << size);
+    NS_LOG_FUNCTION_HOT(this << &buffer << size);
     const uint8_t* start = buffer;
     uint32_t desSize = size - 4;
 
@@ -1300,10 +1300,11 @@ PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
         desSize -= 4;
         buffer = ReadFromRawU64(extraItem.packetUid, start, buffer, size);
         desSize -= 8;
-        NS_LOG_LOGIC("size=" << size << ", typeUid=" << item.typeUid << ", size=" << item.size
-                             << ", chunkUid=" << item.chunkUid << ", fragmentStart="
-                             << extraItem.fragmentStart << ", fragmentEnd=" << extraItem.fragmentEnd
-                             << ", packetUid=" << extraItem.packetUid);
+        NS_LOG_LOGIC_HOT("size=" << size << ", typeUid=" << item.typeUid << ", size=" << item.size
+                                 << ", chunkUid=" << item.chunkUid << ", fragmentStart="
+                                 << extraItem.fragmentStart
+                                 << ", fragmentEnd=" << extraItem.fragmentEnd
+                                 << ", packetUid=" << extraItem.packetUid);
         uint32_t tmp = AddBig(0xffff, m_tail, &item, &extraItem);
         UpdateTail(tmp);
     }
@@ -1314,7 +1315,7 @@ PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
 uint8_t*
 PacketMetadata::AddToRawU8(const uint8_t& data, uint8_t* start, uint8_t* current, uint32_t maxSize)
 {
-    NS_LOG_FUNCTION(static_cast<uint32_t>(data) << &start << &current << maxSize);
+    NS_LOG_FUNCTION_HOT(static_cast<uint32_t>(data) << &start << &current << maxSize);
     // First check buffer overflow
     if (static_cast<uint32_t>(current + sizeof(uint8_t) - start) > maxSize)
     {
@@ -1330,7 +1331,7 @@ PacketMetadata::AddToRawU16(const uint16_t& data,
                             uint8_t* current,
                             uint32_t maxSize)
 {
-    NS_LOG_FUNCTION(data << &start << &current << maxSize);
+    NS_LOG_FUNCTION_HOT(data << &start << &current << maxSize);
     // First check buffer overflow
     if (static_cast<uint32_t>(current + sizeof(uint16_t) - start) > maxSize)
     {
@@ -1346,7 +1347,7 @@ PacketMetadata::AddToRawU32(const uint32_t& data,
                             uint8_t* current,
                             uint32_t maxSize)
 {
-    NS_LOG_FUNCTION(data << &start << &current << maxSize);
+    NS_LOG_FUNCTION_HOT(data << &start << &current << maxSize);
     // First check buffer overflow
     if (static_cast<uint32_t>(current + sizeof(uint32_t) - start) > maxSize)
     {
@@ -1362,7 +1363,7 @@ PacketMetadata::AddToRawU64(const uint64_t& data,
                             uint8_t* current,
                             uint32_t maxSize)
 {
-    NS_LOG_FUNCTION(data << &start << &current << maxSize);
+    NS_LOG_FUNCTION_HOT(data << &start << &current << maxSize);
     // First check buffer overflow
     if (static_cast<uint32_t>(current + sizeof(uint64_t) - start) > maxSize)
     {
@@ -1379,7 +1380,7 @@ PacketMetadata::AddToRaw(const uint8_t* data,
                          uint8_t* current,
                          uint32_t maxSize)
 {
-    NS_LOG_FUNCTION(&data << dataSize << &start << &current << maxSize);
+    NS_LOG_FUNCTION_HOT(&data << dataSize << &start << &current << maxSize);
     // First check buffer overflow
     if (static_cast<uint32_t>(current + dataSize - start) > maxSize)
     {
@@ -1395,7 +1396,7 @@ PacketMetadata::ReadFromRawU8(uint8_t& data,
                               const uint8_t* current,
                               uint32_t maxSize)
 {
-    NS_LOG_FUNCTION(static_cast<uint32_t>(data) << &start << &current << maxSize);
+    NS_LOG_FUNCTION_HOT(static_cast<uint32_t>(data) << &start << &current << maxSize);
     // First check buffer underflow
     if (static_cast<uint32_t>(current + sizeof(uint8_t) - start) > maxSize)
     {
@@ -1411,7 +1412,7 @@ PacketMetadata::ReadFromRawU16(uint16_t& data,
                                const uint8_t* current,
                                uint32_t maxSize)
 {
-    NS_LOG_FUNCTION(data << &start << &current << maxSize);
+    NS_LOG_FUNCTION_HOT(data << &start << &current << maxSize);
     // First check buffer underflow
     if (static_cast<uint32_t>(current + sizeof(uint16_t) - start) > maxSize)
     {
@@ -1427,7 +1428,7 @@ PacketMetadata::ReadFromRawU32(uint32_t& data,
                                const uint8_t* current,
                                uint32_t maxSize)
 {
-    NS_LOG_FUNCTION(data << &start << &current << maxSize);
+    NS_LOG_FUNCTION_HOT(data << &start << &current << maxSize);
     // First check buffer underflow
     if (static_cast<uint32_t>(current + sizeof(uint32_t) - start) > maxSize)
     {
@@ -1443,7 +1444,7 @@ PacketMetadata::ReadFromRawU64(uint64_t& data,
                                const uint8_t* current,
                                uint32_t maxSize)
 {
-    NS_LOG_FUNCTION(data << &start << &current << maxSize);
+    NS_LOG_FUNCTION_HOT(data << &start << &current << maxSize);
     // First check buffer underflow
     if ((uint32_t)(current + sizeof(uint64_t) - start) > maxSize)
     {
@@ -16,16 +16,67 @@
 #include "tag-buffer.h"
 #include "tag.h"
 
+#include "ns3/abort.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
 #include <cstring>
+#include <vector>
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
+namespace
+{
+/**
+ * Slots of the tag types kept inline, indexed by TypeId uid: the slot
+ * index plus one, or 0 for types kept in the list.
+ *
+ * @returns The table.
+ */
+std::vector<uint8_t>&
+SlotTable()
+{
+    static std::vector<uint8_t> table;
+    return table;
+}
+
+/** Number of slots given out by RegisterSlot. */
+uint32_t g_slotsUsed = 0;
+} // namespace
+
+void
+PacketTagList::RegisterSlot(TypeId tid)
+{
+    NS_LOG_FUNCTION_HOT(tid);
+    std::vector<uint8_t>& table = SlotTable();
+    if (tid.GetUid() < table.size() && table[tid.GetUid()] != 0)
+    {
+        return;
+    }
+    NS_ABORT_MSG_IF(g_slotsUsed == SLOTS,
+                    "No inline packet tag slot left for " << tid.GetName());
+    if (tid.GetUid() >= table.size())
+    {
+        table.resize(tid.GetUid() + 1, 0);
+    }
+    table[tid.GetUid()] = ++g_slotsUsed;
+}
+
+uint32_t
+PacketTagList::SlotOf(TypeId tid)
+{
+    const std::vector<uint8_t>& table = SlotTable();
+    uint16_t uid = tid.GetUid();
+    if (uid < table.size() && table[uid] != 0)
+    {
+        return table[uid] - 1;
+    }
+    return SLOTS;
+}
+
 PacketTagList::TagData*
 PacketTagList::CreateTagData(size_t dataSize)
 {
@@ -45,8 +96,8 @@ bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
     TypeId tid = tag.GetInstanceTypeId();
-    NS_LOG_FUNCTION(this << tid);
-    NS_LOG_INFO("looking for " << tid);
+    NS_LOG_FUNCTION_HOT(this << tid);
+    NS_LOG_INFO_HOT("looking for " << tid);
 
     // trivial case when list is empty
     if (m_next == nullptr)
@@ -66,12 +117,12 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
         if (cur->count > 1)
         {
             // found merge
-            NS_LOG_INFO("found initial merge before tid");
+            NS_LOG_INFO_HOT("found initial merge before tid");
             break;
         }
         else if (cur->tid == tid)
         {
-            NS_LOG_INFO("found tid before initial merge, calling writer");
+            NS_LOG_INFO_HOT("found tid before initial merge, calling writer");
             found = (this->*Writer)(tag, true, cur, prevNext);
             break;
         }
@@ -86,7 +137,7 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
     // did we find it or run out of tags?
     if (cur == nullptr || found)
     {
-        NS_LOG_INFO("returning after header with found: " << found);
+        NS_LOG_INFO_HOT("returning after header with found: " << found);
         return found;
     }
 
@@ -104,7 +155,7 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
     if (it == nullptr)
     {
         // got to end of list without finding tid
-        NS_LOG_INFO("tid not found after first merge");
+        NS_LOG_INFO_HOT("tid not found after first merge");
         return found;
     }
 
@@ -164,6 +215,16 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 bool
 PacketTagList::Remove(Tag& tag)
 {
+    uint32_t slot = SlotOf(tag.GetInstanceTypeId());
+    if (slot < SLOTS)
+    {
+        if (!Peek(tag))
+        {
+            return false;
+        }
+        m_slotMask &= ~(1 << slot);
+        return true;
+    }
     return COWTraverse(tag, &PacketTagList::RemoveWriter);
 }
 
@@ -174,7 +235,7 @@ PacketTagList::RemoveWriter(Tag& tag,
                             PacketTagList::TagData* cur,
                             PacketTagList::TagData** prevNext)
 {
-    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_FUNCTION_NOARGS_HOT();
 
     // found tid
     bool found = true;
@@ -204,6 +265,14 @@ PacketTagList::RemoveWriter(Tag& tag,
 bool
 PacketTagList::Replace(Tag& tag)
 {
+    uint32_t slot = SlotOf(tag.GetInstanceTypeId());
+    if (slot < SLOTS)
+    {
+        bool found = m_slotMask & (1 << slot);
+        m_slotMask &= ~(1 << slot);
+        Add(tag);
+        return found;
+    }
     bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
     if (!found)
     {
@@ -219,7 +288,7 @@ PacketTagList::ReplaceWriter(Tag& tag,
                              PacketTagList::TagData* cur,
                              PacketTagList::TagData** prevNext)
 {
-    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_FUNCTION_NOARGS_HOT();
 
     // found tid
     bool found = true;
@@ -250,7 +319,26 @@ PacketTagList::ReplaceWriter(Tag& tag,
 void
 PacketTagList::Add(const Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
+    NS_LOG_FUNCTION_HOT(this << tag.GetInstanceTypeId());
+    TypeId tid = tag.GetInstanceTypeId();
+    uint32_t slot = SlotOf(tid);
+    if (slot < SLOTS)
+    {
+        NS_ASSERT_MSG(!(m_slotMask & (1 << slot)),
+                      "Error: cannot add the same kind of tag twice. The tag type is "
+                          << tid.GetName());
+        uint32_t size = tag.GetSerializedSize();
+        NS_ASSERT_MSG(size <= SLOT_SIZE,
+                      "Tag " << tid.GetName() << " of " << size
+                             << " bytes is too large for an inline slot");
+        auto self = const_cast<PacketTagList*>(this);
+        Slot& s = self->m_slots[slot];
+        s.tid = tid;
+        s.size = size;
+        tag.Serialize(TagBuffer(s.data, s.data + size));
+        self->m_slotMask |= (1 << slot);
+        return;
+    }
     // ensure this id was not yet added
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
@@ -271,8 +359,19 @@ PacketTagList::Add(const Tag& tag) const
 bool
 PacketTagList::Peek(Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
+    NS_LOG_FUNCTION_HOT(this << tag.GetInstanceTypeId());
     TypeId tid = tag.GetInstanceTypeId();
+    uint32_t slot = SlotOf(tid);
+    if (slot < SLOTS)
+    {
+        if (!(m_slotMask & (1 << slot)))
+        {
+            return false;
+        }
+        auto data = const_cast<uint8_t*>(m_slots[slot].data);
+        tag.Deserialize(TagBuffer(data, data + m_slots[slot].size));
+        return true;
+    }
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         if (cur->tid == tid)
@@ -295,23 +394,35 @@ PacketTagList::Head() const
 uint32_t
 PacketTagList::GetSerializedSize() const
 {
-    NS_LOG_FUNCTION_NOARGS();
+    NS_LOG_FUNCTION_NOARGS_HOT();
 
     uint32_t size = 0;
 
     size = 4; // numberOfTags
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
-        size += 4; // TagData -> size
+    auto tagSize = [](uint32_t dataSize) {
+        uint32_t size = 4; // TagData -> size
 
         // TypeId hash; ensure size is multiple of 4 bytes
         uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
         size += hashSize;
 
         // TagData -> data; ensure size is multiple of 4 bytes
-        uint32_t tagWordSize = (cur->size + 3) & (~3);
+        uint32_t tagWordSize = (dataSize + 3) & (~3);
         size += tagWordSize;
+        return size;
+    };
+
+    for (uint32_t i = 0; i < SLOTS; ++i)
+    {
+        if (m_slotMask & (1 << i))
+        {
+            size += tagSize(m_slots[i].size);
+        }
+    }
+    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    {
+        size += tagSize(cur->size);
     }
 
     return size;
@@ -320,7 +431,7 @@ PacketTagList::GetSerializedSize() const
 uint32_t
 PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 {
-    NS_LOG_FUNCTION(this << buffer << maxSize);
+    NS_LOG_FUNCTION_HOT(this << buffer << maxSize);
 
     uint32_t* p = buffer;
     uint32_t size = 0;
@@ -335,18 +446,17 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     uint32_t* numberOfTags = p;
     *p++ = 0;
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
+    auto serializeTag = [&](TypeId tid, const uint8_t* data, uint32_t dataSize) {
         size += 4;
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        *p++ = cur->size;
+        *p++ = dataSize;
 
-        NS_LOG_INFO("Serializing tag id " << cur->tid);
+        NS_LOG_INFO_HOT("Serializing tag id " << tid);
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
         uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
@@ -354,26 +464,43 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        TypeId::hash_t tid = cur->tid.GetHash();
-        memcpy(p, &tid, sizeof(TypeId::hash_t));
+        TypeId::hash_t hash = tid.GetHash();
+        memcpy(p, &hash, sizeof(TypeId::hash_t));
         p += hashSize / 4;
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
-        uint32_t tagWordSize = (cur->size + 3) & (~3);
+        uint32_t tagWordSize = (dataSize + 3) & (~3);
         size += tagWordSize;
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        memcpy(p, cur->data, cur->size);
+        memcpy(p, data, dataSize);
         p += tagWordSize / 4;
 
         (*numberOfTags)++;
+        return true;
+    };
+
+    for (uint32_t i = 0; i < SLOTS; ++i)
+    {
+        if ((m_slotMask & (1 << i)) &&
+            !serializeTag(m_slots[i].tid, m_slots[i].data, m_slots[i].size))
+        {
+            return 0;
+        }
+    }
+    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    {
+        if (!serializeTag(cur->tid, cur->data, cur->size))
+        {
+            return 0;
+        }
     }
 
     // Serialized successfully
@@ -383,7 +510,7 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 uint32_t
 PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << buffer << size);
+    NS_LOG_FUNCTION_HOT(this << buffer << size);
     const uint32_t* p = buffer;
     uint32_t sizeCheck = size - 4;
 
@@ -391,7 +518,7 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
     uint32_t numberOfTags = *p++;
     sizeCheck -= 4;
 
-    NS_LOG_INFO("Deserializing number of tags " << numberOfTags);
+    NS_LOG_INFO_HOT("Deserializing number of tags " << numberOfTags);
 
     TagData* prevTag = nullptr;
     for (uint32_t i = 0; i < numberOfTags; ++i)
@@ -409,23 +536,37 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         TypeId tid = TypeId::LookupByHash(hash);
 
-        NS_LOG_INFO("Deserializing tag of type " << tid);
+        NS_LOG_INFO_HOT("Deserializing tag of type " << tid);
+
+        NS_ASSERT(sizeCheck >= tagSize);
+        // ensure 4 byte boundary
+        uint32_t tagWordSize = (tagSize + 3) & (~3);
+
+        uint32_t slot = SlotOf(tid);
+        if (slot < SLOTS)
+        {
+            NS_ASSERT(tagSize <= SLOT_SIZE);
+            m_slots[slot].tid = tid;
+            m_slots[slot].size = tagSize;
+            memcpy(m_slots[slot].data, p, tagSize);
+            m_slotMask |= (1 << slot);
+            p += tagWordSize / 4;
+            sizeCheck -= tagWordSize;
+            continue;
+        }
 
         TagData* newTag = CreateTagData(tagSize);
         newTag->count = 1;
         newTag->next = nullptr;
         newTag->tid = tid;
 
-        NS_ASSERT(sizeCheck >= tagSize);
         memcpy(newTag->data, p, tagSize);
 
-        // ensure 4 byte boundary
-        uint32_t tagWordSize = (tagSize + 3) & (~3);
         p += tagWordSize / 4;
         sizeCheck -= tagWordSize;
 
         // Set link list pointers.
-        if (i == 0)
+        if (prevTag == nullptr)
         {
             m_next = newTag;
         }
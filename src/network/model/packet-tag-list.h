@@ -109,6 +109,15 @@ class Tag;
  *       The portion of the list between the first branch and the target is
  *       shared. This portion is copied before the #Remove or #Replace is
  *       performed.
+ *
+ * @par <b> Inline slots </b>
+ *
+ *   A few tag types, registered with #RegisterSlot, are instead kept
+ *   in slots stored in the PacketTagList itself, indexed by a small
+ *   integer found from the TypeId uid.  #Add, #Remove, #Replace and
+ *   #Peek of these tags are constant time and never allocate, at the
+ *   cost of copying the slots with the list.  This suits tags that are
+ *   replaced at every hop of a packet.
  */
 class PacketTagList
 {
@@ -137,6 +146,32 @@ class PacketTagList
         uint8_t data[1]; //!< Serialization buffer
     };
 
+    /** Number of inline slots. */
+    static constexpr uint32_t SLOTS = 4;
+    /** Largest serialized size of a tag kept in a slot. */
+    static constexpr uint32_t SLOT_SIZE = 24;
+
+    /** A tag kept inline, in serialized form. */
+    struct Slot
+    {
+        TypeId tid;               //!< Type of the tag serialized into #data
+        uint8_t size;             //!< Size of the tag in \c data
+        uint8_t data[SLOT_SIZE]; //!< Serialization buffer
+    };
+
+    /**
+     * Keep the tags of a type in an inline slot rather than in the list.
+     *
+     * The registration applies to every PacketTagList, so it must be made
+     * before any tag of the type is added to a packet, typically when the
+     * module defining the tag is loaded.  A type registered twice keeps its
+     * first slot.
+     *
+     * @param [in] tid The tag type; its serialized size must be at most
+     *        #SLOT_SIZE.
+     */
+    static void RegisterSlot(TypeId tid);
+
     /**
      * Create a new PacketTagList.
      */
@@ -147,7 +182,8 @@ class PacketTagList
      * @param [in] o The PacketTagList to copy.
      *
      * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * pointing to the same \ref TagData as \pname{o}, and
+     * copying its occupied slots.
      */
     inline PacketTagList(const PacketTagList& o);
     /**
@@ -157,7 +193,8 @@ class PacketTagList
      * @returns the copied object
      *
      * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * pointing to the same \ref TagData as \pname{o}, and
+     * copying its occupied slots.
      */
     inline PacketTagList& operator=(const PacketTagList& o);
     /**
@@ -204,9 +241,14 @@ class PacketTagList
      */
     inline void RemoveAll();
     /**
-     * @returns pointer to head of tag list
+     * @returns pointer to head of tag list, without the inline slots
      */
     const PacketTagList::TagData* Head() const;
+    /**
+     * @param [in] slot The slot index, less than #SLOTS.
+     * @returns the tag in the slot, or nullptr if the slot is empty
+     */
+    inline const PacketTagList::Slot* GetSlot(uint32_t slot) const;
     /**
      * Returns number of bytes required for packet serialization.
      *
@@ -242,6 +284,14 @@ class PacketTagList
      */
     static TagData* CreateTagData(size_t dataSize);
 
+    /**
+     * Find the slot of a tag type.
+     *
+     * @param [in] tid The tag type.
+     * @returns The slot index, or #SLOTS if the type is kept in the list.
+     */
+    static uint32_t SlotOf(TypeId tid);
+
     /**
      * Typedef of method function pointer for copy-on-write operations
      *
@@ -294,6 +344,10 @@ class PacketTagList
      * Pointer to first \ref TagData on the list
      */
     TagData* m_next;
+    /** Inline tags, by slot index. */
+    Slot m_slots[SLOTS];
+    /** Bit i is set if slot i holds a tag. */
+    uint8_t m_slotMask;
 };
 
 } // namespace ns3
@@ -306,32 +360,52 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_next(),
+      m_slotMask(0)
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_next(o.m_next),
+      m_slotMask(o.m_slotMask)
 {
     if (m_next != nullptr)
     {
         m_next->count++;
     }
+    for (uint32_t i = 0; i < SLOTS; ++i)
+    {
+        if (m_slotMask & (1 << i))
+        {
+            m_slots[i] = o.m_slots[i];
+        }
+    }
 }
 
 PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (this == &o)
     {
         return *this;
     }
-    RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    if (m_next != o.m_next)
     {
-        m_next->count++;
+        RemoveAll();
+        m_next = o.m_next;
+        if (m_next != nullptr)
+        {
+            m_next->count++;
+        }
+    }
+    m_slotMask = o.m_slotMask;
+    for (uint32_t i = 0; i < SLOTS; ++i)
+    {
+        if (m_slotMask & (1 << i))
+        {
+            m_slots[i] = o.m_slots[i];
+        }
     }
     return *this;
 }
@@ -365,6 +439,13 @@ PacketTagList::RemoveAll()
         std::free(prev);
     }
     m_next = nullptr;
+    m_slotMask = 0;
+}
+
+const PacketTagList::Slot*
+PacketTagList::GetSlot(uint32_t slot) const
+{
+    return (m_slotMask & (1 << slot)) ? &m_slots[slot] : nullptr;
 }
 
 } // namespace ns3
@@ -78,42 +78,63 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList& list)
+    : m_list(&list),
+      m_slot(0),
+      m_current(list.Head())
 {
+    SkipEmptySlots();
+}
+
+void
+PacketTagIterator::SkipEmptySlots()
+{
+    while (m_slot < PacketTagList::SLOTS && m_list->GetSlot(m_slot) == nullptr)
+    {
+        m_slot++;
+    }
 }
 
 bool
 PacketTagIterator::HasNext() const
 {
-    return m_current != nullptr;
+    return m_slot < PacketTagList::SLOTS || m_current != nullptr;
 }
 
 PacketTagIterator::Item
 PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
+    if (m_slot < PacketTagList::SLOTS)
+    {
+        const PacketTagList::Slot* slot = m_list->GetSlot(m_slot);
+        m_slot++;
+        SkipEmptySlots();
+        return PacketTagIterator::Item(slot->tid, slot->data, slot->size);
+    }
     const PacketTagList::TagData* prev = m_current;
     m_current = m_current->next;
-    return PacketTagIterator::Item(prev);
+    return PacketTagIterator::Item(prev->tid, prev->data, prev->size);
 }
 
-PacketTagIterator::Item::Item(const PacketTagList::TagData* data)
-    : m_data(data)
+PacketTagIterator::Item::Item(TypeId tid, const uint8_t* data, uint32_t size)
+    : m_tid(tid),
+      m_data(data),
+      m_size(size)
 {
 }
 
 TypeId
 PacketTagIterator::Item::GetTypeId() const
 {
-    return m_data->tid;
+    return m_tid;
 }
 
 void
 PacketTagIterator::Item::GetTag(Tag& tag) const
 {
-    NS_ASSERT(tag.GetInstanceTypeId() == m_data->tid);
-    tag.Deserialize(TagBuffer((uint8_t*)m_data->data, (uint8_t*)m_data->data + m_data->size));
+    NS_ASSERT(tag.GetInstanceTypeId() == m_tid);
+    tag.Deserialize(TagBuffer((uint8_t*)m_data, (uint8_t*)m_data + m_size));
 }
 
 Ptr<Packet>
@@ -226,7 +247,7 @@ Packet::Packet(const Buffer& buffer,
 Ptr<Packet>
 Packet::CreateFragment(uint32_t start, uint32_t length) const
 {
-    NS_LOG_FUNCTION(this << start << length);
+    NS_LOG_FUNCTION_HOT(this << start << length);
     Buffer buffer = m_buffer.CreateFragment(start, length);
     ByteTagList byteTagList = m_byteTagList;
     byteTagList.Adjust(-start);
@@ -257,7 +278,7 @@ void
 Packet::AddHeader(const Header& header)
 {
     uint32_t size = header.GetSerializedSize();
-    NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << size);
+    NS_LOG_FUNCTION_HOT(this << header.GetInstanceTypeId().GetName() << size);
     m_buffer.AddAtStart(size);
     m_byteTagList.Adjust(size);
     m_byteTagList.AddAtStart(size);
@@ -272,7 +293,7 @@ Packet::RemoveHeader(Header& header, uint32_t size)
     end = m_buffer.Begin();
     end.Next(size);
     uint32_t deserialized = header.Deserialize(m_buffer.Begin(), end);
-    NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
+    NS_LOG_FUNCTION_HOT(this << header.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
     m_metadata.RemoveHeader(header, deserialized);
@@ -283,7 +304,7 @@ uint32_t
 Packet::RemoveHeader(Header& header)
 {
     uint32_t deserialized = header.Deserialize(m_buffer.Begin());
-    NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
+    NS_LOG_FUNCTION_HOT(this << header.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtStart(deserialized);
     m_byteTagList.Adjust(-deserialized);
     m_metadata.RemoveHeader(header, deserialized);
@@ -294,7 +315,7 @@ uint32_t
 Packet::PeekHeader(Header& header) const
 {
     uint32_t deserialized = header.Deserialize(m_buffer.Begin());
-    NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
+    NS_LOG_FUNCTION_HOT(this << header.GetInstanceTypeId().GetName() << deserialized);
     return deserialized;
 }
 
@@ -305,15 +326,23 @@ Packet::PeekHeader(Header& header, uint32_t size) const
     end = m_buffer.Begin();
     end.Next(size);
     uint32_t deserialized = header.Deserialize(m_buffer.Begin(), end);
-    NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
+    NS_LOG_FUNCTION_HOT(this << header.GetInstanceTypeId().GetName() << deserialized);
     return deserialized;
 }
 
+Buffer::Iterator
+Packet::BeginWritable()
+{
+    NS_LOG_FUNCTION_HOT(this);
+    m_buffer.MakeWritable();
+    return m_buffer.Begin();
+}
+
 void
 Packet::AddTrailer(const Trailer& trailer)
 {
     uint32_t size = trailer.GetSerializedSize();
-    NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << size);
+    NS_LOG_FUNCTION_HOT(this << trailer.GetInstanceTypeId().GetName() << size);
     m_byteTagList.AddAtEnd(GetSize());
     m_buffer.AddAtEnd(size);
     Buffer::Iterator end = m_buffer.End();
@@ -325,7 +354,7 @@ uint32_t
 Packet::RemoveTrailer(Trailer& trailer)
 {
     uint32_t deserialized = trailer.Deserialize(m_buffer.End());
-    NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
+    NS_LOG_FUNCTION_HOT(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtEnd(deserialized);
     m_metadata.RemoveTrailer(trailer, deserialized);
     return deserialized;
@@ -335,14 +364,14 @@ uint32_t
 Packet::PeekTrailer(Trailer& trailer)
 {
     uint32_t deserialized = trailer.Deserialize(m_buffer.End());
-    NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
+    NS_LOG_FUNCTION_HOT(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     return deserialized;
 }
 
 void
 Packet::AddAtEnd(Ptr<const Packet> packet)
 {
-    NS_LOG_FUNCTION(this << packet << packet->GetSize());
+    NS_LOG_FUNCTION_HOT(this << packet << packet->GetSize());
     m_byteTagList.AddAtEnd(GetSize());
     ByteTagList copy = packet->m_byteTagList;
     copy.AddAtStart(0);
@@ -355,7 +384,7 @@ Packet::AddAtEnd(Ptr<const Packet> packet)
 void
 Packet::AddPaddingAtEnd(uint32_t size)
 {
-    NS_LOG_FUNCTION(this << size);
+    NS_LOG_FUNCTION_HOT(this << size);
     m_byteTagList.AddAtEnd(GetSize());
     m_buffer.AddAtEnd(size);
     m_metadata.AddPaddingAtEnd(size);
@@ -364,7 +393,7 @@ Packet::AddPaddingAtEnd(uint32_t size)
 void
 Packet::RemoveAtEnd(uint32_t size)
 {
-    NS_LOG_FUNCTION(this << size);
+    NS_LOG_FUNCTION_HOT(this << size);
     m_buffer.RemoveAtEnd(size);
     m_metadata.RemoveAtEnd(size);
 }
@@ -372,7 +401,7 @@ Packet::RemoveAtEnd(uint32_t size)
 void
 Packet::RemoveAtStart(uint32_t size)
 {
-    NS_LOG_FUNCTION(this << size);
+    NS_LOG_FUNCTION_HOT(this << size);
     m_buffer.RemoveAtStart(size);
     m_byteTagList.Adjust(-size);
     m_metadata.RemoveAtStart(size);
@@ -381,7 +410,7 @@ Packet::RemoveAtStart(uint32_t size)
 void
 Packet::RemoveAllByteTags()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     m_byteTagList.RemoveAll();
 }
 
@@ -903,7 +932,7 @@ Packet::Deserialize(const uint8_t* buffer, uint32_t size)
 void
 Packet::AddByteTag(const Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_LOG_FUNCTION_HOT(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
     auto list = const_cast<ByteTagList*>(&m_byteTagList);
     TagBuffer buffer = list->Add(tag.GetInstanceTypeId(), tag.GetSerializedSize(), 0, GetSize());
     tag.Serialize(buffer);
@@ -912,7 +941,7 @@ Packet::AddByteTag(const Tag& tag) const
 void
 Packet::AddByteTag(const Tag& tag, uint32_t start, uint32_t end) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_LOG_FUNCTION_HOT(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
     NS_ABORT_MSG_IF(end < start, "Invalid byte range");
     auto list = const_cast<ByteTagList*>(&m_byteTagList);
     TagBuffer buffer = list->Add(tag.GetInstanceTypeId(),
@@ -948,14 +977,14 @@ Packet::FindFirstMatchingByteTag(Tag& tag) const
 void
 Packet::AddPacketTag(const Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_LOG_FUNCTION_HOT(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
     m_packetTagList.Add(tag);
 }
 
 bool
 Packet::RemovePacketTag(Tag& tag)
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_LOG_FUNCTION_HOT(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
     bool found = m_packetTagList.Remove(tag);
     return found;
 }
@@ -963,7 +992,7 @@ Packet::RemovePacketTag(Tag& tag)
 bool
 Packet::ReplacePacketTag(Tag& tag)
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_LOG_FUNCTION_HOT(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
     bool found = m_packetTagList.Replace(tag);
     return found;
 }
@@ -978,7 +1007,7 @@ Packet::PeekPacketTag(Tag& tag) const
 void
 Packet::RemoveAllPacketTags()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     m_packetTagList.RemoveAll();
 }
 
@@ -1008,7 +1037,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(m_packetTagList);
 }
 
 std::ostream&
@@ -149,10 +149,14 @@ class PacketTagIterator
         friend class PacketTagIterator;
         /**
          * Constructor
-         * @param data the data to copy.
+         * @param tid the type of the tag.
+         * @param data the serialized tag.
+         * @param size the size of the serialized tag.
          */
-        Item(const PacketTagList::TagData* data);
-        const PacketTagList::TagData* m_data; //!< the tag data
+        Item(TypeId tid, const uint8_t* data, uint32_t size);
+        TypeId m_tid;          //!< the tag type
+        const uint8_t* m_data; //!< the tag data
+        uint32_t m_size;       //!< the tag data size
     };
 
     /**
@@ -169,9 +173,13 @@ class PacketTagIterator
     friend class Packet;
     /**
      * Constructor
-     * @param head head of the items
+     * @param list the tags of the packet
      */
-    PacketTagIterator(const PacketTagList::TagData* head);
+    PacketTagIterator(const PacketTagList& list);
+    /** Skip empty slots. */
+    void SkipEmptySlots();
+    const PacketTagList* m_list;             //!< the tags of the packet
+    uint32_t m_slot;                         //!< next inline slot, or PacketTagList::SLOTS
     const PacketTagList::TagData* m_current; //!< actual position over the set of tags in a packet
 };
 
@@ -351,6 +359,18 @@ class Packet : public SimpleRefCount<Packet>
      * @returns the number of bytes read from the packet.
      */
     uint32_t PeekHeader(Header& header, uint32_t size) const;
+    /**
+     * @brief Get an iterator to overwrite headers already in the packet.
+     *
+     * This is for updating fields of a header in place, such as a telemetry
+     * slot, without removing and adding back the headers in front of it.
+     * The bytes are copied first if other packets share them. The packet
+     * metadata is not updated, so the header layout must not change.
+     * Adding or removing headers or trailers invalidates the iterator.
+     *
+     * @returns an iterator to the first byte of the packet.
+     */
+    Buffer::Iterator BeginWritable();
     /**
      * @brief Add trailer to this packet.
      *
@@ -11,6 +11,7 @@
 #include "socket.h"
 
 #include "node.h"
+#include "packet-tag-list.h"
 #include "packet.h"
 #include "socket-factory.h"
 
@@ -835,6 +836,15 @@ SocketIpTosTag::Print(std::ostream& os) const
     os << "IP_TOS = " << m_ipTos;
 }
 
+/**
+ * The priority is read at every hop by the queue discs and devices that
+ * classify on it, so its tag is kept in an inline slot of PacketTagList.
+ */
+static const bool g_socketPriorityTagSlot = [] {
+    PacketTagList::RegisterSlot(SocketPriorityTag::GetTypeId());
+    return true;
+}();
+
 SocketPriorityTag::SocketPriorityTag()
 {
 }
@@ -22,7 +22,7 @@ NS_LOG_COMPONENT_DEFINE("TagBuffer");
 void
 TagBuffer::WriteU8(uint8_t v)
 {
-    NS_LOG_FUNCTION(this << static_cast<uint32_t>(v));
+    NS_LOG_FUNCTION_HOT(this << static_cast<uint32_t>(v));
     NS_ASSERT(m_current + 1 <= m_end);
     *m_current = v;
     m_current++;
@@ -31,7 +31,7 @@ TagBuffer::WriteU8(uint8_t v)
 void
 TagBuffer::WriteU16(uint16_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8((data >> 0) & 0xff);
     WriteU8((data >> 8) & 0xff);
 }
@@ -39,7 +39,7 @@ TagBuffer::WriteU16(uint16_t data)
 void
 TagBuffer::WriteU32(uint32_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8((data >> 0) & 0xff);
     WriteU8((data >> 8) & 0xff);
     WriteU8((data >> 16) & 0xff);
@@ -49,7 +49,7 @@ TagBuffer::WriteU32(uint32_t data)
 uint8_t
 TagBuffer::ReadU8()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     NS_ASSERT(m_current + 1 <= m_end);
     uint8_t v;
     v = *m_current;
@@ -60,7 +60,7 @@ TagBuffer::ReadU8()
 uint16_t
 TagBuffer::ReadU16()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint8_t byte0 = ReadU8();
     uint8_t byte1 = ReadU8();
     uint16_t data = byte1;
@@ -72,7 +72,7 @@ TagBuffer::ReadU16()
 uint32_t
 TagBuffer::ReadU32()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint8_t byte0 = ReadU8();
     uint8_t byte1 = ReadU8();
     uint8_t byte2 = ReadU8();
@@ -92,7 +92,7 @@ TagBuffer::ReadU32()
 void
 TagBuffer::WriteU64(uint64_t data)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION_HOT(this << data);
     WriteU8((data >> 0) & 0xff);
     WriteU8((data >> 8) & 0xff);
     WriteU8((data >> 16) & 0xff);
@@ -106,7 +106,7 @@ TagBuffer::WriteU64(uint64_t data)
 void
 TagBuffer::WriteDouble(double v)
 {
-    NS_LOG_FUNCTION(this << v);
+    NS_LOG_FUNCTION_HOT(this << v);
     auto buf = (uint8_t*)&v;
     for (uint32_t i = 0; i < sizeof(double); ++i, ++buf)
     {
@@ -117,7 +117,7 @@ TagBuffer::WriteDouble(double v)
 void
 TagBuffer::Write(const uint8_t* buffer, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << &buffer << size);
+    NS_LOG_FUNCTION_HOT(this << &buffer << size);
     for (uint32_t i = 0; i < size; ++i, ++buffer)
     {
         WriteU8(*buffer);
@@ -127,7 +127,7 @@ TagBuffer::Write(const uint8_t* buffer, uint32_t size)
 uint64_t
 TagBuffer::ReadU64()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     uint8_t byte0 = ReadU8();
     uint8_t byte1 = ReadU8();
     uint8_t byte2 = ReadU8();
@@ -158,7 +158,7 @@ TagBuffer::ReadU64()
 double
 TagBuffer::ReadDouble()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     double v;
     auto buf = (uint8_t*)&v;
     for (uint32_t i = 0; i < sizeof(double); ++i, ++buf)
@@ -171,7 +171,7 @@ TagBuffer::ReadDouble()
 void
 TagBuffer::Read(uint8_t* buffer, uint32_t size)
 {
-    NS_LOG_FUNCTION(this << &buffer << size);
+    NS_LOG_FUNCTION_HOT(this << &buffer << size);
     std::memcpy(buffer, m_current, size);
     m_current += size;
     NS_ASSERT(m_current <= m_end);
@@ -181,13 +181,13 @@ TagBuffer::TagBuffer(uint8_t* start, uint8_t* end)
     : m_current(start),
       m_end(end)
 {
-    NS_LOG_FUNCTION(this << &start << &end);
+    NS_LOG_FUNCTION_HOT(this << &start << &end);
 }
 
 void
 TagBuffer::TrimAtEnd(uint32_t trim)
 {
-    NS_LOG_FUNCTION(this << trim);
+    NS_LOG_FUNCTION_HOT(this << trim);
     NS_ASSERT(m_current <= (m_end - trim));
     m_end -= trim;
 }
@@ -195,7 +195,7 @@ TagBuffer::TrimAtEnd(uint32_t trim)
 void
 TagBuffer::CopyFrom(TagBuffer o)
 {
-    NS_LOG_FUNCTION(this << &o);
+    NS_LOG_FUNCTION_HOT(this << &o);
     NS_ASSERT(o.m_end >= o.m_current);
     NS_ASSERT(m_end >= m_current);
     uintptr_t size = o.m_end - o.m_current;
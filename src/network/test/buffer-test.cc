@@ -382,6 +382,25 @@ BufferTest::DoRun()
     val2 <<= 8;
     val2 |= i.ReadU8();
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
+
+    // overwrite in place the bytes of a shared buffer
+    buffer = Buffer(8);
+    buffer.AddAtStart(4);
+    buffer.Begin().WriteHtonU32(0x01020304);
+    Buffer shared = buffer;
+    buffer.MakeWritable();
+    i = buffer.Begin();
+    i.Next(2);
+    i.WriteU8(0xaa);
+    i = buffer.Begin();
+    NS_TEST_ASSERT_MSG_EQ(i.ReadNtohU32(), 0x0102aa04, "Bad in-place write");
+    NS_TEST_ASSERT_MSG_EQ(i.ReadU64(), 0, "Zero area changed by in-place write");
+    NS_TEST_ASSERT_MSG_EQ(shared.Begin().ReadNtohU32(),
+                          0x01020304,
+                          "In-place write changed a shared buffer");
+    buffer.AddAtStart(2);
+    buffer.Begin().WriteU16(0);
+    NS_TEST_ASSERT_MSG_EQ(buffer.GetSize(), 14, "Bad size after in-place write");
 }
 
 /**
@@ -1257,6 +1257,114 @@ PacketTagListTest::DoRun()
     }
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Packet Tag list inline slots testcase
+ */
+class PacketTagListSlotTest : public TestCase
+{
+  public:
+    PacketTagListSlotTest();
+
+  private:
+    void DoRun() override;
+    /**
+     * Checks the inline ATestTag<9> and the listed ATestTag<1> and ATestTag<2>
+     * @param ptl List to test
+     * @param slotData Expected data of the inline tag
+     * @param msg Message
+     */
+    void CheckSlotAndList(const PacketTagList& ptl, int slotData, const char* msg);
+};
+
+PacketTagListSlotTest::PacketTagListSlotTest()
+    : TestCase("PacketTagListSlotTest: ")
+{
+}
+
+void
+PacketTagListSlotTest::CheckSlotAndList(const PacketTagList& ptl, int slotData, const char* msg)
+{
+    ATestTag<9> s;
+    ATestTag<1> t1;
+    ATestTag<2> t2;
+    NS_TEST_EXPECT_MSG_EQ(ptl.Peek(s), true, msg << ": slot tag found");
+    NS_TEST_EXPECT_MSG_EQ(s.GetData(), slotData, msg << ": slot tag value");
+    NS_TEST_EXPECT_MSG_EQ(s.m_error, false, msg << ": slot tag intact");
+    NS_TEST_EXPECT_MSG_EQ(ptl.Peek(t1), true, msg << ": list tag 1 found");
+    NS_TEST_EXPECT_MSG_EQ(t1.GetData(), 1, msg << ": list tag 1 value");
+    NS_TEST_EXPECT_MSG_EQ(ptl.Peek(t2), true, msg << ": list tag 2 found");
+    NS_TEST_EXPECT_MSG_EQ(t2.GetData(), 1, msg << ": list tag 2 value");
+}
+
+void
+PacketTagListSlotTest::DoRun()
+{
+    // ATestTag<9> is kept inline, the others in the list
+    PacketTagList::RegisterSlot(ATestTag<9>::GetTypeId());
+    ATestTag<9> s(1);
+    ATestTag<1> t1(1);
+    ATestTag<2> t2(1);
+
+    PacketTagList ref;
+    ref.Add(t1);
+    ref.Add(s);
+    ref.Add(t2);
+
+    ATestTag<9> peek;
+    CheckSlotAndList(ref, 1, "ref");
+
+    // A copy holds its own slots
+    PacketTagList copy = ref;
+    s.m_data = 2;
+    NS_TEST_EXPECT_MSG_EQ(copy.Replace(s), true, "replace existing slot tag");
+    CheckSlotAndList(copy, 2, "copy after replace");
+    CheckSlotAndList(ref, 1, "ref after replace of copy");
+
+    ATestTag<9> removed;
+    NS_TEST_EXPECT_MSG_EQ(copy.Remove(removed), true, "remove slot tag");
+    NS_TEST_EXPECT_MSG_EQ(removed.GetData(), 2, "removed slot tag value");
+    NS_TEST_EXPECT_MSG_EQ(copy.Peek(peek), false, "slot tag removed");
+    NS_TEST_EXPECT_MSG_EQ(copy.Remove(removed), false, "remove missing slot tag");
+    NS_TEST_EXPECT_MSG_EQ(copy.Replace(s), false, "replace adds missing slot tag");
+    CheckSlotAndList(copy, 2, "copy after re-add");
+
+    copy = ref;
+    CheckSlotAndList(copy, 1, "assignment");
+
+    // Serialization keeps slot and list tags
+    std::vector<uint32_t> buffer(ref.GetSerializedSize() / 4);
+    NS_TEST_EXPECT_MSG_EQ(ref.Serialize(buffer.data(), buffer.size() * 4), 1, "serialize");
+    PacketTagList deserialized;
+    NS_TEST_EXPECT_MSG_EQ(deserialized.Deserialize(buffer.data(), buffer.size() * 4 + 4),
+                          1,
+                          "deserialize");
+    CheckSlotAndList(deserialized, 1, "deserialized");
+
+    // The packet tag iterator visits slot and list tags
+    Ptr<Packet> p = Create<Packet>(10);
+    p->AddPacketTag(t1);
+    p->AddPacketTag(s);
+    uint32_t count = 0;
+    bool slotSeen = false;
+    PacketTagIterator i = p->GetPacketTagIterator();
+    while (i.HasNext())
+    {
+        PacketTagIterator::Item item = i.Next();
+        if (item.GetTypeId() == ATestTag<9>::GetTypeId())
+        {
+            ATestTag<9> tag;
+            item.GetTag(tag);
+            slotSeen = tag.GetData() == 2 && !tag.m_error;
+        }
+        count++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(count, 2, "iterator visits every tag");
+    NS_TEST_EXPECT_MSG_EQ(slotSeen, true, "iterator reads slot tag");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1382,7 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketTagListSlotTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
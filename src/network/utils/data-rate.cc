@@ -219,21 +219,21 @@ DataRate::operator!=(const DataRate& rhs) const
 Time
 DataRate::CalculateBytesTxTime(uint32_t bytes) const
 {
-    NS_LOG_FUNCTION(this << bytes);
+    NS_LOG_FUNCTION_HOT(this << bytes);
     return CalculateBitsTxTime(bytes * 8);
 }
 
 Time
 DataRate::CalculateBitsTxTime(uint32_t bits) const
 {
-    NS_LOG_FUNCTION(this << bits);
+    NS_LOG_FUNCTION_HOT(this << bits);
     return Seconds(int64x64_t(bits) / m_bps);
 }
 
 uint64_t
 DataRate::GetBitRate() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
     return m_bps;
 }
 
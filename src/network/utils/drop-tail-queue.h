@@ -89,7 +89,7 @@ template <typename Item>
 bool
 DropTailQueue<Item>::Enqueue(Ptr<Item> item)
 {
-    NS_LOG_FUNCTION(this << item);
+    NS_LOG_FUNCTION_HOT(this << item);
 
     return DoEnqueue(GetContainer().end(), item);
 }
@@ -98,11 +98,11 @@ template <typename Item>
 Ptr<Item>
 DropTailQueue<Item>::Dequeue()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     Ptr<Item> item = DoDequeue(GetContainer().begin());
 
-    NS_LOG_LOGIC("Popped " << item);
+    NS_LOG_LOGIC_HOT("Popped " << item);
 
     return item;
 }
@@ -111,11 +111,11 @@ template <typename Item>
 Ptr<Item>
 DropTailQueue<Item>::Remove()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     Ptr<Item> item = DoRemove(GetContainer().begin());
 
-    NS_LOG_LOGIC("Removed " << item);
+    NS_LOG_LOGIC_HOT("Removed " << item);
 
     return item;
 }
@@ -124,7 +124,7 @@ template <typename Item>
 Ptr<const Item>
 DropTailQueue<Item>::Peek() const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     return DoPeek(GetContainer().begin());
 }
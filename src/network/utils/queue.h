@@ -507,11 +507,11 @@ template <typename Item, typename Container>
 bool
 Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& ret)
 {
-    NS_LOG_FUNCTION(this << item);
+    NS_LOG_FUNCTION_HOT(this << item);
 
     if (GetCurrentSize() + item > GetMaxSize())
     {
-        NS_LOG_LOGIC("Queue full -- dropping pkt");
+        NS_LOG_LOGIC_HOT("Queue full -- dropping pkt");
         DropBeforeEnqueue(item);
         return false;
     }
@@ -525,7 +525,7 @@ Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& r
     m_nPackets++;
     m_nTotalReceivedPackets++;
 
-    NS_LOG_LOGIC("m_traceEnqueue (p)");
+    NS_LOG_LOGIC_HOT("m_traceEnqueue (p)");
     m_traceEnqueue(item);
 
     return true;
@@ -535,11 +535,11 @@ template <typename Item, typename Container>
 Ptr<Item>
 Queue<Item, Container>::DoDequeue(ConstIterator pos)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     if (m_nPackets.Get() == 0)
     {
-        NS_LOG_LOGIC("Queue empty");
+        NS_LOG_LOGIC_HOT("Queue empty");
         return nullptr;
     }
 
@@ -554,7 +554,7 @@ Queue<Item, Container>::DoDequeue(ConstIterator pos)
         m_nBytes -= item->GetSize();
         m_nPackets--;
 
-        NS_LOG_LOGIC("m_traceDequeue (p)");
+        NS_LOG_LOGIC_HOT("m_traceDequeue (p)");
         m_traceDequeue(item);
     }
     return item;
@@ -564,11 +564,11 @@ template <typename Item, typename Container>
 Ptr<Item>
 Queue<Item, Container>::DoRemove(ConstIterator pos)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     if (m_nPackets.Get() == 0)
     {
-        NS_LOG_LOGIC("Queue empty");
+        NS_LOG_LOGIC_HOT("Queue empty");
         return nullptr;
     }
 
@@ -584,7 +584,7 @@ Queue<Item, Container>::DoRemove(ConstIterator pos)
         m_nPackets--;
 
         // packets are first dequeued and then dropped
-        NS_LOG_LOGIC("m_traceDequeue (p)");
+        NS_LOG_LOGIC_HOT("m_traceDequeue (p)");
         m_traceDequeue(item);
 
         DropAfterDequeue(item);
@@ -616,11 +616,11 @@ template <typename Item, typename Container>
 Ptr<const Item>
 Queue<Item, Container>::DoPeek(ConstIterator pos) const
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     if (m_nPackets.Get() == 0)
     {
-        NS_LOG_LOGIC("Queue empty");
+        NS_LOG_LOGIC_HOT("Queue empty");
         return nullptr;
     }
 
@@ -631,14 +631,14 @@ template <typename Item, typename Container>
 void
 Queue<Item, Container>::DropBeforeEnqueue(Ptr<Item> item)
 {
-    NS_LOG_FUNCTION(this << item);
+    NS_LOG_FUNCTION_HOT(this << item);
 
     m_nTotalDroppedPackets++;
     m_nTotalDroppedPacketsBeforeEnqueue++;
     m_nTotalDroppedBytes += item->GetSize();
     m_nTotalDroppedBytesBeforeEnqueue += item->GetSize();
 
-    NS_LOG_LOGIC("m_traceDropBeforeEnqueue (p)");
+    NS_LOG_LOGIC_HOT("m_traceDropBeforeEnqueue (p)");
     m_traceDrop(item);
     m_traceDropBeforeEnqueue(item);
 }
@@ -647,14 +647,14 @@ template <typename Item, typename Container>
 void
 Queue<Item, Container>::DropAfterDequeue(Ptr<Item> item)
 {
-    NS_LOG_FUNCTION(this << item);
+    NS_LOG_FUNCTION_HOT(this << item);
 
     m_nTotalDroppedPackets++;
     m_nTotalDroppedPacketsAfterDequeue++;
     m_nTotalDroppedBytes += item->GetSize();
     m_nTotalDroppedBytesAfterDequeue += item->GetSize();
 
-    NS_LOG_LOGIC("m_traceDropAfterDequeue (p)");
+    NS_LOG_LOGIC_HOT("m_traceDropAfterDequeue (p)");
     m_traceDrop(item);
     m_traceDropAfterDequeue(item);
 }
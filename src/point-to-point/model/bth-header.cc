@@ -124,6 +124,18 @@ BthHeader::SetNACK()
     m_flags |= (0x01 << 2);
 }
 
+uint8_t
+BthHeader::GetTrim()
+{
+    return (m_flags >> 3) & 0x01;
+}
+
+void
+BthHeader::SetTrim()
+{
+    m_flags |= (0x01 << 3);
+}
+
 uint16_t
 BthHeader::GetSize()
 {
@@ -33,6 +33,9 @@ public:
     uint8_t GetNACK();
     void SetNACK();
 
+    uint8_t GetTrim();
+    void SetTrim();
+
     uint16_t GetSize();
     void SetSize(uint16_t size);
 
@@ -0,0 +1,41 @@
+#include "buffer-sampler.h"
+
+#include "ns3/abort.h"
+
+#include <iostream>
+
+namespace ns3
+{
+
+static_assert(sizeof(BufferSampler::Record) == 32, "BufferSampler::Record is the file format");
+
+BufferSampler::BufferSampler(std::string file, uint32_t capacity)
+    : m_ring(capacity)
+{
+    NS_ABORT_MSG_IF(capacity == 0, "BufferSampler needs room for a record");
+    m_file = fopen(file.c_str(), "wb");
+    NS_ABORT_MSG_IF(m_file == nullptr, "Cannot open buffer samples " << file);
+}
+
+BufferSampler::~BufferSampler()
+{
+    Flush();
+    fclose(m_file);
+}
+
+void
+BufferSampler::Flush()
+{
+    if(m_size > 0 && fwrite(m_ring.data(), sizeof(Record), m_size, m_file) != m_size)
+        std::cerr << "BufferSampler: failed to write " << m_size << " records" << std::endl;
+    m_written += m_size;
+    m_size = 0;
+}
+
+uint64_t
+BufferSampler::GetNRecords() const
+{
+    return m_written + m_size;
+}
+
+} // namespace ns3
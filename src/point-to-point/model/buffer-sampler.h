@@ -0,0 +1,77 @@
+#ifndef BUFFER_SAMPLER_H
+#define BUFFER_SAMPLER_H
+
+#include "ns3/simple-ref-count.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Time series of switch buffer occupancy, shared by the switches of a run.
+ *
+ * Samples are copied into a ring of records allocated up front, and the ring
+ * is written to the file with one fwrite each time it fills and when the
+ * sampler is destroyed. The file is the records back to back, in host byte
+ * order, as read by commands/buffer.py.
+ */
+class BufferSampler : public SimpleRefCount<BufferSampler>
+{
+public:
+    /** What took a sample */
+    enum Trigger : uint16_t
+    {
+        PERIODIC = 0,
+        CHANGE = 1,
+    };
+
+    /** One sample of a switch port, 32 bytes */
+    struct Record
+    {
+        uint64_t time;    /**< ns */
+        uint32_t node;    /**< switch ID */
+        uint16_t port;    /**< interface index */
+        uint16_t trigger; /**< a Trigger */
+        int32_t egress;   /**< bytes queued at the port */
+        int32_t ingress;  /**< bytes from the port, in its reserved and shared buffer */
+        int32_t headroom; /**< bytes from the port in its PFC headroom */
+        int32_t shared;   /**< bytes of the shared pool used by the switch */
+    };
+
+    /** Records in the ring, 2MB */
+    static const uint32_t DEFAULT_CAPACITY = 1 << 16;
+
+    /**
+     * \param file the file to write, truncated
+     * \param capacity the records kept before each write
+     */
+    BufferSampler(std::string file, uint32_t capacity = DEFAULT_CAPACITY);
+    ~BufferSampler();
+
+    void Add(const Record& record)
+    {
+        m_ring[m_size++] = record;
+        if(m_size == m_ring.size())
+            Flush();
+    }
+
+    /** Write the records in the ring to the file */
+    void Flush();
+
+    /** The records added so far */
+    uint64_t GetNRecords() const;
+
+private:
+    FILE* m_file;
+    std::vector<Record> m_ring;
+    uint32_t m_size{0};    /**< records in the ring */
+    uint64_t m_written{0}; /**< records written to the file */
+};
+
+} // namespace ns3
+
+#endif /* BUFFER_SAMPLER_H */
@@ -0,0 +1,109 @@
+#include "grant-header.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/header.h"
+#include "ns3/log.h"
+
+#include <iostream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("GrantHeader");
+
+NS_OBJECT_ENSURE_REGISTERED(GrantHeader);
+
+GrantHeader::GrantHeader()
+{
+    m_size = 0;
+    m_offset = 0;
+    m_priority = 0;
+}
+
+GrantHeader::~GrantHeader()
+{
+}
+
+TypeId
+GrantHeader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::GrantHeader")
+                            .SetParent<Header>()
+                            .SetGroupName("PointToPoint")
+                            .AddConstructor<GrantHeader>();
+    return tid;
+}
+
+TypeId
+GrantHeader::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+GrantHeader::Print(std::ostream& os) const
+{
+    os << "size=" << m_size << " offset=" << m_offset << " priority=" << (uint32_t)m_priority;
+}
+
+uint32_t
+GrantHeader::GetSerializedSize() const
+{
+    return 9;
+}
+
+void
+GrantHeader::Serialize(Buffer::Iterator start) const
+{
+    start.WriteHtonU32(m_size);
+    start.WriteHtonU32(m_offset);
+    start.WriteU8(m_priority);
+}
+
+uint32_t
+GrantHeader::Deserialize(Buffer::Iterator start)
+{
+    m_size = start.ReadNtohU32();
+    m_offset = start.ReadNtohU32();
+    m_priority = start.ReadU8();
+    return GetSerializedSize();
+}
+
+void
+GrantHeader::SetSize(uint32_t size)
+{
+    m_size = size;
+}
+
+uint32_t
+GrantHeader::GetSize() const
+{
+    return m_size;
+}
+
+void
+GrantHeader::SetOffset(uint32_t offset)
+{
+    m_offset = offset;
+}
+
+uint32_t
+GrantHeader::GetOffset() const
+{
+    return m_offset;
+}
+
+void
+GrantHeader::SetPriority(uint8_t priority)
+{
+    m_priority = priority;
+}
+
+uint8_t
+GrantHeader::GetPriority() const
+{
+    return m_priority;
+}
+
+} // namespace ns3
@@ -0,0 +1,48 @@
+#ifndef GRANT_HEADER_H
+#define GRANT_HEADER_H
+
+#include "ns3/header.h"
+
+namespace ns3
+{
+
+/**
+ * Header for receiver-driven transport (cc = 5).
+ *
+ * On data packets, size is the message length and offset is the number of
+ * unscheduled bytes the sender was allowed to send (its RTT bytes).
+ * On ACK/grant packets, offset is the byte the sender may send up to and
+ * priority is the queue the scheduled packets should use.
+ */
+class GrantHeader : public Header
+{
+public:
+    GrantHeader();
+    ~GrantHeader() override;
+
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    void Print(std::ostream& os) const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+    uint32_t GetSerializedSize() const override;
+
+    void SetSize(uint32_t size);
+    uint32_t GetSize() const;
+
+    void SetOffset(uint32_t offset);
+    uint32_t GetOffset() const;
+
+    void SetPriority(uint8_t priority);
+    uint8_t GetPriority() const;
+
+private:
+    uint32_t m_size;
+    uint32_t m_offset;
+    uint8_t m_priority;
+};
+
+} // namespace ns3
+
+#endif /* GRANT_HEADER_H */
@@ -6,6 +6,7 @@
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 
+#include <cstdlib>
 #include <iostream>
 
 namespace ns3
@@ -15,16 +16,71 @@ NS_LOG_COMPONENT_DEFINE("HpccHeader");
 
 NS_OBJECT_ENSURE_REGISTERED(HpccHeader);
 
+namespace
+{
+
+/** Width in bits and unit of every INT field, for one encoding */
+struct IntFormat
+{
+    uint8_t rateBits;
+    uint64_t rateUnit; // bps
+    uint8_t timeBits;
+    uint64_t timeUnit; // ns
+    uint8_t bytesBits;
+    uint64_t bytesUnit;
+    uint8_t queueBits;
+    uint64_t queueUnit; // bytes
+};
+
+/** By IntHeader::Encoding */
+const IntFormat g_intFormats[] = {
+    {4, 100000000000ULL, 24, 16, 20, 512, 16, 64},
+    {24, 1000000, 40, 1, 40, 1, 24, 8},
+};
+
+IntHeader::Encoding g_intEncoding = IntHeader::COMPACT;
+bool g_pint = false;
+uint8_t g_hops = 5;
+
+const IntFormat&
+Format()
+{
+    return g_intFormats[g_intEncoding];
+}
+
+/** The count of units in value, wrapped to a field of the given width */
+uint64_t
+ToField(uint64_t value, uint64_t unit, uint8_t bits)
+{
+    return (value / unit) & ((1ULL << bits) - 1);
+}
+
+} // namespace
+
 IntHeader::IntHeader()
+    : m_rate(0),
+      m_time(0),
+      m_bytes(0),
+      m_queueLen(0)
 {
-    m_data[0] = 0;
-    m_data[1] = 0;
 }
 
 IntHeader::~IntHeader()
 {
 }
 
+void
+IntHeader::SetEncoding(Encoding encoding)
+{
+    g_intEncoding = encoding;
+}
+
+IntHeader::Encoding
+IntHeader::GetEncoding()
+{
+    return g_intEncoding;
+}
+
 TypeId
 IntHeader::GetTypeId()
 {
@@ -50,21 +106,41 @@ IntHeader::Print(std::ostream& os) const
 uint32_t
 IntHeader::GetSerializedSize() const
 {
-    return 8; // 8 bytes
+    const IntFormat& format = Format();
+    return (format.rateBits + format.timeBits + format.bytesBits + format.queueBits) / 8;
 }
 
 void
 IntHeader::Serialize(Buffer::Iterator start) const
 {
-    start.WriteHtonU32(m_data[0]);
-    start.WriteHtonU32(m_data[1]);
+    // The fields packed from the low bits up, written as 32-bit words from the low word up
+    const IntFormat& format = Format();
+    unsigned __int128 fields = m_queueLen;
+    fields = (fields << format.bytesBits) | m_bytes;
+    fields = (fields << format.timeBits) | m_time;
+    fields = (fields << format.rateBits) | m_rate;
+    for (uint32_t i = 0; i < GetSerializedSize() / 4; ++i)
+    {
+        start.WriteHtonU32(fields >> (32 * i));
+    }
 }
 
 uint32_t
 IntHeader::Deserialize(Buffer::Iterator start)
 {
-    m_data[0] = start.ReadNtohU32();
-    m_data[1] = start.ReadNtohU32();
+    const IntFormat& format = Format();
+    unsigned __int128 fields = 0;
+    for (uint32_t i = 0; i < GetSerializedSize() / 4; ++i)
+    {
+        fields |= (unsigned __int128)start.ReadNtohU32() << (32 * i);
+    }
+    m_rate = fields & ((1ULL << format.rateBits) - 1);
+    fields >>= format.rateBits;
+    m_time = fields & ((1ULL << format.timeBits) - 1);
+    fields >>= format.timeBits;
+    m_bytes = fields & ((1ULL << format.bytesBits) - 1);
+    fields >>= format.bytesBits;
+    m_queueLen = fields & ((1ULL << format.queueBits) - 1);
     return GetSerializedSize();
 }
 
@@ -80,49 +156,49 @@ IntHeader::Set(DataRate rate, uint64_t bytes, uint64_t queueLen)
 void
 IntHeader::SetRate(DataRate rate)
 {
-    m_fields.m_rate = rate.GetBitRate() / 1e11; // in 100Gbps units
+    m_rate = ToField(rate.GetBitRate(), Format().rateUnit, Format().rateBits);
 }
 
 DataRate
 IntHeader::GetRate() const
 {
-    return DataRate(m_fields.m_rate * 1e11);
+    return DataRate(m_rate * Format().rateUnit);
 }
 
 void
 IntHeader::SetTime()
 {
-    m_fields.m_time = Simulator::Now().GetNanoSeconds() / 16; // in 16ns units
+    m_time = ToField(Simulator::Now().GetNanoSeconds(), Format().timeUnit, Format().timeBits);
 }
 
 uint64_t
 IntHeader::GetTime() const
 {
-    return m_fields.m_time * 16;
+    return m_time * Format().timeUnit;
 }
 
 void
 IntHeader::SetBytes(uint64_t bytes)
 {
-    m_fields.m_bytes = bytes / 512; // in 512B units
+    m_bytes = ToField(bytes, Format().bytesUnit, Format().bytesBits);
 }
 
 uint64_t
 IntHeader::GetBytes() const
 {
-    return m_fields.m_bytes * 512;
+    return m_bytes * Format().bytesUnit;
 }
 
 void
 IntHeader::SetQueueLen(uint64_t queueLen)
 {
-    m_fields.m_queueLen = queueLen / 64; // in 64B units
+    m_queueLen = ToField(queueLen, Format().queueUnit, Format().queueBits);
 }
 
 uint64_t
 IntHeader::GetQueueLen() const
 {
-    return m_fields.m_queueLen * 64;
+    return m_queueLen * Format().queueUnit;
 }
 
 uint64_t
@@ -130,7 +206,7 @@ IntHeader::GetBytesDelta(const IntHeader& old) const
 {
     if(GetBytes() < old.GetBytes())
     {
-        uint64_t maxBytes = (1ULL << 20) * 512; // 20 bits for bytes in 512B units
+        uint64_t maxBytes = (1ULL << Format().bytesBits) * Format().bytesUnit;
         if(GetBytes() + maxBytes < old.GetBytes())
         {
             std::cerr << "IntHeader::GetBytesDelta: byte count wrap-around too large!" << std::endl;
@@ -145,7 +221,7 @@ IntHeader::GetTimeDelta(const IntHeader& old) const
 {
     if(GetTime() < old.GetTime())
     {
-        uint64_t maxTime = (1ULL << 24) * 16; // 24 bits for time in 16ns units
+        uint64_t maxTime = (1ULL << Format().timeBits) * Format().timeUnit;
         if(GetTime() + maxTime < old.GetTime())
         {
             std::cerr << "IntHeader::GetTimeDelta: time count wrap-around too large!" << std::endl;
@@ -159,12 +235,40 @@ IntHeader::GetTimeDelta(const IntHeader& old) const
 HpccHeader::HpccHeader()
 {
     m_hops = 0;
+    m_sampledHop = 0;
 }
 
 HpccHeader::~HpccHeader()
 {
 }
 
+void
+HpccHeader::SetPint(bool pint)
+{
+    g_pint = pint;
+}
+
+bool
+HpccHeader::GetPint()
+{
+    return g_pint;
+}
+
+void
+HpccHeader::SetHops(uint8_t hops)
+{
+    NS_ABORT_MSG_IF(hops == 0 || hops > MAX_HOPS,
+                    "HPCC INT slots must be 1 to " << (uint32_t)MAX_HOPS << ", not "
+                                                   << (uint32_t)hops);
+    g_hops = hops;
+}
+
+uint8_t
+HpccHeader::GetHops()
+{
+    return g_hops;
+}
+
 TypeId
 HpccHeader::GetTypeId()
 {
@@ -190,22 +294,25 @@ HpccHeader::Print(std::ostream& os) const
 uint32_t
 HpccHeader::GetSerializedSize() const
 {
-    uint32_t size = 1; // for hops
-    for (const auto& intHeader : m_intHeaders)
-    {
-        size += intHeader.GetSerializedSize();
-    }
-    return size;
+    if(g_pint)
+        return 2 + m_intHeaders[0].GetSerializedSize(); // hops, sampled hop, then the slot
+    return 1 + g_hops * m_intHeaders[0].GetSerializedSize(); // hops, then the slots
 }
 
 void
 HpccHeader::Serialize(Buffer::Iterator start) const
 {
     start.WriteU8(m_hops);
-    for (const auto& intHeader : m_intHeaders)
+    if(g_pint)
+    {
+        start.WriteU8(m_sampledHop);
+        m_intHeaders[0].Serialize(start);
+        return;
+    }
+    for (uint8_t i = 0; i < g_hops; ++i)
     {
-        intHeader.Serialize(start);
-        start.Next(intHeader.GetSerializedSize());
+        m_intHeaders[i].Serialize(start);
+        start.Next(m_intHeaders[i].GetSerializedSize());
     }
 }
 
@@ -213,12 +320,16 @@ uint32_t
 HpccHeader::Deserialize(Buffer::Iterator start)
 {
     m_hops = start.ReadU8();
-    for(uint8_t i = 0; i < abs(m_hops); ++i)
+    if(g_pint)
+    {
+        m_sampledHop = start.ReadU8();
+        m_intHeaders[0].Deserialize(start);
+        return GetSerializedSize();
+    }
+    for (uint8_t i = 0; i < g_hops; ++i)
     {
-        IntHeader intHeader;
-        intHeader.Deserialize(start);
-        m_intHeaders.push_back(intHeader);
-        start.Next(intHeader.GetSerializedSize());
+        m_intHeaders[i].Deserialize(start);
+        start.Next(m_intHeaders[i].GetSerializedSize());
     }
     return GetSerializedSize();
 }
@@ -231,22 +342,73 @@ HpccHeader::PushIntHeader(DataRate rate, uint64_t bytes, uint64_t queueLen)
         std::cerr << "HpccHeader::PushIntHeader: cannot add more INT headers!" << std::endl;
         return;
     }
-    IntHeader intHeader;
-    intHeader.Set(rate, bytes, queueLen);
-    m_intHeaders.push_back(intHeader);
+    // Keeps the last hop with PINT
+    m_sampledHop = m_hops;
+    m_intHeaders[g_pint ? 0 : m_hops].Set(rate, bytes, queueLen);
     m_hops += 1;
 }
 
-std::vector<IntHeader>
-HpccHeader::GetIntHeaders() const
+void
+HpccHeader::PushIntHeader(Buffer::Iterator start, DataRate rate, uint64_t bytes, uint64_t queueLen,
+                          UniformRandomVariable* sampler)
+{
+    Buffer::Iterator slot = start;
+    int8_t hops = slot.ReadU8();
+    if(hops < 0)
+        return;
+    if(hops >= g_hops){
+        static bool warned = false;
+        if(!warned){
+            std::cerr << "HPCC path longer than " << (uint32_t)g_hops
+                      << " switches, the INT of further switches is not stamped" << std::endl;
+            warned = true;
+        }
+        return;
+    }
+
+    IntHeader intHeader;
+    if(g_pint)
+    {
+        // Reservoir sampling: hop n replaces the sample with probability 1/n
+        NS_ASSERT_MSG(sampler != nullptr, "PINT needs a sampler");
+        if(sampler->GetInteger(0, hops) == 0)
+        {
+            slot.WriteU8(hops);
+            intHeader.Set(rate, bytes, queueLen);
+            intHeader.Serialize(slot);
+        }
+    }
+    else
+    {
+        intHeader.Set(rate, bytes, queueLen);
+        slot.Next(hops * intHeader.GetSerializedSize());
+        intHeader.Serialize(slot);
+    }
+    start.WriteU8(hops + 1);
+}
+
+uint8_t
+HpccHeader::GetNHops() const
+{
+    return std::abs(m_hops);
+}
+
+uint8_t
+HpccHeader::GetSampledHop() const
+{
+    return m_sampledHop;
+}
+
+const IntHeader&
+HpccHeader::GetIntHeader(uint8_t hop) const
 {
-    return m_intHeaders;
+    return m_intHeaders[g_pint ? 0 : hop];
 }
 
 bool
 HpccHeader::CanAddIntHeader() const
 {
-    return m_hops >= 0;
+    return m_hops >= 0 && m_hops < g_hops;
 }
 
 void
@@ -4,16 +4,40 @@
 #include "ns3/header.h"
 #include "ns3/uinteger.h"
 #include "ns3/data-rate.h"
+#include "ns3/random-variable-stream.h"
 
 namespace ns3
 {
 
+/**
+ * One hop of In-band Network Telemetry: the rate, time, transmitted bytes and
+ * queue length of an egress port.
+ *
+ * Every field is a count of fixed units that wraps at the width of the field,
+ * as set by the encoding shared by all INT slots. Over a path of 400 or
+ * 800Gbps links the compact encoding wraps the bytes every 10.7 or 5.4ms and
+ * the queue length at 4MB, has no rate below 100Gbps, and quantizes a 4KB
+ * packet by up to 512B and 16ns, 13% of its size and 20% (400G) or 40% (800G)
+ * of its transmit time. The wide encoding takes twice the bytes for exact
+ * bytes and time, 1Mbps rate steps and queues up to 128MB.
+ */
 class IntHeader : public Header
 {
 public:
+    /** Field layouts of an INT slot */
+    enum Encoding
+    {
+        COMPACT = 0, /**< 8 bytes: 4-bit rate, 24-bit time, 20-bit bytes, 16-bit queue */
+        WIDE = 1,    /**< 16 bytes: 24-bit rate, 40-bit time, 40-bit bytes, 24-bit queue */
+    };
+
     IntHeader();
 	~IntHeader() override;
 
+    /** Set the layout of every INT slot, before the simulation starts */
+    static void SetEncoding(Encoding encoding);
+    static Encoding GetEncoding();
+
     static TypeId GetTypeId();
     TypeId GetInstanceTypeId() const override;
 
@@ -40,24 +64,48 @@ public:
     uint64_t GetTimeDelta(const IntHeader& old) const;
 
 private:
-    union{
-        struct{
-            uint64_t m_rate : 4,
-                    m_time : 24,
-                    m_bytes : 20,
-                    m_queueLen : 16;
-        } m_fields;
-        uint32_t m_data[2];
-    };
+    // In units of the encoding, wrapped to the field width
+    uint64_t m_rate;
+    uint64_t m_time;
+    uint64_t m_bytes;
+    uint64_t m_queueLen;
 };
 
 
+/**
+ * HPCC header: a hop count and a fixed-capacity stack of INT slots.
+ *
+ * The source reserves a slot for each of GetHops() switches, so switches
+ * stamp their INT in place in the packet, at a fixed offset, rather than
+ * removing and adding back the headers in front of a growing stack. Switches
+ * past the last slot leave the header as it is. A negative hop count stops
+ * the stamping, on the ACK that echoes the INT to the source.
+ *
+ * With PINT the header carries a single slot, 2 bytes and one INT slot in
+ * place of 1 byte and GetHops() slots (10 rather than 41 bytes, compact, 5 hops).
+ * Each switch overwrites it with probability 1/hop, so the slot holds a hop
+ * of the path drawn uniformly, and the source keeps the last INT of each hop.
+ */
 class HpccHeader : public Header
 {
 public:
     HpccHeader();
 	~HpccHeader() override;
 
+    /** Most INT slots a header can hold */
+    static const uint8_t MAX_HOPS = 8;
+
+    /**
+     * Set the INT slots of every HPCC packet, one per switch of the longest
+     * path and at most MAX_HOPS, before the simulation starts. 5 by default.
+     */
+    static void SetHops(uint8_t hops);
+    static uint8_t GetHops();
+
+    /** Carry the INT of one sampled hop, before the simulation starts */
+    static void SetPint(bool pint);
+    static bool GetPint();
+
     static TypeId GetTypeId();
     TypeId GetInstanceTypeId() const override;
 
@@ -68,7 +116,21 @@ public:
 
     void PushIntHeader(DataRate rate, uint64_t bytes, uint64_t queueLen);
 
-    std::vector<IntHeader> GetIntHeaders() const;
+    /**
+     * Stamp the INT of the next hop in place, writing only its slot and the
+     * hop count. Does nothing if the header stops stamping.
+     *
+     * \param start iterator at the HPCC header, from Packet::BeginWritable
+     * \param sampler draws whether the hop replaces the PINT sample, needed only with PINT
+     */
+    static void PushIntHeader(Buffer::Iterator start, DataRate rate, uint64_t bytes, uint64_t queueLen,
+                              UniformRandomVariable* sampler = nullptr);
+
+    uint8_t GetNHops() const;
+    /** The hop of the PINT sample */
+    uint8_t GetSampledHop() const;
+    /** The INT of a hop, which must be the sampled hop with PINT */
+    const IntHeader& GetIntHeader(uint8_t hop) const;
 
     bool CanAddIntHeader() const;
 
@@ -76,7 +138,8 @@ public:
 
 private:
     int8_t m_hops;
-    std::vector<IntHeader> m_intHeaders;
+    uint8_t m_sampledHop;
+    IntHeader m_intHeaders[MAX_HOPS]; /**< the first GetHops(), only the first with PINT */
 };
 
 } // namespace ns3
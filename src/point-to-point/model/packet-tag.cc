@@ -3,11 +3,9 @@
 #include "ns3/abort.h"
 #include "ns3/assert.h"
 #include "ns3/tag.h"
-#include "ns3/node.h"
 #include "ns3/nstime.h"
 #include "ns3/log.h"
-
-#include "point-to-point-net-device.h"
+#include "ns3/packet-tag-list.h"
 
 #include <iostream>
 
@@ -17,7 +15,18 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("PacketTag");
 
 NS_OBJECT_ENSURE_REGISTERED(PacketTag);
-
+NS_OBJECT_ENSURE_REGISTERED(TrainTag);
+
+/**
+ * The tags replaced or peeked at every hop of the RDMA path are kept in
+ * the inline slots of PacketTagList, next to the SocketPriorityTag slot
+ * of the network module.
+ */
+static const bool g_packetTagSlots = [] {
+    PacketTagList::RegisterSlot(PacketTag::GetTypeId());
+    PacketTagList::RegisterSlot(TrainTag::GetTypeId());
+    return true;
+}();
 
 TypeId
 PacketTag::GetTypeId()
@@ -37,7 +46,7 @@ PacketTag::GetInstanceTypeId() const
 uint32_t
 PacketTag::GetSerializedSize() const
 {
-    return 24;
+    return 20;
 }
 
 void
@@ -47,7 +56,7 @@ PacketTag::Serialize(TagBuffer i) const
     i.WriteU32(m_reserve);
     i.WriteU32(m_share);
     i.WriteU32(m_hdrm);
-    i.WriteU64(reinterpret_cast<uint64_t>(GetPointer(m_device)));
+    i.WriteU32(m_port);
 }
 
 void
@@ -57,7 +66,7 @@ PacketTag::Deserialize(TagBuffer i)
     m_reserve = i.ReadU32();
     m_share = i.ReadU32();
     m_hdrm = i.ReadU32();
-    m_device = (PointToPointNetDevice*)(i.ReadU64());
+    m_port = i.ReadU32();
 }
 
 void 
@@ -108,16 +117,16 @@ PacketTag::GetHdrm()
     return m_hdrm;
 }
 
-void 
-PacketTag::SetNetDevice(Ptr<PointToPointNetDevice> device)
+void
+PacketTag::SetPort(uint32_t port)
 {
-    m_device = device;
+    m_port = port;
 }
 
-Ptr<PointToPointNetDevice> 
-PacketTag::GetNetDevice()
+uint32_t
+PacketTag::GetPort()
 {
-    return m_device;
+    return m_port;
 }
 
 void
@@ -126,4 +135,97 @@ PacketTag::Print(std::ostream& os) const
     return;
 }
 
+TypeId
+TrainTag::GetTypeId()
+{
+    static TypeId tid = TypeId("TrainTag")
+                            .SetParent<Tag>()
+                            .AddConstructor<TrainTag>();
+    return tid;
+}
+
+TypeId
+TrainTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+uint32_t
+TrainTag::GetSerializedSize() const
+{
+    return 24;
+}
+
+void
+TrainTag::Serialize(TagBuffer i) const
+{
+    i.WriteU32(m_segments);
+    i.WriteU32(m_segmentSize);
+    i.WriteU64(m_gap);
+    i.WriteU64(m_id);
+}
+
+void
+TrainTag::Deserialize(TagBuffer i)
+{
+    m_segments = i.ReadU32();
+    m_segmentSize = i.ReadU32();
+    m_gap = i.ReadU64();
+    m_id = i.ReadU64();
+}
+
+void
+TrainTag::SetSegments(uint32_t segments)
+{
+    m_segments = segments;
+}
+
+uint32_t
+TrainTag::GetSegments() const
+{
+    return m_segments;
+}
+
+void
+TrainTag::SetSegmentSize(uint32_t size)
+{
+    m_segmentSize = size;
+}
+
+uint32_t
+TrainTag::GetSegmentSize() const
+{
+    return m_segmentSize;
+}
+
+void
+TrainTag::SetGap(Time gap)
+{
+    m_gap = gap.GetTimeStep();
+}
+
+Time
+TrainTag::GetGap() const
+{
+    return TimeStep(m_gap);
+}
+
+void
+TrainTag::SetId(uint64_t id)
+{
+    m_id = id;
+}
+
+uint64_t
+TrainTag::GetId() const
+{
+    return m_id;
+}
+
+void
+TrainTag::Print(std::ostream& os) const
+{
+    os << "segments=" << m_segments << " size=" << m_segmentSize;
+}
+
 } // namespace ns3
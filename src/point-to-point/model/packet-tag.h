@@ -2,12 +2,16 @@
 #define PACKET_TAG_H
 
 #include "ns3/tag.h"
-#include "ns3/node.h"
-#include "point-to-point-net-device.h"
+#include "ns3/nstime.h"
 
 namespace ns3
 {
 
+/**
+ * Buffer accounting of a packet in a switch: its size, the buffer regions
+ * it was charged to and the ingress port, by interface index, so that the
+ * tag holds no reference and copies as plain bytes.
+ */
 class PacketTag : public Tag
 {
   public:
@@ -34,8 +38,8 @@ class PacketTag : public Tag
     void SetHdrm(uint32_t hdrm);
     uint32_t GetHdrm();
 
-    void SetNetDevice(Ptr<PointToPointNetDevice> device);
-    Ptr<PointToPointNetDevice> GetNetDevice();
+    void SetPort(uint32_t port);
+    uint32_t GetPort();
 
     void Print(std::ostream& os) const override;
 
@@ -44,7 +48,50 @@ class PacketTag : public Tag
     uint32_t m_reserve{0};
     uint32_t m_share{0};
     uint32_t m_hdrm{0};
-    Ptr<PointToPointNetDevice> m_device;
+    uint32_t m_port{0}; /**< Interface index of the ingress device */
+};
+
+/**
+ * Back-to-back segments of one QP carried as a single packet. The packet
+ * holds the headers of the first segment, the payload of all segments and
+ * padding for the headers of the others, so that it has their wire size.
+ * The head segment arrives after its own transmission time and every
+ * further segment Gap later. The sending device numbers its trains, so that
+ * a pause can take back the segments it has not started.
+ */
+class TrainTag : public Tag
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+
+    void SetSegments(uint32_t segments);
+    uint32_t GetSegments() const;
+
+    void SetSegmentSize(uint32_t size);
+    uint32_t GetSegmentSize() const;
+
+    void SetGap(Time gap);
+    Time GetGap() const;
+
+    void SetId(uint64_t id);
+    uint64_t GetId() const;
+
+    void Print(std::ostream& os) const override;
+
+  private:
+    uint32_t m_segments{1};
+    uint32_t m_segmentSize{0}; /**< Payload of every segment but the last */
+    int64_t m_gap{0}; /**< Time between segment arrivals, in time steps */
+    uint64_t m_id{0}; /**< Train of the sending device */
 };
 
 } // namespace ns3
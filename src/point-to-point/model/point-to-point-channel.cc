@@ -77,8 +77,8 @@ PointToPointChannel::Attach(Ptr<PointToPointNetDevice> device)
 bool
 PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime)
 {
-    NS_LOG_FUNCTION(this << p << src);
-    NS_LOG_LOGIC("UID is " << p->GetUid() << ")");
+    NS_LOG_FUNCTION_HOT(this << p << src);
+    NS_LOG_LOGIC_HOT("UID is " << p->GetUid() << ")");
 
     NS_ASSERT(m_link[0].m_state != INITIALIZING);
     NS_ASSERT(m_link[1].m_state != INITIALIZING);
@@ -92,7 +92,7 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
                                    p->Copy());
 
     // Call the tx anim callback on the net device
-    m_txrxPointToPoint(p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
+    NS_TRACE_HOT(m_txrxPointToPoint, p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
     return true;
 }
 
@@ -11,7 +11,9 @@
 #include "switch-node.h"
 #include "ppp-header.h"
 #include "pfc-header.h"
+#include "packet-tag.h"
 
+#include "ns3/boolean.h"
 #include "ns3/error-model.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
@@ -33,6 +35,9 @@ NS_LOG_COMPONENT_DEFINE("PointToPointNetDevice");
 
 NS_OBJECT_ENSURE_REGISTERED(PointToPointNetDevice);
 
+/** Offset of the HPCC header in a packet leaving a switch: PPP, IPv4 without options, UDP */
+static const uint32_t HPCC_HEADER_OFFSET = 14 + 20 + 8;
+
 TypeId
 PointToPointNetDevice::GetTypeId()
 {
@@ -55,7 +60,8 @@ PointToPointNetDevice::GetTypeId()
             .AddAttribute("DataRate",
                           "The default data rate for point to point links",
                           DataRateValue(DataRate("32768b/s")),
-                          MakeDataRateAccessor(&PointToPointNetDevice::m_bps),
+                          MakeDataRateAccessor(&PointToPointNetDevice::SetDataRate,
+                                               &PointToPointNetDevice::GetDataRate),
                           MakeDataRateChecker())
             .AddAttribute("ReceiveErrorModel",
                           "The receiver error model used to simulate packet loss",
@@ -67,6 +73,35 @@ PointToPointNetDevice::GetTypeId()
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&PointToPointNetDevice::m_tInterframeGap),
                           MakeTimeChecker())
+            .AddAttribute("GrantOvercommit",
+                          "The number of incoming messages granted at the same time "
+                          "in receiver-driven transport",
+                          UintegerValue(2),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_grantOvercommit),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("QpScheduler",
+                          "The arbitration among QPs allowed to send: 0 earliest pacing time, "
+                          "1 SRPT, 2 weighted fair queuing, 3 PIAS",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_qpScheduler),
+                          MakeUintegerChecker<uint32_t>(0, 3))
+            .AddAttribute("PiasThreshold",
+                          "The bytes of each message sent at high priority under PIAS",
+                          UintegerValue(100000),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_piasThreshold),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("TrainSegments",
+                          "The most back-to-back segments of a QP sent as one packet train, 1 to disable; "
+                          "a train also stays within the 65535 bytes of the BTH size",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&PointToPointNetDevice::m_trainSegments),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("PersistentQp",
+                          "Send the flows to the same destination and tenant as messages "
+                          "of one long-lived QP, except in receiver-driven transport",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PointToPointNetDevice::m_persistentQp),
+                          MakeBooleanChecker())
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -166,7 +201,11 @@ PointToPointNetDevice::GetTypeId()
                             "Trace source simulating a promiscuous packet sniffer "
                             "attached to the device",
                             MakeTraceSourceAccessor(&PointToPointNetDevice::m_promiscSnifferTrace),
-                            "ns3::Packet::TracedCallback");
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("FlowComplete",
+                            "A flow sent by this device is fully acknowledged",
+                            MakeTraceSourceAccessor(&PointToPointNetDevice::m_flowCompleteTrace),
+                            "ns3::PointToPointNetDevice::FlowCompleteCallback");
     return tid;
 }
 
@@ -187,7 +226,7 @@ PointToPointNetDevice::~PointToPointNetDevice()
 void
 PointToPointNetDevice::AddHeader(Ptr<Packet> p, uint16_t protocolNumber)
 {
-    NS_LOG_FUNCTION(this << p << protocolNumber);
+    NS_LOG_FUNCTION_HOT(this << p << protocolNumber);
     PppHeader ppp;
     ppp.SetProtocol(EtherToPpp(protocolNumber));
     p->AddHeader(ppp);
@@ -196,7 +235,7 @@ PointToPointNetDevice::AddHeader(Ptr<Packet> p, uint16_t protocolNumber)
 bool
 PointToPointNetDevice::ProcessHeader(Ptr<Packet> p, uint16_t& param)
 {
-    NS_LOG_FUNCTION(this << p << param);
+    NS_LOG_FUNCTION_HOT(this << p << param);
     PppHeader ppp;
     p->RemoveHeader(ppp);
     param = PppToEther(ppp.GetProtocol());
@@ -208,6 +247,7 @@ PointToPointNetDevice::DoDispose()
 {
     NS_LOG_FUNCTION(this);
     m_node = nullptr;
+    m_switch = nullptr;
     m_channel = nullptr;
     m_receiveErrorModel = nullptr;
     m_currentPkt = nullptr;
@@ -220,6 +260,8 @@ PointToPointNetDevice::SetDataRate(DataRate bps)
 {
     NS_LOG_FUNCTION(this);
     m_bps = bps;
+    m_lineRate.Set(m_bps.GetBitRate());
+    m_txRate.Set(m_bps.GetBitRate() - m_backgroundRate);
 }
 
 DataRate
@@ -235,6 +277,120 @@ PointToPointNetDevice::SetInterframeGap(Time t)
     m_tInterframeGap = t;
 }
 
+void
+PointToPointNetDevice::SetBackgroundRate(uint64_t bps)
+{
+    // Packets keep at least 1% of the link
+    m_backgroundRate = std::min(bps, m_bps.GetBitRate() / 100 * 99);
+    m_txRate.Set(m_bps.GetBitRate() - m_backgroundRate);
+}
+
+uint64_t
+PointToPointNetDevice::GetBackgroundRate() const
+{
+    return m_backgroundRate;
+}
+
+void
+PointToPointNetDevice::SetBackgroundQueue(uint32_t bytes)
+{
+    m_backgroundQueue = bytes;
+}
+
+// Packets started by all devices
+static uint64_t g_txPackets = 0;
+
+uint64_t
+PointToPointNetDevice::GetTxPacketCount()
+{
+    return g_txPackets;
+}
+
+Time
+PointToPointNetDevice::GetTxTime(uint32_t bytes) const
+{
+    return m_txRate.GetTxTime(bytes);
+}
+
+Ptr<PointToPointNetDevice>
+PointToPointNetDevice::GetPeer() const
+{
+    for(std::size_t i = 0;i < m_channel->GetNDevices();++i){
+        Ptr<PointToPointNetDevice> dev = m_channel->GetPointToPointDevice(i);
+        if(dev != this)
+            return dev;
+    }
+    return nullptr;
+}
+
+bool
+PointToPointNetDevice::CommitTrain(uint64_t train)
+{
+    // Cut before its head arrived, the peer must take the segments one by one
+    if(m_trainCuts.find(train) != m_trainCuts.end())
+        return false;
+    if(m_txTrain.segments > 1 && m_txTrain.id == train)
+        m_txTrain.committed = true;
+    return true;
+}
+
+uint32_t
+PointToPointNetDevice::GetSentSegments(uint64_t train) const
+{
+    auto it = m_trainCuts.find(train);
+    return it == m_trainCuts.end() ? UINT32_MAX : it->second;
+}
+
+void
+PointToPointNetDevice::ForgetTrain(uint64_t train)
+{
+    m_trainCuts.erase(train);
+}
+
+void
+PointToPointNetDevice::CutTrain(uint32_t queueIndex)
+{
+    // A committed train passes the peer without taking its buffer
+    if(m_txTrain.segments <= 1 || m_txTrain.committed)
+        return;
+    SocketPriorityTag priorityTag;
+    m_txTrain.packet->PeekPacketTag(priorityTag);
+    if(priorityTag.GetPriority() != queueIndex)
+        return;
+
+    // The segments started before the pause still leave
+    Time now = Simulator::Now();
+    int64_t gap = std::max<int64_t>(1, m_txTrain.gap.GetTimeStep());
+    uint32_t sent = (now - m_txTrain.start).GetTimeStep() / gap + 1;
+    if(sent >= m_txTrain.segments)
+        return;
+    m_trainCuts[m_txTrain.id] = sent;
+
+    Ptr<Packet> packet = m_txTrain.packet->Copy();
+    PppHeader ppp;
+    packet->RemoveHeader(ppp);
+    TrainTag train;
+    packet->PeekPacketTag(train);
+    std::vector<Ptr<Packet>> tail = SwitchNode::GetTrainSegments(packet, train, m_ccVersion, sent);
+    if(m_switch != nullptr){
+        // Forwarded as it arrived, the rest of the train now takes the switch buffer
+        PacketTag packetTag;
+        packet->PeekPacketTag(packetTag);
+        m_switch->AdmitTrainTail(tail, this, packetTag.GetPort());
+    }
+
+    // The rest of the train waits for the resume ahead of the queue
+    for(auto& segment : tail)
+        AddHeader(segment, 0x0800);
+    m_queue->EnqueueFront(queueIndex, tail);
+
+    // The link is free once the last segment sent and the interleaved packets are out
+    Time end = m_txTrain.end - m_txTrain.gap * (m_txTrain.segments - sent) + m_txTrain.shift;
+    m_txTrain.segments = 0;
+    Simulator::Cancel(m_txCompleteEvent);
+    m_txCompleteEvent = Simulator::Schedule(std::max(end, now) - now, &PointToPointNetDevice::TransmitComplete, this);
+}
+
 Time
 PointToPointNetDevice::GetInterframeGap() const
 {
@@ -244,34 +400,15 @@ PointToPointNetDevice::GetInterframeGap() const
 bool
 PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
 {
-    NS_LOG_FUNCTION(this << p);
-    NS_LOG_LOGIC("UID is " << p->GetUid() << ")");
+    NS_LOG_FUNCTION_HOT(this << p);
+    NS_LOG_LOGIC_HOT("UID is " << p->GetUid() << ")");
 
-    if(m_type == NetDeviceType::SWITCH){
-        m_txBytes += p->GetSize();
-        PppHeader ppp;
-        p->PeekHeader(ppp);
-        uint16_t protocol = PppToEther(ppp.GetProtocol());
-        p = DynamicCast<SwitchNode>(GetNode())->EgressPipeline(p, protocol, this);
+    // A train keeps its packet before egress processing, for a pause to cut it
+    TrainTag train;
+    bool isTrain = p->PeekPacketTag(train) && train.GetSegments() > 1;
+    Ptr<Packet> original = isTrain ? p->Copy() : nullptr;
 
-        // Add HPCC header
-        if(p != nullptr && m_ccVersion == 2 && protocol == 0x0800){
-            Ipv4Header ipv4_header;
-            UdpHeader udp_header;
-            HpccHeader hpcc_header;
-            p->RemoveHeader(ppp);
-            p->RemoveHeader(ipv4_header);
-            p->RemoveHeader(udp_header);
-            p->RemoveHeader(hpcc_header);
-            if(hpcc_header.CanAddIntHeader()){
-                hpcc_header.PushIntHeader(GetDataRate(), m_txBytes, GetQueue()->GetNBytes());
-            }
-            p->AddHeader(hpcc_header);
-            p->AddHeader(udp_header);
-            p->AddHeader(ipv4_header);
-            p->AddHeader(ppp);
-        }
-    }
+    p = ProcessEgress(p);
 
     //
     // This function is called to start the process of transmitting a packet.
@@ -281,31 +418,116 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     NS_ASSERT_MSG(m_txMachineState == READY, "Must be READY to transmit");
     m_txMachineState = BUSY;
     m_currentPkt = p;
-    m_phyTxBeginTrace(m_currentPkt);
+    NS_TRACE_HOT(m_phyTxBeginTrace, m_currentPkt);
 
     if(p == nullptr){
         TransmitComplete();
         return true;
     }
-
-    Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+    g_txPackets += 1;
+
+    Time txTime = GetTxTime(p->GetSize());
+    Time arrivalTime = txTime;
+
+    // A train occupies the link until its last segment is sent, but the peer
+    // gets it with its head segment, as a cut-through of the segments
+    if(isTrain){
+        uint32_t segments = train.GetSegments();
+        Time segmentTime = GetTxTime((p->GetSize() + segments - 1) / segments);
+        Time gap = std::max(segmentTime, train.GetGap());
+        txTime = gap * (segments - 1) + segmentTime;
+        arrivalTime = segmentTime;
+        train.SetGap(gap);
+        train.SetId(++m_trainIds);
+        p->ReplacePacketTag(train);
+
+        m_txTrain.segments = segments;
+        m_txTrain.start = Simulator::Now();
+        m_txTrain.gap = gap;
+        m_txTrain.end = Simulator::Now() + txTime + m_tInterframeGap;
+        m_txTrain.shift = Time(0);
+        m_txTrain.slot = 0;
+        m_txTrain.id = train.GetId();
+        m_txTrain.committed = false;
+        m_txTrain.packet = original;
+    }
     Time txCompleteTime = txTime + m_tInterframeGap;
 
-    NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
-    Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    // Waiting behind the virtual background queue delays packets without
+    // taking link time, and never reorders them
+    if(m_backgroundQueue > 0){
+        arrivalTime += m_lineRate.GetTxTime(m_backgroundQueue);
+        arrivalTime = std::max(arrivalTime, m_lastArrival - Simulator::Now());
+        m_lastArrival = Simulator::Now() + arrivalTime;
+    }
+
+    NS_LOG_LOGIC_HOT("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
+    m_txCompleteEvent = Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
 
-    bool result = m_channel->TransmitStart(p, this, txTime);
+    bool result = m_channel->TransmitStart(p, this, arrivalTime);
     if (!result)
     {
-        m_phyTxDropTrace(p);
+        NS_TRACE_HOT(m_phyTxDropTrace, p);
     }
     return result;
 }
 
+Ptr<Packet>
+PointToPointNetDevice::ProcessEgress(Ptr<Packet> p)
+{
+    // A SWITCH device not bound to a SwitchNode is a plain ns-3 link
+    if(m_type == NetDeviceType::SWITCH && m_switch != nullptr){
+        m_txBytes += p->GetSize();
+        PppHeader ppp;
+        p->PeekHeader(ppp);
+        uint16_t protocol = PppToEther(ppp.GetProtocol());
+        p = m_switch->EgressPipeline(p, protocol, this);
+
+        // Stamp INT in place, in the HPCC header behind the PPP, IPv4 and UDP headers
+        if(p != nullptr && m_ccVersion == 2 && protocol == 0x0800){
+            Buffer::Iterator hpcc = p->BeginWritable();
+            hpcc.Next(HPCC_HEADER_OFFSET);
+            HpccHeader::PushIntHeader(hpcc, GetDataRate(), m_txBytes, GetQueue()->GetNBytes(),
+                                      &m_switch->GetIntSampler());
+        }
+    }
+    return p;
+}
+
+void
+PointToPointNetDevice::InterleaveQueued()
+{
+    // Without trains, a queued packet would leave at the next segment boundary
+    Time now = Simulator::Now();
+    while(m_txTrain.segments > 1){
+        int64_t gap = std::max<int64_t>(1, m_txTrain.gap.GetTimeStep());
+        int64_t boundary = ((now - m_txTrain.start).GetTimeStep() + gap - 1) / gap;
+        uint32_t slot = std::max<int64_t>(m_txTrain.slot + 1, boundary);
+        if(slot >= m_txTrain.segments)
+            return; // The last segment is on the wire, the packet waits for the train
+        Ptr<Packet> p = m_queue->Dequeue();
+        if(p == nullptr)
+            return;
+        m_txTrain.slot = slot;
+        p = ProcessEgress(p);
+        if(p == nullptr)
+            continue;
+
+        // The link stays busy for the interleaved packet, the train is not delayed
+        Time start = m_txTrain.start + m_txTrain.gap * slot + m_txTrain.shift;
+        Time txTime = GetTxTime(p->GetSize());
+        m_txTrain.shift += txTime;
+        m_channel->TransmitStart(p, this, start - now + txTime);
+        Simulator::Cancel(m_txCompleteEvent);
+        m_txCompleteEvent = Simulator::Schedule(m_txTrain.end + m_txTrain.shift - now,
+            &PointToPointNetDevice::TransmitComplete, this);
+    }
+}
+
 void
 PointToPointNetDevice::TransmitComplete()
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION_HOT(this);
 
     //
     // This function is called to when we're all done transmitting a packet.
@@ -318,22 +540,24 @@ PointToPointNetDevice::TransmitComplete()
 
     NS_ASSERT_MSG(m_currentPkt, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
 
-    m_phyTxEndTrace(m_currentPkt);
+    NS_TRACE_HOT(m_phyTxEndTrace, m_currentPkt);
     m_currentPkt = nullptr;
+    m_txTrain.segments = 0;
+    m_txTrain.packet = nullptr;
 
     Ptr<Packet> p = m_queue->Dequeue();
     if (!p)
     {
         CheckSendQueue();
-        NS_LOG_LOGIC("No pending packets in device queue after tx complete");
+        NS_LOG_LOGIC_HOT("No pending packets in device queue after tx complete");
         return;
     }
 
     //
     // Got another packet off of the queue, so start the transmit process again.
     //
-    m_snifferTrace(p);
-    m_promiscSnifferTrace(p);
+    NS_TRACE_HOT(m_snifferTrace, p);
+    NS_TRACE_HOT(m_promiscSnifferTrace, p);
     TransmitStart(p);
 }
 
@@ -372,7 +596,7 @@ PointToPointNetDevice::SetReceiveErrorModel(Ptr<ErrorModel> em)
 void
 PointToPointNetDevice::Receive(Ptr<Packet> packet)
 {
-    NS_LOG_FUNCTION(this << packet);
+    NS_LOG_FUNCTION_HOT(this << packet);
     uint16_t protocol = 0;
 
     if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt(packet))
@@ -381,7 +605,7 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
         // If we have an error model and it indicates that it is time to lose a
         // corrupted packet, don't forward this packet up, let it go.
         //
-        m_phyRxDropTrace(packet);
+        NS_TRACE_HOT(m_phyRxDropTrace, packet);
     }
     else
     {
@@ -390,15 +614,19 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
         // device because it is so simple, but this is not usually the case in
         // more complicated devices.
         //
-        m_snifferTrace(packet);
-        m_promiscSnifferTrace(packet);
-        m_phyRxEndTrace(packet);
+        NS_TRACE_HOT(m_snifferTrace, packet);
+        NS_TRACE_HOT(m_promiscSnifferTrace, packet);
+        NS_TRACE_HOT(m_phyRxEndTrace, packet);
 
         //
         // Trace sinks will expect complete packets, not packets without some of the
-        // headers.
+        // headers.  The copy is only needed if they are connected.
         //
-        Ptr<Packet> originalPacket = packet->Copy();
+        Ptr<Packet> originalPacket = packet;
+        if (!m_macRxTrace.IsEmpty() || !m_macPromiscRxTrace.IsEmpty())
+        {
+            originalPacket = packet->Copy();
+        }
 
         //
         // Strip off the point-to-point protocol header and forward this packet
@@ -412,7 +640,9 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
             PfcHeader pfc;
             packet->RemoveHeader(pfc);
             m_queue->SetPauseFlag(pfc.GetQueueIndex(), pfc.GetTime() > 0);
-            
+            if(pfc.GetTime() > 0)
+                CutTrain(pfc.GetQueueIndex());
+
             if(pfc.GetTime() == 0 && m_txMachineState == READY){
                 Ptr<Packet> p = m_queue->Dequeue();
                 if (p) TransmitStart(p);
@@ -425,6 +655,7 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
             Ipv4Header ipv4_header;
             UdpHeader udp_header;
             HpccHeader hpcc_header;
+            GrantHeader grant_header;
             BthHeader bth_header;
 
             packet->RemoveHeader(ipv4_header);
@@ -432,37 +663,52 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
             if(m_ccVersion == 2){
                 packet->RemoveHeader(hpcc_header);
             }
+            else if(m_ccVersion == 5){
+                packet->RemoveHeader(grant_header);
+            }
             packet->RemoveHeader(bth_header);
 
             uint32_t id = bth_header.GetId();
             if(bth_header.GetACK() || bth_header.GetNACK()){
                 if(m_flows.find(id) != m_flows.end()){
-                    if(m_flows[id]->ProcessACK(bth_header, hpcc_header)){
-                        // Flow completed
-                        m_flows.erase(id);
+                    if(m_flows[id]->ProcessACK(bth_header, hpcc_header, grant_header)){
+                        // Flow completed, a persistent QP waits for its next message
+                        // unless a new QP took over its byte stream
+                        if(!IsPersistent() || !IsCurrentPersistentQp(m_flows[id]))
+                            m_flows.erase(id);
                         m_sendCompleted.erase(id);
                     }
                     else if(m_sendCompleted.find(id) != m_sendCompleted.end()){
+                        // A new ACK or grant may unblock the QP
                         auto qp = m_sendCompleted[id];
-                        if(!qp->IsSendCompleted()){
-                            m_sendQueue.emplace(qp->GetNextSendTime(), qp->GetId());
+                        if(!qp->IsSendBlocked()){
+                            ScheduleQp(qp);
                             m_sendCompleted.erase(id);
+                            CheckSendQueue();
                         }
                     }
                 }
             }
             else{
-                if(bth_header.GetSequence() <= m_receivers[id] + bth_header.GetSize()){
-                    m_receivers[id] = std::max(m_receivers[id], bth_header.GetSequence());
-                    Ptr<Packet> ackPacket = GenerateACK(ipv4_header, hpcc_header, bth_header, true);
-                    Send(ackPacket, GetBroadcast(), 0x0800);
-                    // std::cerr << "Generating ACK for flow " << id << " with seq " << m_receivers[id] << std::endl;
+                // Segments of a train are received one by one, gap after each other
+                TrainTag train;
+                if(packet->PeekPacketTag(train) && train.GetSegments() > 1){
+                    uint32_t total = bth_header.GetSize();
+                    uint32_t start = bth_header.GetSequence() - total;
+                    uint32_t segmentSize = train.GetSegmentSize();
+                    for(uint32_t i = 0;i < train.GetSegments();++i){
+                        uint32_t size = std::min(segmentSize, total - i * segmentSize);
+                        bth_header.SetSize(size);
+                        bth_header.SetSequence(start + i * segmentSize + size);
+                        if(i == 0)
+                            ReceiveData(ipv4_header, hpcc_header, grant_header, bth_header);
+                        else
+                            Simulator::Schedule(train.GetGap() * i, &PointToPointNetDevice::ReceiveData, this,
+                                ipv4_header, hpcc_header, grant_header, bth_header);
+                    }
                 }
                 else{
-                    bth_header.SetSequence(m_receivers[id]);
-                    Ptr<Packet> nackPacket = GenerateACK(ipv4_header, hpcc_header, bth_header, false);
-                    Send(nackPacket, GetBroadcast(), 0x0800);
-                    std::cerr << "Generating NACK for flow " << id << " with seq " << m_receivers[id] << std::endl;
+                    ReceiveData(ipv4_header, hpcc_header, grant_header, bth_header);
                 }
             }
             return;
@@ -470,7 +716,7 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
 
         if (!m_promiscCallback.IsNull())
         {
-            m_macPromiscRxTrace(originalPacket);
+            NS_TRACE_HOT(m_macPromiscRxTrace, originalPacket);
             m_promiscCallback(this,
                               packet,
                               protocol,
@@ -479,13 +725,45 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
                               NetDevice::PACKET_HOST);
         }
 
-        m_macRxTrace(originalPacket);
-        m_rxCallback(this, packet, protocol, GetRemote());
+        NS_TRACE_HOT(m_macRxTrace, originalPacket);
+        if(m_switch != nullptr){
+            // The packet is the channel's copy, the switch can modify it
+            m_switch->IngressPipeline(packet, protocol, this);
+        }
+        else{
+            m_rxCallback(this, packet, protocol, GetRemote());
+        }
+    }
+}
+
+void
+PointToPointNetDevice::ReceiveData(Ipv4Header ipv4_header, HpccHeader hpcc_header, GrantHeader grant_header, BthHeader bth_header)
+{
+    uint32_t id = bth_header.GetId();
+    // A trimmed packet lost its payload and is only acknowledged if already received
+    uint32_t expected = m_receivers[id] + (bth_header.GetTrim() ? 0 : bth_header.GetSize());
+    if(bth_header.GetSequence() <= expected){
+        m_receivers[id] = std::max(m_receivers[id], bth_header.GetSequence());
+        if(m_ccVersion == 5){
+            UpdateGrants(id, ipv4_header, grant_header);
+        }
+        Ptr<Packet> ackPacket = GenerateACK(ipv4_header, hpcc_header, grant_header, bth_header, true);
+        Send(ackPacket, GetBroadcast(), 0x0800);
+        // std::cerr << "Generating ACK for flow " << id << " with seq " << m_receivers[id] << std::endl;
+    }
+    else{
+        if(m_ccVersion == 5){
+            UpdateGrants(id, ipv4_header, grant_header);
+        }
+        bth_header.SetSequence(m_receivers[id]);
+        Ptr<Packet> nackPacket = GenerateACK(ipv4_header, hpcc_header, grant_header, bth_header, false);
+        Send(nackPacket, GetBroadcast(), 0x0800);
+        std::cerr << "Generating NACK for flow " << id << " with seq " << m_receivers[id] << std::endl;
     }
 }
 
 Ptr<Packet> 
-PointToPointNetDevice::GenerateACK(Ipv4Header ipv4_header, HpccHeader hpcc_header, BthHeader bth_header, bool isAck)
+PointToPointNetDevice::GenerateACK(Ipv4Header ipv4_header, HpccHeader hpcc_header, GrantHeader grant_header, BthHeader bth_header, bool isAck)
 {
 	Ptr<Packet> ret = Create<Packet>(0);
 
@@ -502,9 +780,12 @@ PointToPointNetDevice::GenerateACK(Ipv4Header ipv4_header, HpccHeader hpcc_heade
         hpcc_header.StopAddIntHeader();
         ret->AddHeader(hpcc_header);
     }
+    else if(m_ccVersion == 5){
+        ret->AddHeader(grant_header);
+    }
 
 	UdpHeader udp_header;
-	udp_header.SetSourcePort(std::rand() % 65535);
+	udp_header.SetSourcePort(m_ackPortVar.GetInteger(0, 65534));
 	udp_header.SetDestinationPort(BthHeader::ROCE_UDP_PORT);
 	ret->AddHeader(udp_header);
 
@@ -518,12 +799,84 @@ PointToPointNetDevice::GenerateACK(Ipv4Header ipv4_header, HpccHeader hpcc_heade
 	ret->AddHeader(ipv4_hdr);
 
 	SocketPriorityTag tag;
-	tag.SetPriority(RdmaQueuePair::m_ackPriority);
+	if(m_ccVersion == 5)
+		tag.SetPriority(RdmaQueuePair::m_grantPriority);
+	else
+		tag.SetPriority(RdmaQueuePair::m_ackPriority);
 	ret->ReplacePacketTag(tag);
 
 	return ret;
 }
 
+void
+PointToPointNetDevice::UpdateGrants(uint32_t id, Ipv4Header& ipv4_header, GrantHeader& grant_header)
+{
+    // Update the state of the message that just arrived
+    uint32_t size = grant_header.GetSize();
+    uint32_t received = std::min(m_receivers[id], size);
+
+    auto it = m_grants.find(id);
+    if(it == m_grants.end()){
+        if(received >= size){
+            // Already completed, grant everything
+            grant_header.SetOffset(size);
+            grant_header.SetPriority(RdmaQueuePair::m_scheduledPriority);
+            return;
+        }
+        GrantState state;
+        state.size = size;
+        state.rttBytes = grant_header.GetOffset();
+        state.remaining = size;
+        state.granted = grant_header.GetOffset();
+        state.priority = RdmaQueuePair::m_scheduledPriority;
+        it = m_grants.emplace(id, state).first;
+        m_grantOrder.emplace(state.remaining, id);
+    }
+    it->second.ipv4 = ipv4_header;
+
+    m_grantOrder.erase({it->second.remaining, id});
+    it->second.remaining = size - received;
+    if(it->second.remaining > 0)
+        m_grantOrder.emplace(it->second.remaining, id);
+
+    // Grant the messages with the fewest remaining bytes (SRPT)
+    uint32_t rank = 0;
+    for(auto order = m_grantOrder.begin(); order != m_grantOrder.end() && rank < m_grantOvercommit; ++order){
+        uint32_t flowId = order->second;
+        GrantState& state = m_grants[flowId];
+        if(state.granted >= state.size)
+            continue;
+
+        uint32_t granted = std::min(state.size, m_receivers[flowId] + state.rttBytes);
+        uint8_t priority = RdmaQueuePair::m_scheduledPriority + std::min(rank, 1U);
+        rank += 1;
+
+        if(granted <= state.granted && priority == state.priority)
+            continue;
+        state.granted = std::max(state.granted, granted);
+        state.priority = priority;
+
+        if(flowId != id){
+            // The ACK of the arriving message carries its grant, others get a grant packet
+            BthHeader bth;
+            bth.SetId(flowId);
+            bth.SetSequence(m_receivers[flowId]);
+            GrantHeader grant;
+            grant.SetSize(state.size);
+            grant.SetOffset(state.granted);
+            grant.SetPriority(state.priority);
+            HpccHeader hpcc;
+            Send(GenerateACK(state.ipv4, hpcc, grant, bth, true), GetBroadcast(), 0x0800);
+        }
+    }
+
+    grant_header.SetOffset(it->second.granted);
+    grant_header.SetPriority(it->second.priority);
+
+    if(it->second.remaining == 0)
+        m_grants.erase(it);
+}
+
 
 Ptr<PointToPointQueue>
 PointToPointNetDevice::GetQueue() const
@@ -667,9 +1020,11 @@ PointToPointNetDevice::CheckRetransmitQueue()
         auto qp = m_sendCompleted[p.second];
         if(qp->GetTimeOut() != p.first)
             continue; // Already retransmitted, to avoid multiple retransmissions for the same timeout
+        if(!qp->HasOutstanding())
+            continue; // All acknowledged while waiting for grants, ProcessACK wakes it up
 
         qp->TimeOutReset();
-        m_sendQueue.emplace(qp->GetNextSendTime(), p.second);
+        ScheduleQp(qp);
         m_sendCompleted.erase(p.second);
     }
 
@@ -684,9 +1039,9 @@ PointToPointNetDevice::CheckRetransmitQueue()
 bool
 PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t protocolNumber)
 {
-    NS_LOG_FUNCTION(this << packet << dest << protocolNumber);
-    NS_LOG_LOGIC("p=" << packet << ", dest=" << &dest);
-    NS_LOG_LOGIC("UID is " << packet->GetUid());
+    NS_LOG_FUNCTION_HOT(this << packet << dest << protocolNumber);
+    NS_LOG_LOGIC_HOT("p=" << packet << ", dest=" << &dest);
+    NS_LOG_LOGIC_HOT("UID is " << packet->GetUid());
 
     //
     // If IsLinkUp() is false it means there is no channel to send any packet
@@ -694,7 +1049,7 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     //
     if (!IsLinkUp())
     {
-        m_macTxDropTrace(packet);
+        NS_TRACE_HOT(m_macTxDropTrace, packet);
         return false;
     }
 
@@ -704,7 +1059,7 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     //
     AddHeader(packet, protocolNumber);
 
-    m_macTxTrace(packet);
+    NS_TRACE_HOT(m_macTxTrace, packet);
 
     //
     // We should enqueue and dequeue the packet to hit the tracing hooks.
@@ -718,20 +1073,23 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
         {
             packet = m_queue->Dequeue();
             if(packet != nullptr){
-                m_snifferTrace(packet);
-                m_promiscSnifferTrace(packet);
+                NS_TRACE_HOT(m_snifferTrace, packet);
+                NS_TRACE_HOT(m_promiscSnifferTrace, packet);
                 return TransmitStart(packet);
             }
             else{
                 CheckSendQueue();
             }
         }
+        else{
+            InterleaveQueued();
+        }
         return true;
     }
 
     // Enqueue may fail (overflow)
 
-    m_macTxDropTrace(packet);
+    NS_TRACE_HOT(m_macTxDropTrace, packet);
     return false;
 }
 
@@ -741,7 +1099,7 @@ PointToPointNetDevice::SendFrom(Ptr<Packet> packet,
                                 const Address& dest,
                                 uint16_t protocolNumber)
 {
-    NS_LOG_FUNCTION(this << packet << source << dest << protocolNumber);
+    NS_LOG_FUNCTION_HOT(this << packet << source << dest << protocolNumber);
     return false;
 }
 
@@ -779,7 +1137,7 @@ PointToPointNetDevice::SetPromiscReceiveCallback(NetDevice::PromiscReceiveCallba
 
 void 
 PointToPointNetDevice::CheckSendQueue(){
-    if(m_sendQueue.empty() || m_type != NetDeviceType::SERVER ||
+    if((m_sendQueue.empty() && m_readyQueue.empty()) || m_type != NetDeviceType::SERVER ||
             m_txMachineState != READY || m_queue->GetPauseFlag(2))
         return;
     
@@ -788,27 +1146,46 @@ PointToPointNetDevice::CheckSendQueue(){
         return;
     }
 
-    while(!m_sendQueue.empty()){
+    // QPs whose pacing time has come compete for the link
+    int64_t now = Simulator::Now().GetNanoSeconds();
+    while(!m_sendQueue.empty() && m_sendQueue.top().first <= now){
         auto p = m_sendQueue.top();
-        if(Simulator::Now().GetNanoSeconds() < p.first)
-            break;
-
         m_sendQueue.pop();
+        auto it = m_flows.find(p.second);
+        if(it != m_flows.end())
+            m_readyQueue.emplace(GetArbitrationKey(it->second, p.first), p.second);
+    }
+
+    while(!m_readyQueue.empty()){
+        auto p = m_readyQueue.top();
+        m_readyQueue.pop();
         if(m_flows.find(p.second) == m_flows.end())
             continue;
         auto qp = m_flows[p.second];
+        qp->SetQueued(false);
+        if(qp->IsIdle())
+            continue; // Completed while queued
 
-        Ptr<Packet> pkt = qp->GenerateNextPacket();
+        Ptr<Packet> pkt = qp->GenerateNextPacket(GetTrainSegments(qp));
 
-        if(qp->IsSendCompleted()){
+        if(qp->IsSendBlocked()){
             m_sendCompleted[p.second] = qp;
-            m_retransmitQueue.emplace(qp->GetTimeOut(), p.second);
-            Simulator::Cancel(m_retransmitEvent);
-            m_retransmitEvent = Simulator::Schedule(NanoSeconds(std::min((int64_t)1, m_retransmitQueue.top().first - Simulator::Now().GetNanoSeconds())), 
-                &PointToPointNetDevice::CheckRetransmitQueue, this);
+            // Waiting for grants with nothing in flight, the next grant wakes it up
+            if(qp->HasOutstanding()){
+                m_retransmitQueue.emplace(qp->GetTimeOut(), p.second);
+                Simulator::Cancel(m_retransmitEvent);
+                m_retransmitEvent = Simulator::Schedule(NanoSeconds(std::max((int64_t)0, m_retransmitQueue.top().first - Simulator::Now().GetNanoSeconds())), 
+                    &PointToPointNetDevice::CheckRetransmitQueue, this);
+            }
         }
-        else{
-            m_sendQueue.emplace(qp->GetNextSendTime(), p.second);
+
+        if(pkt != nullptr && m_qpScheduler == WFQ){
+            m_virtualTime = p.first;
+            qp->SetWfqFinish(p.first + (int64_t)pkt->GetSize() * 1000 / qp->GetWeight());
+        }
+
+        if(!qp->IsSendBlocked()){
+            ScheduleQp(qp);
         }
 
         if(pkt != nullptr){
@@ -825,6 +1202,42 @@ PointToPointNetDevice::CheckSendQueue(){
     }
 }
 
+uint32_t
+PointToPointNetDevice::GetTrainSegments(Ptr<RdmaQueuePair> qp) const
+{
+    // Segments leave back-to-back only while no other QP could win the link
+    if(m_trainSegments <= 1 || !m_readyQueue.empty())
+        return 1;
+    uint32_t segments = qp->GetTrainSegments(m_trainSegments);
+    if(segments > 1 && !m_sendQueue.empty()){
+        int64_t segmentTime = GetTxTime(qp->GetSegmentSize()).GetNanoSeconds();
+        int64_t untilNext = m_sendQueue.top().first - Simulator::Now().GetNanoSeconds();
+        segments = std::min<int64_t>(segments, 1 + std::max<int64_t>(0, untilNext) / std::max<int64_t>(1, segmentTime));
+    }
+    return segments;
+}
+
+bool
+PointToPointNetDevice::IsTxIdle() const
+{
+    return m_txMachineState == READY && m_queue->IsEmpty() && !m_queue->GetPauseFlag(2);
+}
+
+int64_t
+PointToPointNetDevice::GetArbitrationKey(Ptr<RdmaQueuePair> qp, int64_t sendTime) const
+{
+    switch(m_qpScheduler){
+    case SRPT:
+        return qp->GetRemainingBytes();
+    case WFQ:
+        return std::max(m_virtualTime, qp->GetWfqFinish());
+    case PIAS:
+        return ((int64_t)qp->GetPiasLevel() << 50) + sendTime;
+    default:
+        return sendTime;
+    }
+}
+
 void
 PointToPointNetDevice::SetFlow(FlowInfo flow, FILE* logFilePtr, uint32_t ccVersion)
 {
@@ -832,12 +1245,66 @@ PointToPointNetDevice::SetFlow(FlowInfo flow, FILE* logFilePtr, uint32_t ccVersi
         std::cerr << "Flow " << flow.id << " already exists!" << std::endl;
         return;
     }
+    if(IsPersistent()){
+        uint64_t key = GetPersistentKey(flow);
+        auto it = m_persistentQps.find(key);
+        if(it != m_persistentQps.end()){
+            auto qp = m_flows[it->second];
+            if(qp->CanAddMessage(flow)){
+                qp->AddMessage(flow);
+                m_sendCompleted.erase(qp->GetId());
+                ScheduleQp(qp);
+                CheckSendQueue();
+                return;
+            }
+            // A full byte stream rolls over to a new QP, the old one drains its
+            // messages and is erased with its last ACK, or now if it has none
+            if(qp->IsIdle()){
+                m_flows.erase(qp->GetId());
+                m_sendCompleted.erase(qp->GetId());
+            }
+        }
+        m_persistentQps[key] = flow.id;
+    }
+
     Ptr<RdmaQueuePair> qp = CreateObject<RdmaQueuePair>(flow, this, logFilePtr, ccVersion, m_pfcVersion);
+    if(m_qpScheduler == PIAS)
+        qp->SetPiasThreshold(m_piasThreshold);
+    qp->SetWfqFinish(m_virtualTime);
     m_flows[flow.id] = qp;
-    m_sendQueue.emplace(qp->GetNextSendTime(), qp->GetId());
+    ScheduleQp(qp);
     CheckSendQueue();
 }
 
+uint64_t
+PointToPointNetDevice::GetPersistentKey(const FlowInfo& flow)
+{
+    return ((uint64_t)flow.dst << 32) | flow.tenant;
+}
+
+bool
+PointToPointNetDevice::IsCurrentPersistentQp(Ptr<RdmaQueuePair> qp) const
+{
+    auto it = m_persistentQps.find(GetPersistentKey(qp->GetFlow()));
+    return it != m_persistentQps.end() && it->second == qp->GetId();
+}
+
+void
+PointToPointNetDevice::ScheduleQp(Ptr<RdmaQueuePair> qp)
+{
+    // At most one entry per QP, so that a QP never sends at twice its rate
+    if(qp->IsQueued())
+        return;
+    qp->SetQueued(true);
+    m_sendQueue.emplace(qp->GetNextSendTime(), qp->GetId());
+}
+
+void
+PointToPointNetDevice::NotifyFlowComplete(const FlowInfo& flow)
+{
+    m_flowCompleteTrace(flow);
+}
+
 void
 PointToPointNetDevice::SetCC(uint32_t ccVersion)
 {
@@ -901,6 +1368,7 @@ void
 PointToPointNetDevice::SetId(uint32_t id)
 {
     m_id = id;
+    m_ackPortVar.SetStream(ACK_PORT_STREAM_BASE + id);
 }
 
 void
@@ -909,6 +1377,12 @@ PointToPointNetDevice::SetDeviceType(NetDeviceType type)
     m_type = type;
 }
 
+void
+PointToPointNetDevice::SetSwitch(SwitchNode* node)
+{
+    m_switch = node;
+}
+
 uint16_t
 PointToPointNetDevice::PppToEther(uint16_t proto)
 {
@@ -17,13 +17,17 @@
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
 #include "ns3/queue-fwd.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/traced-callback.h"
 
 #include "point-to-point-queue.h"
 #include "rdma-queue-pair.h"
 #include "hpcc-header.h"
+#include "grant-header.h"
+#include "tx-rate.h"
 
 #include <cstring>
+#include <set>
 #include <unordered_map>
 
 namespace ns3
@@ -31,6 +35,7 @@ namespace ns3
 
 struct FlowInfo;
 class RdmaQueuePair;
+class SwitchNode;
 class PointToPointQueue;
 class PointToPointChannel;
 class ErrorModel;
@@ -98,6 +103,33 @@ class PointToPointNetDevice : public NetDevice
 
 	DataRate GetDataRate() const;
 
+	// Nothing is being sent or waits in the queue, and data is not paused
+	bool IsTxIdle() const;
+
+	// Link capacity taken by fluid background flows, in bps, and the bytes
+	// of background traffic packets find queued ahead of them
+	void SetBackgroundRate(uint64_t bps);
+	uint64_t GetBackgroundRate() const;
+	void SetBackgroundQueue(uint32_t bytes);
+	uint32_t GetBackgroundQueue() const { return m_backgroundQueue; }
+
+	// Transmission time at the rate left to packets
+	Time GetTxTime(uint32_t bytes) const;
+
+	// The device at the other end of the channel
+	Ptr<PointToPointNetDevice> GetPeer() const;
+
+	// Packet trains: a pause takes back the segments of a train that have not
+	// started, unless the peer committed to forward the train whole
+	bool CommitTrain(uint64_t train);
+	// Segments sent of a train cut by a pause, UINT32_MAX if it was not cut
+	uint32_t GetSentSegments(uint64_t train) const;
+	// The peer has received every segment sent of the train
+	void ForgetTrain(uint64_t train);
+
+	// Packets started by all devices, for simulator throughput
+	static uint64_t GetTxPacketCount();
+
     /**
      * Set the interframe gap used to separate packets.  The interframe gap
      * defines the minimum space required between packets sent by this device.
@@ -200,7 +232,18 @@ class PointToPointNetDevice : public NetDevice
     bool SupportsSendFrom() const override;
 
 
+	/**
+	 * Set the device ID, which also selects the RNG stream of the ACK
+	 * source ports, ACK_PORT_STREAM_BASE + id.
+	 */
 	void SetId(uint32_t id);
+	/**
+	 * Stream base of the ACK source ports. Every RNG consumer owns a range
+	 * of 2^40 streams, so any uint32 ID stays clear of the others:
+	 * workload 100000 + 3 * host, incast 1 << 40, ACK ports 2 << 40,
+	 * switch ECN 3 << 40 and PINT samples 4 << 40.
+	 */
+	static const int64_t ACK_PORT_STREAM_BASE = 2LL << 40;
 
     enum NetDeviceType
     {
@@ -210,8 +253,26 @@ class PointToPointNetDevice : public NetDevice
 
 	void SetDeviceType(NetDeviceType type);
 
+	/**
+	 * Bind the device to the switch that owns it, at SwitchNode::AddDevice.
+	 * Received packets then go straight to its ingress pipeline, with the
+	 * interface index as the port, and sent packets through its egress
+	 * pipeline, without the receive callback or a cast of the node.
+	 */
+	void SetSwitch(SwitchNode* node);
+
 	void SetFlow(FlowInfo flow, FILE* logFilePtr, uint32_t ccVersion);
 
+	// Called by a QP when all its bytes are acknowledged
+	void NotifyFlowComplete(const FlowInfo& flow);
+
+	/**
+	 * TracedCallback signature for completed flows.
+	 *
+	 * @param [in] flow The flow, with its end time set.
+	 */
+	typedef void (*FlowCompleteCallback)(const FlowInfo& flow);
+
 	void SetCC(uint32_t ccVersion);
 
 	void SetPFC(uint32_t pfcVersion);
@@ -305,6 +366,8 @@ class PointToPointNetDevice : public NetDevice
      * timing.
      */
     DataRate m_bps;
+    TxRate m_lineRate; //!< Integer tx time at m_bps
+    TxRate m_txRate;   //!< Integer tx time at the rate left by fluid flows
 
     /**
      * The interframe gap that the Net Device uses to throttle packet
@@ -439,6 +502,12 @@ class PointToPointNetDevice : public NetDevice
      */
     TracedCallback<Ptr<const Packet>> m_promiscSnifferTrace;
 
+    /**
+     * The trace source fired when a flow sent by this device is fully
+     * acknowledged, right after its FCT is written.
+     */
+    TracedCallback<const FlowInfo&> m_flowCompleteTrace;
+
     Ptr<Node> m_node;                                    //!< Node owning this NetDevice
     Mac48Address m_address;                              //!< Mac48Address of this NetDevice
     NetDevice::ReceiveCallback m_rxCallback;             //!< Receive callback
@@ -477,11 +546,13 @@ class PointToPointNetDevice : public NetDevice
     static uint16_t EtherToPpp(uint16_t protocol);
 
 	uint32_t m_id; /**< Device ID */
+	UniformRandomVariable m_ackPortVar; /**< ACK source ports, on the stream of the device */
 	uint32_t m_ccVersion{0}; /**< Congestion control version */
 	uint32_t m_pfcVersion{0}; /**< PFC version */
 	uint64_t m_txBytes{0}; /**< Transmitted bytes */
 
     NetDeviceType m_type = NetDeviceType::SWITCH; /**< Device type */
+	SwitchNode* m_switch{nullptr}; /**< Owning switch, null on a host; m_node keeps it alive */
 
     std::unordered_map<uint32_t, Ptr<RdmaQueuePair>> m_flows;
 	std::unordered_map<uint32_t, uint32_t> m_receivers; /**< Map of flow ID to last received sequence number */
@@ -495,7 +566,89 @@ class PointToPointNetDevice : public NetDevice
 	
 	void CheckSendQueue();
 
-	Ptr<Packet> GenerateACK(Ipv4Header ipv4_header, HpccHeader hpcc_header, BthHeader bth_header, bool isAck = true);
+	void ScheduleQp(Ptr<RdmaQueuePair> qp);
+
+	// NIC arbitration among the QPs allowed to send
+	enum QpScheduler
+	{
+		EDF = 0, /**< Earliest pacing time first */
+		SRPT = 1, /**< Fewest remaining bytes first */
+		WFQ = 2, /**< Start-time fair queuing by QP weight */
+		PIAS = 3, /**< EDF within two levels, demoted after PiasThreshold bytes of a message */
+	};
+
+	uint32_t m_qpScheduler{EDF}; /**< Arbitration policy */
+	uint32_t m_piasThreshold{100000}; /**< Bytes of a message sent at the PIAS high priority */
+	int64_t m_virtualTime{0}; /**< WFQ virtual time */
+
+	std::priority_queue<std::pair<int64_t, uint32_t>,
+		std::vector<std::pair<int64_t, uint32_t>>,
+		std::greater<std::pair<int64_t, uint32_t>>> m_readyQueue; /**< Priority queue of (arbitration key, flow ID) of QPs due to send */
+
+	int64_t GetArbitrationKey(Ptr<RdmaQueuePair> qp, int64_t sendTime) const;
+
+	// Persistent QPs
+	bool m_persistentQp{false}; /**< Reuse one QP per (destination, tenant) */
+	std::unordered_map<uint64_t, uint32_t> m_persistentQps; /**< Map of (destination, tenant) to QP ID */
+
+	bool IsPersistent() const { return m_persistentQp && m_ccVersion != 5; }
+	static uint64_t GetPersistentKey(const FlowInfo& flow);
+	/** The QP is the one new messages of its (destination, tenant) go to */
+	bool IsCurrentPersistentQp(Ptr<RdmaQueuePair> qp) const;
+
+	uint64_t m_backgroundRate{0}; /**< Rate taken by fluid flows, in bps */
+	uint32_t m_backgroundQueue{0}; /**< Virtual queue of fluid flows, in bytes */
+	Time m_lastArrival; /**< Arrival at the peer of the last packet, to keep the order */
+
+	// Packet trains
+	uint32_t m_trainSegments{1}; /**< Most segments sent as one train, 1 to disable */
+
+	uint32_t GetTrainSegments(Ptr<RdmaQueuePair> qp) const;
+
+	struct TxTrain
+	{
+		uint32_t segments{0}; /**< Segments of the train being sent, 0 if none */
+		Time start; /**< Start of the transmission */
+		Time gap; /**< Time between segments */
+		Time end; /**< End of the transmission without interleaved packets */
+		Time shift; /**< Transmission time of interleaved packets */
+		uint32_t slot{0}; /**< Last segment boundary used by an interleaved packet */
+		uint64_t id{0}; /**< TrainTag ID */
+		bool committed{false}; /**< The peer forwards the train whole */
+		Ptr<Packet> packet; /**< The train before egress processing */
+	};
+
+	TxTrain m_txTrain; /**< The train being transmitted */
+	uint64_t m_trainIds{0}; /**< Trains sent so far */
+	std::unordered_map<uint64_t, uint32_t> m_trainCuts; /**< Segments sent of each cut train, until the peer has them */
+
+	void CutTrain(uint32_t queueIndex);
+	EventId m_txCompleteEvent; /**< Event ID for the end of the transmission */
+
+	Ptr<Packet> ProcessEgress(Ptr<Packet> p);
+	void InterleaveQueued();
+
+	void ReceiveData(Ipv4Header ipv4_header, HpccHeader hpcc_header, GrantHeader grant_header, BthHeader bth_header);
+
+	Ptr<Packet> GenerateACK(Ipv4Header ipv4_header, HpccHeader hpcc_header, GrantHeader grant_header, BthHeader bth_header, bool isAck = true);
+
+	// For receiver-driven transport
+	struct GrantState
+	{
+		Ipv4Header ipv4; /**< Header of the latest data packet, to address grants */
+		uint32_t size{0}; /**< Message length */
+		uint32_t rttBytes{0}; /**< Bytes kept granted beyond the received sequence */
+		uint32_t remaining{0}; /**< Bytes not yet received */
+		uint32_t granted{0}; /**< Granted offset */
+		uint8_t priority{0}; /**< Priority of scheduled packets */
+	};
+
+	uint32_t m_grantOvercommit{2}; /**< Number of messages granted at the same time */
+
+	std::unordered_map<uint32_t, GrantState> m_grants; /**< Map of flow ID to grant state of incoming messages */
+	std::set<std::pair<uint32_t, uint32_t>> m_grantOrder; /**< Set of (remaining bytes, flow ID) in SRPT order */
+
+	void UpdateGrants(uint32_t id, Ipv4Header& ipv4_header, GrantHeader& grant_header);
 	
 	// For retransmission
 	std::unordered_map<uint32_t, Ptr<RdmaQueuePair>> m_sendCompleted; /**< Map of flow ID to RdmaQueuePair that has completed sending */
@@ -114,6 +114,21 @@ PointToPointQueue::GetNBytes(uint32_t index) const
     return m_queues[index]->GetNBytes();
 }
 
+void
+PointToPointQueue::EnqueueFront(uint32_t index, const std::vector<Ptr<Packet>>& packets)
+{
+    if(index >= NUM_QUEUE){
+        NS_ABORT_MSG("Invalid index in PointToPointQueue::EnqueueFront " << index);
+    }
+    std::vector<Ptr<Packet>> queued;
+    while(Ptr<Packet> p = m_queues[index]->Dequeue())
+        queued.push_back(p);
+    for(const auto& p : packets)
+        m_queues[index]->Enqueue(p);
+    for(const auto& p : queued)
+        m_queues[index]->Enqueue(p);
+}
+
 void
 PointToPointQueue::SetPauseFlag(uint32_t index, bool flag)
 {
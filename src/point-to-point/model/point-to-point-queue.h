@@ -33,6 +33,9 @@ public:
     uint32_t GetNBytes() const;
     uint32_t GetNBytes(uint32_t index) const;
 
+    // Put packets ahead of the others of a priority, in order
+    void EnqueueFront(uint32_t index, const std::vector<Ptr<Packet>>& packets);
+
     void SetPauseFlag(uint32_t index, bool flag);
     bool GetPauseFlag(uint32_t index) const;
 
@@ -47,7 +47,8 @@ rotateLeft(uint32_t x, unsigned char bits)
 
 uint32_t 
 FlowV4Id::hash(uint32_t seed){
-    uint32_t result = prime[seed];
+    // Small seeds (one per tier) start from a table, any other seed (one per switch) is mixed in
+    uint32_t result = seed < 16 ? prime[seed] : rotateLeft(seed * Prime[0], 13);
 
     result = rotateLeft(result + m_srcPort * Prime[2], 17) * Prime[3];
     result = rotateLeft(result + m_dstPort * Prime[4], 11) * Prime[0];
@@ -1,3 +1,4 @@
+#include "ns3/abort.h"
 #include "ns3/node.h"
 #include "ns3/socket.h"
 #include "ns3/simulator.h"
@@ -9,6 +10,7 @@
 
 #include "rdma-queue-pair.h"
 #include "hpcc-header.h"
+#include "packet-tag.h"
 
 namespace ns3
 {
@@ -27,15 +29,22 @@ RdmaQueuePair::GetTypeId()
 								"The amount of data to send each time.",
 								UintegerValue(4000),
 								MakeUintegerAccessor(&RdmaQueuePair::m_sendSize),
-								MakeUintegerChecker<uint32_t>());
+								MakeUintegerChecker<uint32_t>())
+							.AddAttribute("MinRto",
+								"The lower bound of the retransmission timeout. At MaxRto, the timeout is fixed.",
+								TimeValue(MilliSeconds(2)),
+								MakeTimeAccessor(&RdmaQueuePair::m_minRto),
+								MakeTimeChecker())
+							.AddAttribute("MaxRto",
+								"The upper bound of the retransmission timeout, including backoff.",
+								TimeValue(MilliSeconds(2)),
+								MakeTimeAccessor(&RdmaQueuePair::m_maxRto),
+								MakeTimeChecker());
     return tid;
 }
 
 RdmaQueuePair::RdmaQueuePair(FlowInfo flow, Ptr<PointToPointNetDevice> device, FILE* logFilePtr, uint32_t ccVersion, uint32_t pfcVersion)
         : m_flow(flow), m_device(device), m_logFile(logFilePtr), m_ccVersion(ccVersion), m_pfcVersion(pfcVersion){
-	// Add propagation delay to RTT estimation
-	m_flow.minRttNs += m_sendSize * 8 * 1e9 / device->GetDataRate().GetBitRate();
-
 	m_port = (flow.id & 0xFFFF);
 
 	m_maxRate = device->GetDataRate();
@@ -49,12 +58,109 @@ RdmaQueuePair::RdmaQueuePair(FlowInfo flow, Ptr<PointToPointNetDevice> device, F
 	m_hpccPrevRate = m_currentRate;
 	m_lastSendTime = 0;
 	m_lastGenerateTime = 0;
+
+	// Start from the path RTT until the first sample
+	m_srtt = m_flow.minRttNs;
+	m_rttVar = m_flow.minRttNs / 2;
+
+	// Receiver-driven: one BDP of unscheduled bytes, the rest must be granted
+	m_unscheduledBytes = std::min((uint64_t)m_flow.size, (uint64_t)(m_maxRate.GetBitRate() / 8e9 * m_flow.minRttNs));
+	m_unscheduledBytes = std::max(m_unscheduledBytes, std::min(m_flow.size, m_sendSize));
+	m_grantedBytes = m_unscheduledBytes;
+
+	m_messages.push_back(Message{flow, flow.size, 0, 0});
 };
 
+void
+RdmaQueuePair::AddMessage(FlowInfo flow)
+{
+	NS_ABORT_MSG_IF(!CanAddMessage(flow), "Byte stream of QP " << m_flow.id << " overflows");
+	if(IsIdle()){
+		m_lastSendTime = 0; // nothing was outstanding, the gap is not a timeout
+		// The DCQCN timers stop with the last ACK; resume the recovery of a QP that saw a CNP
+		if(m_ccVersion == 1 && m_prevCnpTime != 0){
+			Simulator::Cancel(m_mlxUpdateAlpha);
+			Simulator::Cancel(m_mlxIncreaseRate);
+			m_mlxUpdateAlpha = Simulator::Schedule(NanoSeconds(m_flow.minRttNs - 1000), &RdmaQueuePair::UpdateMlxAlpha, this);
+			m_mlxIncreaseRate = Simulator::Schedule(NanoSeconds(m_flow.minRttNs * 2), &RdmaQueuePair::IncreaseMlxRate, this);
+		}
+	}
+	m_flow.size += flow.size;
+	m_messages.push_back(Message{flow, m_flow.size, m_timeouts, m_spuriousTimeouts});
+}
+
+bool
+RdmaQueuePair::CanAddMessage(const FlowInfo& flow) const
+{
+	// Sequence numbers are 32 bits on the wire
+	return m_flow.size + flow.size >= m_flow.size;
+}
+
+bool
+RdmaQueuePair::IsIdle() const
+{
+	return m_bytesAcked >= m_flow.size;
+}
+
+uint32_t
+RdmaQueuePair::GetPiasLevel(uint32_t bytesSent) const
+{
+	if(m_piasThreshold == 0)
+		return 0;
+	// Bytes sent of the oldest message not yet acknowledged
+	uint32_t start = m_messages.empty() ? 0 : m_messages.front().end - m_messages.front().flow.size;
+	return bytesSent - std::min(bytesSent, start) < m_piasThreshold ? 0 : 1;
+}
+
+bool
+RdmaQueuePair::IsWindowBlocked(uint32_t bytesSent) const
+{
+	uint32_t inFlight = bytesSent - m_bytesAcked;
+	if(m_ccVersion == 4)
+		return inFlight * 8 >= std::max(m_sendSize * 8 * 1.5, (double)m_win);
+	if(m_ccVersion != 5)
+		return inFlight * 8 >= std::max(m_sendSize * 8 * 1.5, m_currentRate.GetBitRate() / 1e9 * m_flow.minRttNs);
+	return false;
+}
+
+uint32_t
+RdmaQueuePair::GetTrainSegments(uint32_t maxSegments) const
+{
+	// The length of a train goes in the 16-bit BTH size
+	maxSegments = std::min(maxSegments, UINT16_MAX / m_sendSize);
+	// Only a QP paced at line rate sends back-to-back. Receiver-driven flows
+	// change priority with grants and are always sent one segment at a time.
+	if(maxSegments <= 1 || m_ccVersion == 5 || m_currentRate < m_maxRate || IsSendCompleted())
+		return 1;
+	int64_t now = Simulator::Now().GetNanoSeconds();
+	if(m_lastSendTime != 0 && now - m_lastSendTime > GetRto())
+		return 1; // GenerateNextPacket rewinds on timeout
+	if(IsWindowBlocked(m_bytesSent))
+		return 1;
+
+	uint32_t segments = 1;
+	uint32_t sent = m_bytesSent + std::min(m_flow.size - m_bytesSent, m_sendSize);
+	uint32_t level = GetPiasLevel(m_bytesSent);
+	while(segments < maxSegments && sent < m_flow.size){
+		// Each further segment must pass the window and keep the PIAS priority
+		if(IsWindowBlocked(sent) || GetPiasLevel(sent) != level)
+			break;
+		sent += std::min(m_flow.size - sent, m_sendSize);
+		segments += 1;
+	}
+	return segments;
+}
+
 int64_t 
 RdmaQueuePair::GetNextSendTime()
 {
-	return m_lastGenerateTime + (m_sendSize * 8.0 * 1e9 / m_currentRate.GetBitRate());
+	// Packet interval in ns, recomputed only when the rate changes
+	uint64_t bps = m_currentRate.GetBitRate();
+	if(bps != m_paceBps){
+		m_paceBps = bps;
+		m_paceInterval = m_sendSize * 8000000000ull / bps;
+	}
+	return m_lastGenerateTime + m_paceInterval;
 }
 
 bool RdmaQueuePair::IsSendCompleted() const 
@@ -62,20 +168,66 @@ bool RdmaQueuePair::IsSendCompleted() const
 	return m_bytesSent >= m_flow.size; 
 }
 
+bool RdmaQueuePair::IsSendBlocked() const
+{
+	if(m_ccVersion == 5 && m_bytesSent >= m_grantedBytes)
+		return true; // waiting for grants from the receiver
+	return IsSendCompleted();
+}
+
 int64_t 
 RdmaQueuePair::GetTimeOut()
 {
-	if(!IsSendCompleted())
+	if(!IsSendBlocked())
 		std::cerr << "GetTimeOut called for non-completed flow!" << std::endl;
-	return m_lastSendTime + 2000000; // 2 milliseconds
+	return m_timeOut;
+}
+
+int64_t
+RdmaQueuePair::GetRto() const
+{
+	int64_t rto = m_srtt + 4 * m_rttVar;
+	rto = std::max(rto, m_minRto.GetNanoSeconds());
+	return std::min(rto * m_rtoBackoff, m_maxRto.GetNanoSeconds());
+}
+
+void
+RdmaQueuePair::UpdateRtt(int64_t rtt)
+{
+	// Mean-deviation estimator (RFC 6298), as in RttMeanDeviation
+	if(m_rttSamples == 0){
+		m_srtt = rtt;
+		m_rttVar = rtt / 2;
+	}
+	else{
+		m_rttVar = (3 * m_rttVar + std::abs(m_srtt - rtt)) / 4;
+		m_srtt = (7 * m_srtt + rtt) / 8;
+	}
+	m_rttSamples += 1;
+}
+
+void
+RdmaQueuePair::OnTimeOut()
+{
+	m_rttSeq = 0; // Karn's algorithm: do not time retransmitted segments
+	if(m_bytesSent <= m_bytesAcked)
+		return; // nothing outstanding, e.g. waiting for grants
+
+	m_timeouts += 1;
+	m_rtoSeq = m_bytesAcked;
+	m_rtoTime = Simulator::Now().GetNanoSeconds();
+	if(GetRto() < m_maxRto.GetNanoSeconds())
+		m_rtoBackoff *= 2;
 }
 
 void 
 RdmaQueuePair::TimeOutReset()
 {
+	OnTimeOut();
 	m_port += 1; // change port for load balancing
 	m_bytesSent = m_bytesAcked;
 	m_lastSendTime = m_lastGenerateTime = Simulator::Now().GetNanoSeconds();
+	m_timeOut = m_lastSendTime + GetRto();
 	if(m_ccVersion == 1)
 		DecreaseMlxRate();
 	if(m_pfcVersion == 1)
@@ -83,23 +235,44 @@ RdmaQueuePair::TimeOutReset()
 }
 
 bool 
-RdmaQueuePair::ProcessACK(BthHeader& bth_header, HpccHeader& hpcc_header)
+RdmaQueuePair::ProcessACK(BthHeader& bth_header, HpccHeader& hpcc_header, GrantHeader& grant_header)
 {
 	if(bth_header.GetId() != m_flow.id){
 		std::cerr << "ACK for unknown flow id " << bth_header.GetId() << std::endl;
 		return false;
 	}
 
+	if(m_ccVersion == 5){
+		m_grantedBytes = std::max(m_grantedBytes, std::min(m_flow.size, grant_header.GetOffset()));
+		m_grantedPriority = grant_header.GetPriority();
+	}
+
 	uint32_t seq = bth_header.GetSequence();
 	bool newACK = seq > m_bytesAcked;
 	m_bytesAcked = std::max(m_bytesAcked, seq);
 
+	if(newACK){
+		int64_t now = Simulator::Now().GetNanoSeconds();
+		if(m_rttSeq != 0 && seq >= m_rttSeq){
+			UpdateRtt(now - m_rttTime);
+			m_rttSeq = 0;
+		}
+		if(m_rtoTime != 0 && seq > m_rtoSeq){
+			// A retransmission cannot be acknowledged faster than the path RTT
+			if(now - m_rtoTime < (int64_t)m_flow.minRttNs){
+				m_spuriousTimeouts += 1;
+			}
+			m_rtoTime = 0;
+		}
+		m_rtoBackoff = 1;
+		CompleteMessages();
+	}
+
 	if(bth_header.GetACK()){
 		if(m_bytesAcked > m_bytesSent){
 			m_bytesSent = m_bytesAcked;
 		}
 		if(m_bytesAcked >= m_flow.size){
-			WriteFCT();
 			if(m_ccVersion == 1){
 				Simulator::Cancel(m_mlxUpdateAlpha);
 				Simulator::Cancel(m_mlxIncreaseRate);
@@ -118,6 +291,7 @@ RdmaQueuePair::ProcessACK(BthHeader& bth_header, HpccHeader& hpcc_header)
 	}
 	else if(bth_header.GetNACK()){
 		m_bytesSent = m_bytesAcked;
+		m_rttSeq = 0;
 		std::cerr << "NACK received for flow " << m_flow.id << ", retransmitting from byte " << m_bytesSent << std::endl;
 	}
 	else{
@@ -135,26 +309,30 @@ RdmaQueuePair::ProcessACK(BthHeader& bth_header, HpccHeader& hpcc_header)
 		// HPCC congestion control
 		if(m_hpccLastSeq == 0){
 			m_hpccLastSeq = m_bytesSent + 1;
-			m_hpccHeaders = hpcc_header.GetIntHeaders();
+			m_hpccHeader = hpcc_header;
+			if(HpccHeader::GetPint()){
+				uint8_t hop = hpcc_header.GetSampledHop();
+				m_pintHops[hop] = hpcc_header.GetIntHeader(hop);
+				m_pintSeen = 1 << hop;
+			}
 			return false;
 		}
 
-		auto newHeaders = hpcc_header.GetIntHeaders();
-		if(newHeaders.size() != m_hpccHeaders.size()){
+		if(hpcc_header.GetNHops() != m_hpccHeader.GetNHops()){
 			std::cerr << "Inconsistent number of INT headers for flow " << m_flow.id
-					  << ": previous " << m_hpccHeaders.size()
-					  << ", current " << newHeaders.size() << std::endl;
+					  << ": previous " << (uint32_t)m_hpccHeader.GetNHops()
+					  << ", current " << (uint32_t)hpcc_header.GetNHops() << std::endl;
 			return false;
 		}
 
-		UpdateHpccRate(newHeaders, seq > m_hpccLastSeq);
+		UpdateHpccRate(hpcc_header, seq > m_hpccLastSeq);
 	}
 
 	return false;
 }
 
 Ptr<Packet>
-RdmaQueuePair::GenerateNextPacket()
+RdmaQueuePair::GenerateNextPacket(uint32_t segments)
 {
 	if(IsSendCompleted()){
 		std::cerr << "All data already sent for flow " << m_flow.id << std::endl;
@@ -172,7 +350,8 @@ RdmaQueuePair::GenerateNextPacket()
 
 	m_lastGenerateTime = Simulator::Now().GetNanoSeconds();
 
-	if(m_lastSendTime != 0 && m_lastGenerateTime - m_lastSendTime > 2000000){ // 2 milliseconds
+	if(m_lastSendTime != 0 && m_lastGenerateTime - m_lastSendTime > GetRto()){
+		OnTimeOut();
 		m_port += 1; // change port for load balancing
 		m_bytesSent = m_bytesAcked;
 		if(m_ccVersion == 1)
@@ -181,25 +360,30 @@ RdmaQueuePair::GenerateNextPacket()
 			std::cerr << "Timeout detected for flow " << m_flow.id << ", retransmitting from byte " << m_bytesSent << std::endl;
 	}
 	else{
-		uint32_t inFlight = m_bytesSent - m_bytesAcked;
-		if(m_ccVersion == 4){
-			// std::cout << "Flow " << m_flow.id << " in-flight " << inFlight << " bytes, window " << m_win / 8 << " bytes." << std::endl;
-			if(inFlight * 8 >= std::max(m_sendSize * 8 * 1.5, (double)m_win)){
-				// std::cout << "Flow " << m_flow.id << " in-flight " << inFlight << " bytes, window " << m_win / 8 << " bytes." << std::endl;
-				// std::cout << "Flow " << m_flow.id << " is limited by window, not sending new packet." << std::endl;
-				return nullptr;
-			}
-		}
-		else{
-			if(inFlight * 8 >= std::max(m_sendSize * 8 * 1.5, m_currentRate.GetBitRate() / 1e9 * m_flow.minRttNs)){ 
-				return nullptr;
-			}
+		if(IsWindowBlocked(m_bytesSent)){
+			return nullptr;
 		}
 	}
 
+	// Receiver-driven transport is limited by grants instead of a window
+	if(m_ccVersion == 5 && m_bytesSent >= m_grantedBytes){
+		return nullptr;
+	}
+
 	m_lastSendTime = Simulator::Now().GetNanoSeconds();
+	m_timeOut = m_lastSendTime + GetRto();
+
+	uint32_t toSend = std::min(m_flow.size - m_bytesSent, m_sendSize * std::max(1u, segments));
+	segments = (toSend + m_sendSize - 1) / m_sendSize;
 
-	uint32_t toSend = std::min(m_flow.size - m_bytesSent, m_sendSize);
+	// Time one new segment at a time for RTT estimation
+	if(m_bytesSent + toSend > m_maxSent){
+		if(m_rttSeq == 0){
+			m_rttSeq = m_bytesSent + std::min(toSend, m_sendSize);
+			m_rttTime = m_lastSendTime;
+		}
+		m_maxSent = m_bytesSent + toSend;
+	}
 	Ptr<Packet> ret = Create<Packet>(toSend);
 
 	BthHeader bth_header;
@@ -213,6 +397,13 @@ RdmaQueuePair::GenerateNextPacket()
 		HpccHeader hpcc_header;
 		ret->AddHeader(hpcc_header);
 	}
+	// Receiver-driven transport
+	else if(m_ccVersion == 5){
+		GrantHeader grant_header;
+		grant_header.SetSize(m_flow.size);
+		grant_header.SetOffset(m_unscheduledBytes);
+		ret->AddHeader(grant_header);
+	}
 
 	UdpHeader udp_header;
 	udp_header.SetSourcePort(m_port);
@@ -229,23 +420,54 @@ RdmaQueuePair::GenerateNextPacket()
 	ret->AddHeader(ipv4_header);
 
 	SocketPriorityTag tag;
-	tag.SetPriority(m_dataPriority);
+	if(m_ccVersion == 5)
+		tag.SetPriority(m_bytesSent < m_unscheduledBytes ? m_unscheduledPriority : m_grantedPriority);
+	else if(GetPiasLevel() == 0 && m_piasThreshold > 0)
+		tag.SetPriority(m_piasPriority);
+	else
+		tag.SetPriority(m_dataPriority);
 	ret->ReplacePacketTag(tag);
 
+	if(segments > 1){
+		// Pad for the headers of the other segments, PPP included
+		uint32_t headerSize = ret->GetSize() - toSend + 2;
+		ret->AddPaddingAtEnd((segments - 1) * headerSize);
+		TrainTag train;
+		train.SetSegments(segments);
+		train.SetSegmentSize(m_sendSize);
+		ret->ReplacePacketTag(train);
+	}
+
 	m_bytesSent += toSend;
 	return ret;
 }
 
+void
+RdmaQueuePair::CompleteMessages(){
+	while(!m_messages.empty() && m_messages.front().end <= m_bytesAcked){
+		WriteFCT(m_messages.front());
+		m_messages.pop_front();
+	}
+}
+
 void 
-RdmaQueuePair::WriteFCT(){
-	if(m_flow.endTime == 0){
-		m_flow.endTime = Simulator::Now().GetNanoSeconds();
-		fprintf(m_logFile, "%u,%u,%u,%u,%lu,%lu,%lu\n",
-			m_flow.id, m_flow.src, m_flow.dst,
-			m_flow.size, m_flow.startTime, m_flow.endTime,
-			m_flow.endTime - m_flow.startTime
-		);
-		fflush(m_logFile);
+RdmaQueuePair::WriteFCT(Message& message){
+	FlowInfo& flow = message.flow;
+	if(flow.endTime == 0){
+		flow.endTime = Simulator::Now().GetNanoSeconds();
+		if(m_logFile != nullptr){
+			fprintf(m_logFile, "%u,%u,%u,%u,%lu,%lu,%lu,%u,%u,%lu\n",
+				flow.id, flow.src, flow.dst,
+				flow.size, flow.startTime, flow.endTime,
+				flow.endTime - flow.startTime,
+				m_timeouts - message.timeouts, m_spuriousTimeouts - message.spuriousTimeouts,
+				flow.idealFctNs
+			);
+			fflush(m_logFile);
+		}
+		// Deferred, so that a callback starting a flow does not re-enter this QP
+		if(m_device != nullptr)
+			Simulator::ScheduleNow(&PointToPointNetDevice::NotifyFlowComplete, m_device, flow);
 	}
 }
 
@@ -358,26 +580,45 @@ RdmaQueuePair::IncreaseMlxRate(){
 	m_mlxIncreaseRate = Simulator::Schedule(NanoSeconds(m_flow.minRttNs * 2), &RdmaQueuePair::IncreaseMlxRate, this);
 }
 
+double
+RdmaQueuePair::GetHpccUtil(const IntHeader& newHeader, const IntHeader& oldHeader, uint64_t& tau) const
+{
+	tau = newHeader.GetTimeDelta(oldHeader);
+	double duration = tau * 1e-9; // in seconds
+	uint64_t bytes = newHeader.GetBytesDelta(oldHeader);
+	double txRate = bytes * 8.0 / duration; // in bps
+	return txRate / newHeader.GetRate().GetBitRate() +
+		std::min(newHeader.GetQueueLen(), oldHeader.GetQueueLen()) / (m_flow.minRttNs * 1e-9) / m_maxRate.GetBitRate();
+}
+
 void 
-RdmaQueuePair::UpdateHpccRate(std::vector<IntHeader> newHeaders, bool fullUpdate){
+RdmaQueuePair::UpdateHpccRate(const HpccHeader& hpcc_header, bool fullUpdate){
 	double Util = 0;
 	uint64_t dt = 0;
-	for(uint32_t i = 0;i < newHeaders.size();++i){
-		auto& newHeader = newHeaders[i];
-		auto& oldHeader = m_hpccHeaders[i];
-
-		uint64_t tau = newHeader.GetTimeDelta(oldHeader);
-		double duration = tau * 1e-9; // in seconds
-		uint64_t bytes = newHeader.GetBytesDelta(oldHeader);
-		double txRate = bytes * 8.0 / duration; // in bps
-		double util = txRate / newHeader.GetRate().GetBitRate() +
-			std::min(newHeader.GetQueueLen(), oldHeader.GetQueueLen()) / (m_flow.minRttNs * 1e-9) / m_maxRate.GetBitRate();
-		
-		if(util > Util){
-			Util = util;
-			dt = tau;
+	if(HpccHeader::GetPint()){
+		// One hop per ACK: update its utilization, then take the most utilized hop seen
+		uint8_t hop = hpcc_header.GetSampledHop();
+		const IntHeader& sample = hpcc_header.GetIntHeader(hop);
+		bool seen = m_pintSeen & (1 << hop);
+		if(seen)
+			m_pintUtil[hop] = GetHpccUtil(sample, m_pintHops[hop], dt);
+		m_pintHops[hop] = sample;
+		m_pintSeen |= 1 << hop;
+		if(!seen)
+			return;
+		for(uint8_t i = 0;i < hpcc_header.GetNHops();++i)
+			Util = std::max(Util, m_pintUtil[i]);
+	}
+	else{
+		for(uint8_t i = 0;i < hpcc_header.GetNHops();++i){
+			uint64_t tau;
+			double util = GetHpccUtil(hpcc_header.GetIntHeader(i), m_hpccHeader.GetIntHeader(i), tau);
+			if(util > Util){
+				Util = util;
+				dt = tau;
+			}
 		}
-		m_hpccHeaders[i] = newHeader;
+		m_hpccHeader = hpcc_header;
 	}
 
 	DataRate newRate;
@@ -7,8 +7,11 @@
 
 #include "bth-header.h"
 #include "hpcc-header.h"
+#include "grant-header.h"
 #include "point-to-point-net-device.h"
 
+#include <deque>
+
 namespace ns3
 {
 
@@ -21,9 +24,12 @@ struct FlowInfo
     uint64_t startTime;
     uint64_t endTime;
 	uint64_t minRttNs;
+	uint64_t idealFctNs;
+	uint32_t tenant{0}; /**< Messages of a tenant share a persistent QP */
+	uint32_t weight{1}; /**< Share of the NIC under weighted fair queuing */
 
-    FlowInfo(uint32_t _id = 0, uint32_t _src = 0, uint32_t _dst = 0, uint32_t _size = 0, uint64_t _startTime = 0, uint64_t _endTime = 0, uint64_t _minRttNs = 0)
-        : id(_id), src(_src), dst(_dst), size(_size), startTime(_startTime), endTime(_endTime), minRttNs(_minRttNs)
+    FlowInfo(uint32_t _id = 0, uint32_t _src = 0, uint32_t _dst = 0, uint32_t _size = 0, uint64_t _startTime = 0, uint64_t _endTime = 0, uint64_t _minRttNs = 0, uint64_t _idealFctNs = 0)
+        : id(_id), src(_src), dst(_dst), size(_size), startTime(_startTime), endTime(_endTime), minRttNs(_minRttNs), idealFctNs(_idealFctNs)
     {
     }
 };
@@ -38,12 +44,42 @@ public:
     RdmaQueuePair(FlowInfo flow, Ptr<PointToPointNetDevice> device = nullptr, FILE* logFilePtr = nullptr, uint32_t ccVersion = 0, uint32_t pfcVersion = 0);
 
 	uint32_t GetId() const { return m_flow.id; }
+	const FlowInfo& GetFlow() const { return m_flow; }
 
 	bool IsSendCompleted() const;
 
-	bool ProcessACK(BthHeader& bth_header, HpccHeader& hpcc_header);
+	bool IsSendBlocked() const;
+
+	// Bytes sent and not yet acknowledged, the only ones a timeout retransmits
+	bool HasOutstanding() const { return m_bytesSent > m_bytesAcked; }
+
+	// Persistent QP: append a message to the byte stream
+	void AddMessage(FlowInfo flow);
+	// The message fits in the 4GB byte stream of the QP
+	bool CanAddMessage(const FlowInfo& flow) const;
+
+	// All messages are acknowledged
+	bool IsIdle() const;
+
+	// The QP has an entry in the send queue of the device
+	bool IsQueued() const { return m_queued; }
+	void SetQueued(bool queued) { m_queued = queued; }
+
+	// NIC arbitration among QPs
+	uint32_t GetRemainingBytes() const { return m_flow.size - std::min(m_bytesSent, m_flow.size); }
+	uint32_t GetWeight() const { return std::max(1u, m_flow.weight); }
+	int64_t GetWfqFinish() const { return m_wfqFinish; }
+	void SetWfqFinish(int64_t finish) { m_wfqFinish = finish; }
+	void SetPiasThreshold(uint32_t threshold) { m_piasThreshold = threshold; }
+	uint32_t GetPiasLevel() const { return GetPiasLevel(m_bytesSent); }
 
-	Ptr<Packet> GenerateNextPacket();
+	bool ProcessACK(BthHeader& bth_header, HpccHeader& hpcc_header, GrantHeader& grant_header);
+
+	// Packet trains: how many segments from now would leave back-to-back
+	uint32_t GetTrainSegments(uint32_t maxSegments) const;
+	uint32_t GetSegmentSize() const { return m_sendSize; }
+
+	Ptr<Packet> GenerateNextPacket(uint32_t segments = 1);
 
 	int64_t GetNextSendTime();
 
@@ -51,9 +87,19 @@ public:
 
 	void TimeOutReset();
 
+	int64_t GetRto() const;
+
 	static const uint8_t m_dataPriority{2};
 	static const uint8_t m_ackPriority{2};
 
+	// Receiver-driven transport priorities
+	static const uint8_t m_grantPriority{0};
+	static const uint8_t m_unscheduledPriority{1};
+	static const uint8_t m_scheduledPriority{2};
+
+	// PIAS: bytes below the threshold go ahead of the data priority
+	static const uint8_t m_piasPriority{1};
+
 private:
 	uint16_t m_port{0};
 
@@ -66,15 +112,58 @@ private:
 	DataRate m_currentRate;
 	DataRate m_increase;
 
+	uint64_t m_paceBps{0}; /**< Rate of m_paceInterval */
+	int64_t m_paceInterval{0}; /**< Time between packets at m_paceBps, in ns */
+
 	int64_t m_lastSendTime{0};
 	int64_t m_lastGenerateTime{0};
 
-	FlowInfo m_flow;
+	// Retransmission timeout
+	Time m_minRto;
+	Time m_maxRto;
+
+	int64_t m_timeOut{0};
+	int64_t m_srtt{0};
+	int64_t m_rttVar{0};
+	uint32_t m_rttSamples{0};
+	uint32_t m_rtoBackoff{1};
+
+	uint32_t m_rttSeq{0}; /**< Sequence of the segment being timed, 0 if none */
+	int64_t m_rttTime{0};
+	uint32_t m_maxSent{0};
+
+	uint32_t m_timeouts{0};
+	uint32_t m_spuriousTimeouts{0};
+	uint32_t m_rtoSeq{0};
+	int64_t m_rtoTime{0};
+
+	bool IsWindowBlocked(uint32_t bytesSent) const;
+	uint32_t GetPiasLevel(uint32_t bytesSent) const;
+
+	void UpdateRtt(int64_t rtt);
+	void OnTimeOut();
+
+	FlowInfo m_flow; /**< The byte stream of the QP: id of its first message, size of all messages */
+
+	struct Message
+	{
+		FlowInfo flow;
+		uint32_t end; /**< Offset of the message end in the stream */
+		uint32_t timeouts; /**< Counters of the QP when the message was added */
+		uint32_t spuriousTimeouts;
+	};
+
+	std::deque<Message> m_messages; /**< Messages not yet acknowledged */
+	bool m_queued{false};
+
+	int64_t m_wfqFinish{0}; /**< Virtual finish time of the last packet */
+	uint32_t m_piasThreshold{0}; /**< Bytes of a message sent at high priority, 0 to disable */
 
 	Ptr<PointToPointNetDevice> m_device;
 	FILE* m_logFile;
 
-	void WriteFCT();
+	void CompleteMessages();
+	void WriteFCT(Message& message);
 
 	// Congestion Control
 	uint32_t m_ccVersion{0};
@@ -121,9 +210,21 @@ private:
 	double m_hpccUtil{0.0};
 	DataRate m_hpccPrevRate{0};
 
-	std::vector<IntHeader> m_hpccHeaders;
+	HpccHeader m_hpccHeader; /**< INT of the last ACK */
+
+	// With PINT, the last INT and utilization of each hop
+	IntHeader m_pintHops[HpccHeader::MAX_HOPS];
+	double m_pintUtil[HpccHeader::MAX_HOPS]{};
+	uint8_t m_pintSeen{0}; /**< bit per hop with an INT */
+
+	/** The utilization of a hop between two INT, and the time between them */
+	double GetHpccUtil(const IntHeader& newHeader, const IntHeader& oldHeader, uint64_t& tau) const;
+	void UpdateHpccRate(const HpccHeader& hpcc_header, bool fullUpdate);
 
-	void UpdateHpccRate(std::vector<IntHeader> newHeaders, bool fullUpdate);
+	// Receiver-driven variables
+	uint32_t m_unscheduledBytes{0};
+	uint32_t m_grantedBytes{0};
+	uint8_t m_grantedPriority{m_scheduledPriority};
 };
 
 } // namespace ns3
@@ -23,6 +23,9 @@
 #include "point-to-point-channel.h"
 #include "pfc-header.h"
 #include "ppp-header.h"
+#include "bth-header.h"
+#include "hpcc-header.h"
+#include "grant-header.h"
 #include "packet-tag.h"
 
 #include <unordered_map>
@@ -66,7 +69,9 @@ SwitchNode::AddDevice(Ptr<NetDevice> device)
     Simulator::ScheduleWithContext(GetId(), Seconds(0.0), &NetDevice::Initialize, device);
     NotifyDeviceAdded(device);
     Ptr<PointToPointNetDevice> ptpDev = DynamicCast<PointToPointNetDevice>(device);
+    m_ports.push_back(ptpDev);
     if(ptpDev){
+        ptpDev->SetSwitch(this);
         Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel>(ptpDev->GetChannel());
         m_hdrmBuffer[ptpDev] = ptpDev->GetDataRate().GetBitRate() * channel->GetDelay().GetSeconds() / 8.0 * 3.0; // 3 RTT
         m_usedHdrm[ptpDev] = 0;
@@ -116,11 +121,18 @@ SwitchNode::SetCC(uint32_t cc)
     m_cc = cc;
 }
 
+void
+SwitchNode::SetTrim(bool trim)
+{
+    m_trim = trim;
+}
+
 void
 SwitchNode::SetId(uint32_t id)
 {
     m_nid = id;
-    m_uniformVar.SetStream(id);
+    m_uniformVar.SetStream(ECN_STREAM_BASE + id);
+    m_intSampleVar.SetStream(INT_SAMPLE_STREAM_BASE + id);
 }
 
 uint32_t
@@ -129,13 +141,62 @@ SwitchNode::GetId()
     return m_nid;
 }
 
+UniformRandomVariable&
+SwitchNode::GetIntSampler()
+{
+    return m_intSampleVar;
+}
+
+void
+SwitchNode::SetBufferSampler(Ptr<BufferSampler> sampler, uint32_t decimation)
+{
+    m_sampler = sampler;
+    m_sampleDecimation = decimation;
+    m_bufferChanges.assign(m_ports.size(), 0);
+}
+
+void
+SwitchNode::SampleBuffers(Time interval, Time stop)
+{
+    for(auto dev : m_ports){
+        if(dev)
+            RecordBuffer(dev, BufferSampler::PERIODIC);
+    }
+    if(Simulator::Now() + interval < stop)
+        Simulator::Schedule(interval, &SwitchNode::SampleBuffers, this, interval, stop);
+}
+
+void
+SwitchNode::RecordBuffer(Ptr<PointToPointNetDevice> dev, BufferSampler::Trigger trigger)
+{
+    BufferSampler::Record record;
+    record.time = Simulator::Now().GetNanoSeconds();
+    record.node = m_nid;
+    record.port = dev->GetIfIndex();
+    record.trigger = trigger;
+    record.egress = m_usedEgress[dev];
+    record.ingress = m_usedIngress[dev];
+    record.headroom = m_usedHdrm[dev];
+    record.shared = m_usedShared;
+    m_sampler->Add(record);
+}
+
 void
-SwitchNode::SetOutput(std::string output)
+SwitchNode::NotifyBufferChange(Ptr<PointToPointNetDevice> dev)
 {
-    m_output = output;
-    std::string out_file = m_output + ".node";
-    FILE* fout = fopen(out_file.c_str(), "w");
-    fclose(fout);
+    uint32_t& changes = m_bufferChanges[dev->GetIfIndex()];
+    if(++changes == m_sampleDecimation){
+        changes = 0;
+        RecordBuffer(dev, BufferSampler::CHANGE);
+    }
+}
+
+void
+SwitchNode::DoDispose()
+{
+    // Written out by the last switch to let go of it
+    m_sampler = nullptr;
+    Node::DoDispose();
 }
 
 void
@@ -144,6 +205,21 @@ SwitchNode::AddHostRouteTo(uint32_t dst, uint32_t devId)
     m_route[dst].push_back(devId);
 }
 
+void
+SwitchNode::AddHostRouteTo(uint32_t dst, const std::vector<uint32_t>& devIds)
+{
+    std::vector<uint32_t>& route = m_route[dst];
+    route.insert(route.end(), devIds.begin(), devIds.end());
+}
+
+const std::vector<uint32_t>&
+SwitchNode::GetHostRoute(uint32_t dst) const
+{
+    static const std::vector<uint32_t> noRoute;
+    auto it = m_route.find(dst);
+    return it == m_route.end() ? noRoute : it->second;
+}
+
 Ptr<Packet>
 SwitchNode::EgressPipeline(Ptr<Packet> packet, uint16_t protocol, Ptr<PointToPointNetDevice> dev){
     if(protocol != 0x0800)
@@ -156,7 +232,7 @@ SwitchNode::EgressPipeline(Ptr<Packet> packet, uint16_t protocol, Ptr<PointToPoi
     if(!packet->PeekPacketTag(packetTag))
         std::cerr << "Fail to find packetTag" << std::endl;
 
-    Ptr<PointToPointNetDevice> ingressDev = packetTag.GetNetDevice();
+    Ptr<PointToPointNetDevice> ingressDev = m_ports[packetTag.GetPort()];
 
     m_usedEgress[dev] -= packetTag.GetSize();
     if(m_usedEgress[dev] < 0){
@@ -187,6 +263,12 @@ SwitchNode::EgressPipeline(Ptr<Packet> packet, uint16_t protocol, Ptr<PointToPoi
 
     packet->AddHeader(ppp);
 
+    if(m_sampleDecimation > 0){
+        NotifyBufferChange(dev);
+        if(ingressDev != dev)
+            NotifyBufferChange(ingressDev);
+    }
+
     if(ShouldResume(ingressDev)){
         SendPFC(ingressDev, false);
     }
@@ -203,17 +285,33 @@ SwitchNode::IngressPipeline(Ptr<Packet> packet, uint16_t protocol, Ptr<PointToPo
     // if(m_uniformVar.GetValue(0.0, 1.0) < 0.01)
     //    return false;
 
+    // A train is only forwarded whole where none of its segments would queue,
+    // be marked or trigger PFC; elsewhere its segments go one by one
+    TrainTag train;
+    bool isTrain = packet->PeekPacketTag(train) && train.GetSegments() > 1;
+    if(isTrain && (!CanForwardTrain(packet, train, dev) || !dev->GetPeer()->CommitTrain(train.GetId())))
+        return SplitTrain(packet, train, protocol, dev);
+
     // Drop check
-    if((int32_t)packet->GetSize() + m_usedHdrm[dev] > m_hdrmBuffer[dev] && 
-       (int32_t)packet->GetSize() + GetUsedShared(dev) > GetSharedThreshold(dev)){
-        m_drops += 1;
-        if(m_pfc != 0){
-            std::cerr << "Drop packet in Switch " << m_nid << " under PFC mode" << std::endl;
+    if(!isTrain && ShouldDrop(packet, dev)){
+        // Cut the payload and forward the headers if trimming is enabled
+        Ptr<Packet> trimmed = m_trim ? TrimPacket(packet) : nullptr;
+        if(trimmed == nullptr || ShouldDrop(trimmed, dev)){
+            m_drops += 1;
+            if(m_pfc != 0){
+                std::cerr << "Drop packet in Switch " << m_nid << " under PFC mode" << std::endl;
+            }
+            if(m_drops % 10000 == 0){
+                std::cerr << "Switch " << m_nid << " drop count: " << m_drops << std::endl;
+            }
+            return false;
         }
-        if(m_drops % 10000 == 0){
-            std::cerr << "Switch " << m_nid << " drop count: " << m_drops << std::endl;
+
+        m_trims += 1;
+        if(m_trims % 10000 == 0){
+            std::cerr << "Switch " << m_nid << " trim count: " << m_trims << std::endl;
         }
-        return false;
+        packet = trimmed;
     }
 
     // Routing
@@ -230,79 +328,253 @@ SwitchNode::IngressPipeline(Ptr<Packet> packet, uint16_t protocol, Ptr<PointToPo
     }
     ipv4_header.SetTtl(ttl - 1);
 
-    const std::vector<uint32_t>& route_vec = m_route[ipv4_header.GetDestination().Get()];
-    if(route_vec.size() == 0){
-        std::cout << "Fail to get next dev" << std::endl;
-        return false;
-    }
-
-    FlowV4Id id = FlowV4Id(ipv4_header.GetSource().Get(),
-                           ipv4_header.GetDestination().Get(),
-                           udp_header.GetSourcePort(),
-                           udp_header.GetDestinationPort());
-
-    uint32_t hashValue = 0;
-    if(route_vec.size() > 1)
-        hashValue = id.hash(m_hashSeed);
-    uint32_t devId = route_vec[hashValue % route_vec.size()];
-    if(devId >= GetNDevices()){
-        std::cout << "Error devId in SwitchNode" << std::endl;
+    Ptr<PointToPointNetDevice> egressDev = GetEgressDevice(ipv4_header, udp_header);
+    if(egressDev == nullptr)
         return false;
-    }
 
     packet->AddHeader(udp_header);
     packet->AddHeader(ipv4_header);
 
 
-    // Buffer update    
-    Ptr<PointToPointNetDevice> egressDev = DynamicCast<PointToPointNetDevice>(GetDevice(devId));
-    if(egressDev == nullptr){
-        std::cout << "Fail to get PointToPointNetDevice in SwitchNode" << std::endl;
+    // Buffer update, a train passing through holds one segment at a time
+    int32_t size = packet->GetSize();
+    if(isTrain)
+        size = (size + train.GetSegments() - 1) / train.GetSegments();
+
+    AddToBuffer(packet, size, dev, egressDev);
+
+    if(ShouldECN(egressDev)){
+        m_ecnCount += 1;
+        packet->RemoveHeader(ipv4_header);
+        ipv4_header.SetEcn(Ipv4Header::ECN_CE);
+        packet->AddHeader(ipv4_header);
+    }
+
+    // Send packet
+    if(!egressDev->Send(packet, egressDev->GetBroadcast(), protocol)){
+        std::cout << "Fail to send packet in SwitchNode" << std::endl;
         return false;
     }
+    return true;
+}
 
+void
+SwitchNode::AddToBuffer(Ptr<Packet> packet, int32_t size, Ptr<PointToPointNetDevice> dev,
+                        Ptr<PointToPointNetDevice> egressDev)
+{
     PacketTag packetTag;
-    packetTag.SetSize(packet->GetSize());
-    packetTag.SetNetDevice(dev);
+    packetTag.SetSize(size);
+    packetTag.SetPort(dev->GetIfIndex());
 
-    m_usedEgress[egressDev] += packet->GetSize();
+    m_usedEgress[egressDev] += size;
 
-    int32_t newBytes = packet->GetSize() + m_usedIngress[dev];
+    int32_t newBytes = size + m_usedIngress[dev];
     if(newBytes <= RESERVED_SIZE){
         m_usedIngress[dev] = newBytes;
     }
     else {
         int32_t thresh = GetSharedThreshold(dev);
 		if(newBytes - RESERVED_SIZE > thresh){
-			m_usedHdrm[dev] += packet->GetSize();
+			m_usedHdrm[dev] += size;
 		}
         else{
             m_usedIngress[dev] = newBytes;
-            int32_t toShared = std::min((int32_t)packet->GetSize(), newBytes - RESERVED_SIZE);
+            int32_t toShared = std::min(size, newBytes - RESERVED_SIZE);
             m_usedShared += toShared;
 		}
     }
 
     packet->ReplacePacketTag(packetTag);
 
+    if(m_sampleDecimation > 0){
+        NotifyBufferChange(egressDev);
+        if(egressDev != dev)
+            NotifyBufferChange(dev);
+    }
 
     if(ShouldPause(dev)){
         SendPFC(dev, true);
     }
+}
 
-    if(ShouldECN(egressDev)){
-        m_ecnCount += 1;
-        packet->RemoveHeader(ipv4_header);
-        ipv4_header.SetEcn(Ipv4Header::ECN_CE);
-        packet->AddHeader(ipv4_header);
+void
+SwitchNode::AdmitTrainTail(const std::vector<Ptr<Packet>>& tail, Ptr<PointToPointNetDevice> egressDev, uint32_t port)
+{
+    // Routed with the train, the segments only take the buffer it passed without
+    for(auto& segment : tail)
+        AddToBuffer(segment, segment->GetSize(), m_ports[port], egressDev);
+}
+
+Ptr<PointToPointNetDevice>
+SwitchNode::GetEgressDevice(const Ipv4Header& ipv4_header, const UdpHeader& udp_header)
+{
+    const std::vector<uint32_t>& route_vec = m_route[ipv4_header.GetDestination().Get()];
+    if(route_vec.size() == 0){
+        std::cout << "Fail to get next dev" << std::endl;
+        return nullptr;
     }
 
-    // Send packet
-    if(!egressDev->Send(packet, egressDev->GetBroadcast(), protocol)){
-        std::cout << "Fail to send packet in SwitchNode" << std::endl;
+    FlowV4Id id = FlowV4Id(ipv4_header.GetSource().Get(),
+                           ipv4_header.GetDestination().Get(),
+                           udp_header.GetSourcePort(),
+                           udp_header.GetDestinationPort());
+
+    uint32_t hashValue = 0;
+    if(route_vec.size() > 1)
+        hashValue = id.hash(m_hashSeed);
+    uint32_t devId = route_vec[hashValue % route_vec.size()];
+    if(devId >= GetNDevices()){
+        std::cout << "Error devId in SwitchNode" << std::endl;
+        return nullptr;
+    }
+
+    Ptr<PointToPointNetDevice> egressDev = m_ports[devId];
+    if(egressDev == nullptr)
+        std::cout << "Fail to get PointToPointNetDevice in SwitchNode" << std::endl;
+    return egressDev;
+}
+
+bool
+SwitchNode::CanForwardTrain(Ptr<Packet> packet, TrainTag& train, Ptr<PointToPointNetDevice> dev)
+{
+    Ipv4Header ipv4_header;
+    UdpHeader udp_header;
+    packet->RemoveHeader(ipv4_header);
+    packet->PeekHeader(udp_header);
+    packet->AddHeader(ipv4_header);
+
+    Ptr<PointToPointNetDevice> egressDev = GetEgressDevice(ipv4_header, udp_header);
+    if(egressDev == nullptr || ipv4_header.GetTtl() <= 1)
+        return false;
+
+    // Each segment leaves as the next one arrives. A faster egress would be
+    // idle between segments, which the train cannot share with other packets.
+    int32_t segment = (packet->GetSize() + train.GetSegments() - 1) / train.GetSegments();
+    if(!egressDev->IsTxIdle() || egressDev->GetTxTime(segment) != train.GetGap())
+        return false;
+
+    // No segment is dropped, triggers PFC or may be marked
+    if(m_pause[dev] || m_usedHdrm[dev] > 0 || m_usedIngress[dev] + segment > RESERVED_SIZE)
         return false;
+    return m_usedEgress[egressDev] + (int32_t)egressDev->GetBackgroundQueue() + segment < m_kmin[egressDev];
+}
+
+bool
+SwitchNode::SplitTrain(Ptr<Packet> packet, TrainTag& train, uint16_t protocol, Ptr<PointToPointNetDevice> dev)
+{
+    // The head segment arrived now, the others follow every gap
+    std::vector<Ptr<Packet>> segments = GetTrainSegments(packet, train, m_cc, 0);
+    for(uint32_t i = 1;i < segments.size();++i)
+        Simulator::Schedule(train.GetGap() * i, &SwitchNode::ReceiveTrainSegment, this, segments[i], protocol, dev,
+            train.GetId(), i, segments.size());
+    return IngressPipeline(segments[0], protocol, dev);
+}
+
+void
+SwitchNode::ReceiveTrainSegment(Ptr<Packet> segment, uint16_t protocol, Ptr<PointToPointNetDevice> dev,
+    uint64_t train, uint32_t index, uint32_t segments)
+{
+    // A pause before the segment started takes it back to the sender
+    Ptr<PointToPointNetDevice> peer = dev->GetPeer();
+    bool sent = index < peer->GetSentSegments(train);
+    if(index + 1 == segments)
+        peer->ForgetTrain(train);
+    if(sent)
+        IngressPipeline(segment, protocol, dev);
+}
+
+std::vector<Ptr<Packet>>
+SwitchNode::GetTrainSegments(Ptr<const Packet> packet, const TrainTag& train, uint32_t cc, uint32_t first)
+{
+    Ptr<Packet> p = packet->Copy();
+
+    Ipv4Header ipv4_header;
+    UdpHeader udp_header;
+    HpccHeader hpcc_header;
+    GrantHeader grant_header;
+    BthHeader bth_header;
+
+    p->RemoveHeader(ipv4_header);
+    p->RemoveHeader(udp_header);
+    if(cc == 2)
+        p->RemoveHeader(hpcc_header);
+    else if(cc == 5)
+        p->RemoveHeader(grant_header);
+    p->RemoveHeader(bth_header);
+
+    SocketPriorityTag priorityTag;
+    packet->PeekPacketTag(priorityTag);
+
+    std::vector<Ptr<Packet>> segments;
+    uint32_t total = bth_header.GetSize();
+    uint32_t start = bth_header.GetSequence() - total;
+    uint32_t segmentSize = train.GetSegmentSize();
+    for(uint32_t i = first;i < train.GetSegments();++i){
+        uint32_t size = std::min(segmentSize, total - i * segmentSize);
+        Ptr<Packet> segment = Create<Packet>(size);
+        bth_header.SetSize(size);
+        bth_header.SetSequence(start + i * segmentSize + size);
+        segment->AddHeader(bth_header);
+        if(cc == 2)
+            segment->AddHeader(hpcc_header);
+        else if(cc == 5)
+            segment->AddHeader(grant_header);
+        segment->AddHeader(udp_header);
+        ipv4_header.SetPayloadSize(size + 20);
+        segment->AddHeader(ipv4_header);
+        segment->ReplacePacketTag(priorityTag);
+        segments.push_back(segment);
     }
-    return true;
+    return segments;
+}
+
+bool
+SwitchNode::ShouldDrop(Ptr<Packet> packet, Ptr<PointToPointNetDevice> dev)
+{
+    return (int32_t)packet->GetSize() + m_usedHdrm[dev] > m_hdrmBuffer[dev] && 
+        (int32_t)packet->GetSize() + GetUsedShared(dev) > GetSharedThreshold(dev);
+}
+
+Ptr<Packet>
+SwitchNode::TrimPacket(Ptr<Packet> packet)
+{
+    Ptr<Packet> p = packet->Copy();
+
+    Ipv4Header ipv4_header;
+    UdpHeader udp_header;
+    HpccHeader hpcc_header;
+    GrantHeader grant_header;
+    BthHeader bth_header;
+
+    p->RemoveHeader(ipv4_header);
+    p->RemoveHeader(udp_header);
+    if(udp_header.GetDestinationPort() != BthHeader::ROCE_UDP_PORT)
+        return nullptr;
+    if(m_cc == 2)
+        p->RemoveHeader(hpcc_header);
+    else if(m_cc == 5)
+        p->RemoveHeader(grant_header);
+    p->RemoveHeader(bth_header);
+
+    // Only data packets are trimmed, and only once
+    if(bth_header.GetACK() || bth_header.GetNACK() || bth_header.GetTrim() || p->GetSize() == 0)
+        return nullptr;
+
+    Ptr<Packet> ret = Create<Packet>(0);
+    bth_header.SetTrim();
+    ret->AddHeader(bth_header);
+    if(m_cc == 2)
+        ret->AddHeader(hpcc_header);
+    else if(m_cc == 5)
+        ret->AddHeader(grant_header);
+    ret->AddHeader(udp_header);
+    ipv4_header.SetPayloadSize(20);
+    ret->AddHeader(ipv4_header);
+
+    SocketPriorityTag tag;
+    tag.SetPriority(TRIM_PRIORITY);
+    ret->ReplacePacketTag(tag);
+    return ret;
 }
 
 int32_t 
@@ -322,11 +594,12 @@ SwitchNode::GetUsedShared(Ptr<PointToPointNetDevice> dev)
 bool
 SwitchNode::ShouldECN(Ptr<PointToPointNetDevice> dev)
 {
-    if(m_usedEgress[dev] < m_kmin[dev])
+    int32_t used = m_usedEgress[dev] + dev->GetBackgroundQueue();
+    if(used < m_kmin[dev])
         return false;
-    if(m_usedEgress[dev] > m_kmax[dev])
+    if(used > m_kmax[dev])
         return true;
-    double prob = 0.2 * (m_usedEgress[dev] - m_kmin[dev]) / (m_kmax[dev] - m_kmin[dev]);
+    double prob = 0.2 * (used - m_kmin[dev]) / (m_kmax[dev] - m_kmin[dev]);
     double rand_val = m_uniformVar.GetValue(0.0, 1.0);
     return rand_val < prob;
 }
@@ -3,8 +3,12 @@
 
 #include "ns3/node.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/udp-header.h"
 
+#include "buffer-sampler.h"
 #include "point-to-point-net-device.h"
+#include "packet-tag.h"
 
 #include <unordered_map>
 
@@ -53,29 +57,67 @@ public:
                                 const Address& from);
 
     void AddHostRouteTo(uint32_t dst, uint32_t devId);
+    void AddHostRouteTo(uint32_t dst, const std::vector<uint32_t>& devIds);
+    const std::vector<uint32_t>& GetHostRoute(uint32_t dst) const;
 
     void SetECMPHash(uint32_t hashSeed);
     void SetPFC(uint32_t pfc);
     void SetCC(uint32_t cc);
+    void SetTrim(bool trim);
     
     void SetId(uint32_t id);
     uint32_t GetId();
 
-    void SetOutput(std::string output);
+    /** Draws of the PINT samples, on stream INT_SAMPLE_STREAM_BASE + id */
+    UniformRandomVariable& GetIntSampler();
+    /** ECN marks draw from ECN_STREAM_BASE + id, see PointToPointNetDevice::ACK_PORT_STREAM_BASE */
+    static const int64_t ECN_STREAM_BASE = 3LL << 40;
+    static const int64_t INT_SAMPLE_STREAM_BASE = 4LL << 40;
+
+    /**
+     * Record the buffer of a port into sampler on every decimation-th change
+     * of its occupancy, or never if decimation is 0.
+     */
+    void SetBufferSampler(Ptr<BufferSampler> sampler, uint32_t decimation);
+    /** Record the buffer of every port now and then every interval before stop */
+    void SampleBuffers(Time interval, Time stop);
 
     bool IngressPipeline(Ptr<Packet> packet, uint16_t protocol, Ptr<PointToPointNetDevice> dev);
     Ptr<Packet> EgressPipeline(Ptr<Packet> packet, uint16_t protocol, Ptr<PointToPointNetDevice> dev);
 
+    /**
+     * The segments of a train from first on, as IPv4 packets with the
+     * priority of the train. packet starts with the IPv4 header and cc
+     * selects the header between UDP and BTH.
+     */
+    static std::vector<Ptr<Packet>> GetTrainSegments(Ptr<const Packet> packet, const TrainTag& train,
+                                                     uint32_t cc, uint32_t first);
+    /**
+     * Take the buffer for the segments of a train cut at egressDev, which
+     * arrived on port and now wait in its queue
+     */
+    void AdmitTrainTail(const std::vector<Ptr<Packet>>& tail, Ptr<PointToPointNetDevice> egressDev, uint32_t port);
+
 protected:
-    std::string m_output;
+    void DoDispose() override;
 
     uint32_t m_nid;
     int m_hashSeed;
 
     std::unordered_map<uint32_t, std::vector<uint32_t>> m_route;
+    std::vector<Ptr<PointToPointNetDevice>> m_ports; // By interface index, null if not point-to-point
+
+    Ptr<PointToPointNetDevice> GetEgressDevice(const Ipv4Header& ipv4_header, const UdpHeader& udp_header);
+
+    // Packet trains
+    bool CanForwardTrain(Ptr<Packet> packet, TrainTag& train, Ptr<PointToPointNetDevice> dev);
+    bool SplitTrain(Ptr<Packet> packet, TrainTag& train, uint16_t protocol, Ptr<PointToPointNetDevice> dev);
+    void ReceiveTrainSegment(Ptr<Packet> segment, uint16_t protocol, Ptr<PointToPointNetDevice> dev,
+                             uint64_t train, uint32_t index, uint32_t segments);
 
     // Buffer Management
     uint64_t m_drops = 0;
+    uint64_t m_trims = 0;
 
     static const int32_t RESERVED_SIZE = 10000; // 10KB per port
     static const int32_t RESUME_OFFSET = 10000;
@@ -97,10 +139,31 @@ protected:
     int32_t GetSharedThreshold(Ptr<PointToPointNetDevice> dev);
     int32_t GetUsedShared(Ptr<PointToPointNetDevice> dev);
 
+    bool ShouldDrop(Ptr<Packet> packet, Ptr<PointToPointNetDevice> dev);
+    /** Tag packet with its size and ingress port and count it in the buffer */
+    void AddToBuffer(Ptr<Packet> packet, int32_t size, Ptr<PointToPointNetDevice> dev,
+                     Ptr<PointToPointNetDevice> egressDev);
+
+    // Buffer telemetry
+    Ptr<BufferSampler> m_sampler;
+    uint32_t m_sampleDecimation{0};
+    std::vector<uint32_t> m_bufferChanges; // By interface index
+
+    void RecordBuffer(Ptr<PointToPointNetDevice> dev, BufferSampler::Trigger trigger);
+    void NotifyBufferChange(Ptr<PointToPointNetDevice> dev);
+
+    // Packet trimming
+    bool m_trim{false};
+    static const uint8_t TRIM_PRIORITY = 0;
+
+    Ptr<Packet> TrimPacket(Ptr<Packet> packet);
+
     // ECN setting
     uint64_t m_ecnCount = 0;
     UniformRandomVariable m_uniformVar;
 
+    UniformRandomVariable m_intSampleVar;
+
     std::unordered_map<Ptr<PointToPointNetDevice>, int32_t> m_kmin;
     std::unordered_map<Ptr<PointToPointNetDevice>, int32_t> m_kmax;
 
@@ -110,7 +173,6 @@ protected:
     uint32_t m_cc{0};
     uint32_t m_pfc{0};
     std::unordered_map<Ptr<PointToPointNetDevice>, bool> m_pause;
-    std::unordered_map<Ptr<PointToPointNetDevice>, int64_t> m_prevBuffer;
 
     void SendPFC(Ptr<NetDevice> dev, bool pause);
     bool ShouldPause(Ptr<PointToPointNetDevice> dev);
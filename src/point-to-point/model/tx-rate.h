@@ -0,0 +1,68 @@
+#ifndef TX_RATE_H
+#define TX_RATE_H
+
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+
+namespace ns3
+{
+
+/**
+ * Transmit time of bytes at a fixed rate, in integer Time steps.
+ *
+ * Gives the same result as DataRate::CalculateBytesTxTime, the exact time
+ * rounded to the nearest step, without its int64x64_t division. When a byte
+ * takes a whole number of thousandths of a step (picoseconds at the default
+ * nanosecond resolution), which holds for all the usual link rates, the time
+ * is a multiply and a division by a constant.
+ */
+class TxRate
+{
+public:
+	TxRate() = default;
+	explicit TxRate(DataRate rate){ Set(rate.GetBitRate()); }
+
+	void Set(uint64_t bps){
+		m_bps = bps;
+		m_stepsPerSecond = Seconds(1).GetTimeStep();
+		uint64_t milliSteps = 8000 * m_stepsPerSecond;
+		m_milliStepsPerByte = 0;
+		if(bps > 0 && milliSteps % bps == 0 && milliSteps / bps <= UINT32_MAX)
+			m_milliStepsPerByte = milliSteps / bps;
+	}
+
+	uint64_t GetBitRate() const { return m_bps; }
+
+	int64_t GetTxSteps(uint32_t bytes) const {
+		uint64_t steps, twiceRemainder, divisor;
+		if(m_milliStepsPerByte > 0){
+			uint64_t milliSteps = (uint64_t)bytes * m_milliStepsPerByte;
+			steps = milliSteps / 1000;
+			twiceRemainder = 2 * (milliSteps % 1000);
+			divisor = 1000;
+		}
+		else{
+			unsigned __int128 bits = (unsigned __int128)bytes * 8 * m_stepsPerSecond;
+			steps = bits / m_bps;
+			twiceRemainder = 2 * (uint64_t)(bits % m_bps);
+			divisor = m_bps;
+		}
+		if(twiceRemainder == divisor){
+			// Exact halves round either way in int64x64_t, depending on whether
+			// the quotient is truncated; defer to DataRate to match it
+			return DataRate(m_bps).CalculateBytesTxTime(bytes).GetTimeStep();
+		}
+		return steps + (twiceRemainder > divisor);
+	}
+
+	Time GetTxTime(uint32_t bytes) const { return TimeStep(GetTxSteps(bytes)); }
+
+private:
+	uint64_t m_bps{0};
+	uint64_t m_stepsPerSecond{0};
+	uint64_t m_milliStepsPerByte{0}; /**< 0 if not a whole number */
+};
+
+} // namespace ns3
+
+#endif /* TX_RATE_H */
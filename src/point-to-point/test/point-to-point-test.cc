@@ -6,14 +6,26 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
-#include "ns3/drop-tail-queue.h"
+#include "ns3/bth-header.h"
+#include "ns3/buffer-sampler.h"
+#include "ns3/hpcc-header.h"
+#include "ns3/ipv4-header.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/packet-tag.h"
+#include "ns3/pfc-header.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-queue.h"
+#include "ns3/ppp-header.h"
 #include "ns3/simulator.h"
+#include "ns3/socket.h"
 #include "ns3/test.h"
+#include "ns3/tx-rate.h"
+#include "ns3/udp-header.h"
 
+#include <cstdio>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -94,10 +106,10 @@ PointToPointTest::DoRun()
 
     devA->Attach(channel);
     devA->SetAddress(Mac48Address::Allocate());
-    devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devA->SetQueue(CreateObject<PointToPointQueue>());
     devB->Attach(channel);
     devB->SetAddress(Mac48Address::Allocate());
-    devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devB->SetQueue(CreateObject<PointToPointQueue>());
 
     a->AddDevice(devA);
     b->AddDevice(devB);
@@ -117,6 +129,7 @@ PointToPointTest::DoRun()
 
     Simulator::Run();
 
+    NS_TEST_ASSERT_MSG_NE(m_recvdPacket, nullptr, "No packet received");
     NS_TEST_EXPECT_MSG_EQ(m_recvdPacket->GetSize(), txBufferSize, "trivial");
 
     uint8_t
@@ -128,6 +141,540 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Test that TxRate gives the transmit times of DataRate
+ *
+ * Covers the usual link rates, which take the integer fast path, rates
+ * that do not divide a byte time evenly, and the exact half steps that
+ * int64x64_t rounds either way.
+ */
+class TxRateTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    TxRateTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+};
+
+TxRateTest::TxRateTest()
+    : TestCase("TxRate matches DataRate::CalculateBytesTxTime")
+{
+}
+
+void
+TxRateTest::DoRun()
+{
+    const uint64_t rates[] = {
+        1000000000ULL,
+        10000000000ULL,
+        25000000000ULL,
+        40000000000ULL,
+        56000000000ULL,
+        100000000000ULL,
+        200000000000ULL,
+        400000000000ULL,
+        800000000000ULL,
+        99000000000ULL, // 99% of 100Gbps, as left by fluid flows
+        99999999999ULL,
+        33333333333ULL,
+        1000000007ULL,
+        32768,
+    };
+
+    for (uint64_t bps : rates)
+    {
+        TxRate txRate{DataRate(bps)};
+        DataRate dataRate(bps);
+        // Every packet size, then sizes up to the largest that DataRate handles
+        for (uint32_t bytes = 0; bytes <= 10000; ++bytes)
+        {
+            NS_TEST_ASSERT_MSG_EQ(txRate.GetTxTime(bytes),
+                                  dataRate.CalculateBytesTxTime(bytes),
+                                  "Wrong tx time of " << bytes << " bytes at " << bps << "bps");
+        }
+        for (uint32_t bytes = 10001; bytes < (1U << 29); bytes += 999983)
+        {
+            NS_TEST_ASSERT_MSG_EQ(txRate.GetTxTime(bytes),
+                                  dataRate.CalculateBytesTxTime(bytes),
+                                  "Wrong tx time of " << bytes << " bytes at " << bps << "bps");
+        }
+    }
+}
+
+/**
+ * @brief Test that switches stamp INT in place in the HPCC header
+ *
+ * Stamps two hops behind the PPP, IPv4 and UDP headers of a data packet,
+ * and checks that a copy of the packet keeps its own bytes and that the
+ * ACK echoing the INT is not stamped.
+ */
+class HpccIntStampTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    HpccIntStampTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Add the headers of a packet leaving a switch
+     * @param p the packet
+     * @param hpcc the HPCC header
+     */
+    void AddHeaders(Ptr<Packet> p, const HpccHeader& hpcc);
+
+    /**
+     * @brief Stamp the INT of a hop, as a switch egress does
+     * @param p the packet
+     * @param hop the hop
+     */
+    void Stamp(Ptr<Packet> p, uint32_t hop);
+
+    /**
+     * @brief Remove the headers of a packet
+     * @param p the packet
+     * @returns the HPCC header
+     */
+    HpccHeader RemoveHeaders(Ptr<Packet> p);
+};
+
+HpccIntStampTest::HpccIntStampTest()
+    : TestCase("HPCC INT is stamped in place")
+{
+}
+
+void
+HpccIntStampTest::AddHeaders(Ptr<Packet> p, const HpccHeader& hpcc)
+{
+    p->AddHeader(hpcc);
+    p->AddHeader(UdpHeader());
+    p->AddHeader(Ipv4Header());
+    p->AddHeader(PppHeader());
+}
+
+void
+HpccIntStampTest::Stamp(Ptr<Packet> p, uint32_t hop)
+{
+    Buffer::Iterator start = p->BeginWritable();
+    start.Next(PppHeader().GetSerializedSize() + Ipv4Header().GetSerializedSize() +
+               UdpHeader().GetSerializedSize());
+    HpccHeader::PushIntHeader(start, DataRate("100Gbps"), 4096 * (hop + 1), 640 * hop);
+}
+
+HpccHeader
+HpccIntStampTest::RemoveHeaders(Ptr<Packet> p)
+{
+    PppHeader ppp;
+    Ipv4Header ipv4;
+    UdpHeader udp;
+    HpccHeader hpcc;
+    p->RemoveHeader(ppp);
+    p->RemoveHeader(ipv4);
+    p->RemoveHeader(udp);
+    p->RemoveHeader(hpcc);
+    return hpcc;
+}
+
+void
+HpccIntStampTest::DoRun()
+{
+    Ptr<Packet> p = Create<Packet>(1000);
+    AddHeaders(p, HpccHeader());
+    uint32_t size = p->GetSize();
+    Ptr<Packet> copy = p->Copy();
+
+    Stamp(p, 0);
+    Stamp(p, 1);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), size, "Stamping changed the packet size");
+
+    HpccHeader hpcc = RemoveHeaders(p);
+    NS_TEST_ASSERT_MSG_EQ((uint32_t)hpcc.GetNHops(), 2, "Wrong number of hops");
+    for (uint8_t hop = 0; hop < 2; ++hop)
+    {
+        const IntHeader& intHeader = hpcc.GetIntHeader(hop);
+        NS_TEST_ASSERT_MSG_EQ(intHeader.GetRate(), DataRate("100Gbps"), "Wrong rate");
+        NS_TEST_ASSERT_MSG_EQ(intHeader.GetBytes(), 4096 * (hop + 1), "Wrong bytes");
+        NS_TEST_ASSERT_MSG_EQ(intHeader.GetQueueLen(), 640 * hop, "Wrong queue length");
+    }
+    NS_TEST_ASSERT_MSG_EQ((uint32_t)RemoveHeaders(copy).GetNHops(),
+                          0,
+                          "Stamping changed a copy of the packet");
+
+    hpcc.StopAddIntHeader();
+    Ptr<Packet> ack = Create<Packet>(0);
+    AddHeaders(ack, hpcc);
+    Stamp(ack, 2);
+    hpcc = RemoveHeaders(ack);
+    NS_TEST_ASSERT_MSG_EQ((uint32_t)hpcc.GetNHops(), 2, "The ACK was stamped");
+    NS_TEST_ASSERT_MSG_EQ(hpcc.GetIntHeader(1).GetBytes(), 8192, "Wrong echoed bytes");
+}
+
+/**
+ * @brief Test the INT encodings and PINT sampling
+ *
+ * Checks the header sizes of each encoding, the precision and wrap of the
+ * fields at 800Gbps, that switches past the last slot do not stamp, and that
+ * PINT samples every hop of a path alike.
+ */
+class IntEncodingTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    IntEncodingTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+    /**
+     * @brief Restore the default encoding
+     */
+    void DoTeardown() override;
+
+  private:
+    /**
+     * @brief Stamp every hop of a path on a new packet with one HPCC header
+     * @param hops the switches of the path, hop i stamping i + 1 KB sent
+     * @returns the HPCC header received
+     */
+    HpccHeader SendOverPath(uint8_t hops);
+
+    UniformRandomVariable m_sampler; //!< PINT draws
+};
+
+IntEncodingTest::IntEncodingTest()
+    : TestCase("INT encodings and PINT sampling")
+{
+}
+
+HpccHeader
+IntEncodingTest::SendOverPath(uint8_t hops)
+{
+    Ptr<Packet> p = Create<Packet>(1000);
+    p->AddHeader(HpccHeader());
+    for (uint8_t hop = 0; hop < hops; ++hop)
+    {
+        HpccHeader::PushIntHeader(p->BeginWritable(),
+                                  DataRate("800Gbps"),
+                                  1000 * (hop + 1),
+                                  0,
+                                  &m_sampler);
+    }
+    HpccHeader hpcc;
+    p->RemoveHeader(hpcc);
+    return hpcc;
+}
+
+void
+IntEncodingTest::DoRun()
+{
+    m_sampler.SetStream(1);
+    uint64_t bytes = 1234567;
+    uint64_t queueLen = 5000000;
+
+    IntHeader compact;
+    compact.Set(DataRate("25Gbps"), bytes, queueLen);
+    NS_TEST_ASSERT_MSG_EQ(compact.GetSerializedSize(), 8, "Wrong compact slot size");
+    NS_TEST_ASSERT_MSG_EQ(HpccHeader().GetSerializedSize(), 41, "Wrong compact header size");
+    NS_TEST_ASSERT_MSG_EQ(compact.GetRate().GetBitRate(), 0, "Compact rate below 100Gbps");
+    NS_TEST_ASSERT_MSG_EQ(compact.GetBytes(), bytes / 512 * 512, "Wrong compact bytes");
+    NS_TEST_ASSERT_MSG_EQ(compact.GetQueueLen(),
+                          queueLen / 64 % (1 << 16) * 64,
+                          "The compact queue length did not wrap");
+    IntHeader wrapped;
+    wrapped.SetBytes((1 << 29) + 4096);
+    NS_TEST_ASSERT_MSG_EQ(wrapped.GetBytesDelta(compact),
+                          (1 << 29) + 4096 - bytes / 512 * 512,
+                          "Wrong bytes across the wrap");
+
+    HpccHeader::SetHops(2);
+    NS_TEST_ASSERT_MSG_EQ(HpccHeader().GetSerializedSize(), 17, "Wrong 2-hop header size");
+    HpccHeader truncated = SendOverPath(3);
+    NS_TEST_ASSERT_MSG_EQ((uint32_t)truncated.GetNHops(), 2, "Stamped past the last slot");
+    NS_TEST_ASSERT_MSG_EQ(truncated.GetIntHeader(1).GetBytes(), 1536, "Wrong INT of the last slot");
+    HpccHeader::SetHops(5);
+
+    IntHeader::SetEncoding(IntHeader::WIDE);
+    IntHeader wide;
+    wide.Set(DataRate("25Gbps"), bytes, queueLen);
+    NS_TEST_ASSERT_MSG_EQ(wide.GetSerializedSize(), 16, "Wrong wide slot size");
+    NS_TEST_ASSERT_MSG_EQ(HpccHeader().GetSerializedSize(), 81, "Wrong wide header size");
+    Ptr<Packet> p = Create<Packet>(0);
+    p->AddHeader(wide);
+    p->RemoveHeader(wide);
+    NS_TEST_ASSERT_MSG_EQ(wide.GetRate(), DataRate("25Gbps"), "Wrong wide rate");
+    NS_TEST_ASSERT_MSG_EQ(wide.GetBytes(), bytes, "Wrong wide bytes");
+    NS_TEST_ASSERT_MSG_EQ(wide.GetQueueLen(), queueLen, "Wrong wide queue length");
+
+    HpccHeader hpcc = SendOverPath(3);
+    NS_TEST_ASSERT_MSG_EQ((uint32_t)hpcc.GetNHops(), 3, "Wrong number of hops");
+    NS_TEST_ASSERT_MSG_EQ(hpcc.GetIntHeader(2).GetBytes(), 3000, "Wrong wide INT of the last hop");
+
+    HpccHeader::SetPint(true);
+    NS_TEST_ASSERT_MSG_EQ(HpccHeader().GetSerializedSize(), 18, "Wrong wide PINT header size");
+    IntHeader::SetEncoding(IntHeader::COMPACT);
+    NS_TEST_ASSERT_MSG_EQ(HpccHeader().GetSerializedSize(), 10, "Wrong compact PINT header size");
+
+    uint32_t samples[3] = {0, 0, 0};
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        hpcc = SendOverPath(3);
+        uint8_t hop = hpcc.GetSampledHop();
+        NS_TEST_ASSERT_MSG_EQ((uint32_t)hpcc.GetNHops(), 3, "Wrong number of PINT hops");
+        NS_TEST_ASSERT_MSG_LT((uint32_t)hop, 3, "Sampled hop off the path");
+        NS_TEST_ASSERT_MSG_EQ(hpcc.GetIntHeader(hop).GetBytes(),
+                              (1000 * (hop + 1)) / 512 * 512,
+                              "The sample is not the INT of its hop");
+        samples[hop] += 1;
+    }
+    for (uint32_t hop = 0; hop < 3; ++hop)
+    {
+        NS_TEST_ASSERT_MSG_EQ_TOL(samples[hop],
+                                  1000,
+                                  100,
+                                  "PINT samples are not uniform over the hops");
+    }
+}
+
+void
+IntEncodingTest::DoTeardown()
+{
+    HpccHeader::SetHops(5);
+    IntHeader::SetEncoding(IntHeader::COMPACT);
+    HpccHeader::SetPint(false);
+}
+
+/**
+ * @brief Test the ring of BufferSampler
+ *
+ * Adds more records than the ring holds and checks that the file has all
+ * of them, in order, once the sampler is gone.
+ */
+class BufferSamplerTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    BufferSamplerTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+};
+
+BufferSamplerTest::BufferSamplerTest()
+    : TestCase("BufferSampler writes every record through its ring")
+{
+}
+
+void
+BufferSamplerTest::DoRun()
+{
+    std::string file = CreateTempDirFilename("samples.buffer");
+    Ptr<BufferSampler> sampler = Create<BufferSampler>(file, 4);
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        BufferSampler::Record record{};
+        record.time = 1000 * i;
+        record.port = i;
+        record.egress = 100 * i;
+        sampler->Add(record);
+    }
+    NS_TEST_ASSERT_MSG_EQ(sampler->GetNRecords(), 10, "Wrong number of records");
+    sampler = nullptr;
+
+    FILE* in = fopen(file.c_str(), "rb");
+    NS_TEST_ASSERT_MSG_NE(in, nullptr, "No sample file");
+    BufferSampler::Record records[11];
+    size_t read = fread(records, sizeof(BufferSampler::Record), 11, in);
+    fclose(in);
+    NS_TEST_ASSERT_MSG_EQ(read, 10, "Wrong number of records written");
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(records[i].time, 1000 * i, "Wrong time");
+        NS_TEST_ASSERT_MSG_EQ(records[i].port, i, "Wrong port");
+        NS_TEST_ASSERT_MSG_EQ(records[i].egress, 100 * i, "Wrong egress bytes");
+    }
+}
+
+/**
+ * @brief Test that a PFC pause cuts a packet train
+ *
+ * Pauses the priority of a train of four segments while its second segment
+ * is on the wire. The sender keeps the two segments started, holds the
+ * other two ahead of its queue and sends them one by one on resume.
+ */
+class TrainPauseTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    TrainPauseTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Send a train of segments of the data priority
+     * @param device the sending device
+     * @param segments the number of segments
+     */
+    void SendTrain(Ptr<PointToPointNetDevice> device, uint32_t segments);
+
+    /**
+     * @brief Send a PFC frame for the data priority
+     * @param device the sending device
+     * @param pause pause or resume
+     */
+    void SendPfc(Ptr<PointToPointNetDevice> device, bool pause);
+
+    /**
+     * @brief Record the BTH of a received packet
+     *
+     * @param dev The receiving device.
+     * @param pkt The received packet.
+     * @param mode The protocol mode used.
+     * @param sender The sender address.
+     *
+     * @return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    static const uint32_t SEGMENT_SIZE = 4000; //!< Payload of a segment
+
+    std::vector<uint32_t> m_sizes;     //!< BTH size of each received packet
+    std::vector<uint32_t> m_sequences; //!< BTH sequence of each received packet
+    std::vector<Time> m_times;         //!< Arrival of each received packet
+};
+
+TrainPauseTest::TrainPauseTest()
+    : TestCase("A PFC pause cuts a packet train")
+{
+}
+
+void
+TrainPauseTest::SendTrain(Ptr<PointToPointNetDevice> device, uint32_t segments)
+{
+    Ptr<Packet> p = Create<Packet>(segments * SEGMENT_SIZE);
+    BthHeader bth;
+    bth.SetSize(segments * SEGMENT_SIZE);
+    bth.SetId(1);
+    bth.SetSequence(segments * SEGMENT_SIZE);
+    p->AddHeader(bth);
+    UdpHeader udp;
+    udp.SetDestinationPort(BthHeader::ROCE_UDP_PORT);
+    p->AddHeader(udp);
+    Ipv4Header ipv4;
+    ipv4.SetPayloadSize(segments * SEGMENT_SIZE + 20);
+    p->AddHeader(ipv4);
+
+    SocketPriorityTag priority;
+    priority.SetPriority(RdmaQueuePair::m_dataPriority);
+    p->ReplacePacketTag(priority);
+    uint32_t headerSize = p->GetSize() - segments * SEGMENT_SIZE + 2;
+    p->AddPaddingAtEnd((segments - 1) * headerSize);
+    TrainTag train;
+    train.SetSegments(segments);
+    train.SetSegmentSize(SEGMENT_SIZE);
+    p->ReplacePacketTag(train);
+
+    device->Send(p, device->GetBroadcast(), 0x0800);
+}
+
+void
+TrainPauseTest::SendPfc(Ptr<PointToPointNetDevice> device, bool pause)
+{
+    Ptr<Packet> p = Create<Packet>();
+    PfcHeader pfc;
+    pfc.SetTime(pause);
+    pfc.SetQueueIndex(RdmaQueuePair::m_dataPriority);
+    p->AddHeader(pfc);
+    device->Send(p, device->GetBroadcast(), 0x8808);
+}
+
+bool
+TrainPauseTest::RxPacket(Ptr<NetDevice> dev,
+                         Ptr<const Packet> pkt,
+                         uint16_t mode,
+                         const Address& sender)
+{
+    Ptr<Packet> p = pkt->Copy();
+    Ipv4Header ipv4;
+    UdpHeader udp;
+    BthHeader bth;
+    p->RemoveHeader(ipv4);
+    p->RemoveHeader(udp);
+    p->RemoveHeader(bth);
+    m_sizes.push_back(bth.GetSize());
+    m_sequences.push_back(bth.GetSequence());
+    m_times.push_back(Simulator::Now());
+    return true;
+}
+
+void
+TrainPauseTest::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    channel->SetAttribute("Delay", TimeValue(NanoSeconds(10)));
+
+    for (auto dev : {devA, devB})
+    {
+        dev->Attach(channel);
+        dev->SetAddress(Mac48Address::Allocate());
+        dev->SetQueue(CreateObject<PointToPointQueue>());
+        dev->SetDataRate(DataRate("100Gbps"));
+    }
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+    devB->SetReceiveCallback(MakeCallback(&TrainPauseTest::RxPacket, this));
+
+    // Segments of about 4KB take 324ns, the pause arrives during the second one
+    Simulator::Schedule(Seconds(1), &TrainPauseTest::SendTrain, this, devA, 4);
+    Simulator::Schedule(Seconds(1) + NanoSeconds(400), &TrainPauseTest::SendPfc, this, devB, true);
+    Simulator::Schedule(Seconds(1) + MicroSeconds(10), &TrainPauseTest::SendPfc, this, devB, false);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(devA->GetSentSegments(1), 2, "The train was not cut after two segments");
+    NS_TEST_ASSERT_MSG_EQ(m_sizes.size(), 3, "Wrong number of packets received");
+    // A plain device gets the train whole, a switch only takes the segments sent
+    NS_TEST_ASSERT_MSG_EQ(m_sizes[0], 4 * SEGMENT_SIZE, "Wrong train size");
+    for (uint32_t i = 1; i < 3; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_sizes[i], SEGMENT_SIZE, "Wrong size of a held segment");
+        NS_TEST_ASSERT_MSG_EQ(m_sequences[i], (i + 2) * SEGMENT_SIZE, "Wrong held segment");
+        NS_TEST_ASSERT_MSG_GT(m_times[i],
+                              Seconds(1) + MicroSeconds(10),
+                              "A held segment left before the resume");
+    }
+
+    Simulator::Destroy();
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +691,11 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new TxRateTest, TestCase::Duration::QUICK);
+    AddTestCase(new HpccIntStampTest, TestCase::Duration::QUICK);
+    AddTestCase(new IntEncodingTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferSamplerTest, TestCase::Duration::QUICK);
+    AddTestCase(new TrainPauseTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -9,6 +9,7 @@
 
 #include "topology-reader-helper.h"
 
+#include "ns3/fabric-topology-reader.h"
 #include "ns3/inet-topology-reader.h"
 #include "ns3/log.h"
 #include "ns3/object.h"
@@ -66,6 +67,11 @@ TopologyReaderHelper::GetTopologyReader()
             NS_LOG_INFO("Creating Rocketfuel formatted data input.");
             m_inputModel = CreateObject<RocketfuelTopologyReader>();
         }
+        else if (m_fileType == "Fabric")
+        {
+            NS_LOG_INFO("Creating Fabric formatted data input.");
+            m_inputModel = CreateObject<FabricTopologyReader>();
+        }
         else
         {
             NS_ASSERT_MSG(false, "Wrong (unknown) File Type");
@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "fabric-topology-reader.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/object-factory.h"
+#include "ns3/string.h"
+
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::FabricTopologyReader implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FabricTopologyReader");
+
+NS_OBJECT_ENSURE_REGISTERED(FabricTopologyReader);
+
+TypeId
+FabricTopologyReader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::FabricTopologyReader")
+                            .SetParent<TopologyReader>()
+                            .SetGroupName("TopologyReader")
+                            .AddConstructor<FabricTopologyReader>()
+                            .AddAttribute("SwitchType",
+                                          "The TypeId of the switch nodes.",
+                                          StringValue("ns3::SwitchNode"),
+                                          MakeStringAccessor(&FabricTopologyReader::m_switchType),
+                                          MakeStringChecker());
+    return tid;
+}
+
+FabricTopologyReader::FabricTopologyReader()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FabricTopologyReader::~FabricTopologyReader()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+NodeContainer
+FabricTopologyReader::Read()
+{
+    std::ifstream topgen;
+    topgen.open(GetFileName());
+    NodeContainer nodes;
+
+    if (!topgen.is_open())
+    {
+        NS_LOG_WARN("Fabric topology file object is not open, check file name and permissions");
+        return nodes;
+    }
+
+    ObjectFactory switchFactory;
+    switchFactory.SetTypeId(m_switchType);
+
+    std::unordered_map<std::string, Ptr<Node>> nodeMap;
+    std::istringstream lineBuffer;
+    std::string line;
+    std::string keyword;
+    uint32_t lineNumber = 0;
+
+    while (getline(topgen, line))
+    {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        lineBuffer.clear();
+        lineBuffer.str(line);
+        keyword.clear();
+        lineBuffer >> keyword;
+
+        if (keyword.empty())
+        {
+            continue;
+        }
+        else if (keyword == "host" || keyword == "switch")
+        {
+            std::string name;
+            uint32_t level = 0;
+            lineBuffer >> name;
+            if (keyword == "switch")
+            {
+                lineBuffer >> level;
+            }
+            NS_ABORT_MSG_IF(name.empty() || lineBuffer.fail(),
+                            "Malformed node at line " << lineNumber << ": " << line);
+            NS_ABORT_MSG_IF(nodeMap.count(name), "Duplicate node " << name);
+
+            Ptr<Node> node;
+            if (keyword == "host")
+            {
+                node = CreateObject<Node>();
+                m_hosts.Add(node);
+            }
+            else
+            {
+                node = switchFactory.Create<Node>();
+                m_switches.Add(node);
+                m_levels.push_back(level);
+            }
+            nodeMap[name] = node;
+            nodes.Add(node);
+        }
+        else if (keyword == "link")
+        {
+            std::string from;
+            std::string to;
+            std::string rate;
+            std::string delay;
+            lineBuffer >> from >> to >> rate >> delay;
+            NS_ABORT_MSG_IF(lineBuffer.fail(),
+                            "Malformed link at line " << lineNumber << ": " << line);
+
+            auto fromIt = nodeMap.find(from);
+            auto toIt = nodeMap.find(to);
+            NS_ABORT_MSG_IF(fromIt == nodeMap.end() || toIt == nodeMap.end(),
+                            "Link at line " << lineNumber << " uses an undeclared node");
+
+            Link link(fromIt->second, from, toIt->second, to);
+            link.SetAttribute("DataRate", rate);
+            link.SetAttribute("Delay", delay);
+            AddLink(link);
+        }
+        else
+        {
+            NS_ABORT_MSG("Unknown keyword at line " << lineNumber << ": " << keyword);
+        }
+    }
+
+    NS_LOG_INFO("Fabric topology created with " << m_hosts.GetN() << " hosts, "
+                                                << m_switches.GetN() << " switches and "
+                                                << LinksSize() << " links");
+    topgen.close();
+
+    return nodes;
+}
+
+NodeContainer
+FabricTopologyReader::GetHosts() const
+{
+    return m_hosts;
+}
+
+NodeContainer
+FabricTopologyReader::GetSwitches() const
+{
+    return m_switches;
+}
+
+uint32_t
+FabricTopologyReader::GetSwitchLevel(uint32_t index) const
+{
+    return m_levels.at(index);
+}
+
+} /* namespace ns3 */
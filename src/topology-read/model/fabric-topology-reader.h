@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FABRIC_TOPOLOGY_READER_H
+#define FABRIC_TOPOLOGY_READER_H
+
+#include "topology-reader.h"
+
+#include "ns3/node-container.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::FabricTopologyReader declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup topology
+ *
+ * @brief Topology file reader (datacenter fabric format).
+ *
+ * This class reads a declarative description of a datacenter fabric.
+ * Every non-empty line that does not start with '#' is one of:
+ *
+ * @verbatim
+   host   <name>
+   switch <name> <level>
+   link   <from> <to> <rate> <delay>
+   @endverbatim
+ *
+ * Hosts are numbered in the order they are declared, which is the host id
+ * used by flow traces. Switches are created from the SwitchType attribute
+ * and carry their tier (1 for ToR, 2 for aggregation, ...). Every link gets the "DataRate" and "Delay" attributes,
+ * e.g. "100Gbps" and "1us". Nodes must be declared before their links.
+ */
+class FabricTopologyReader : public TopologyReader
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    FabricTopologyReader();
+    ~FabricTopologyReader() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    FabricTopologyReader(const FabricTopologyReader&) = delete;
+    FabricTopologyReader& operator=(const FabricTopologyReader&) = delete;
+
+    /**
+     * @brief Main topology reading function.
+     *
+     * Creates the hosts and the switches and records the links; the links
+     * are not installed, so that the caller can choose the devices.
+     *
+     * @return The container of the nodes created (or empty container if there was an error)
+     */
+    NodeContainer Read() override;
+
+    /**
+     * @brief Get the hosts, in declaration order.
+     * @return The hosts read from the file.
+     */
+    NodeContainer GetHosts() const;
+
+    /**
+     * @brief Get the switches, in declaration order.
+     * @return The switches read from the file.
+     */
+    NodeContainer GetSwitches() const;
+
+    /**
+     * @brief Get the tier of a switch.
+     * @param [in] index The index of the switch in GetSwitches().
+     * @return The level declared for the switch.
+     */
+    uint32_t GetSwitchLevel(uint32_t index) const;
+
+  private:
+    std::string m_switchType;       //!< TypeId of the switch nodes.
+    NodeContainer m_hosts;          //!< Hosts, in declaration order.
+    NodeContainer m_switches;       //!< Switches, in declaration order.
+    std::vector<uint32_t> m_levels; //!< Level of each switch.
+
+    // end class FabricTopologyReader
+};
+
+// end namespace ns3
+}; // namespace ns3
+
+#endif /* FABRIC_TOPOLOGY_READER_H */